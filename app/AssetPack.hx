@@ -20,6 +20,11 @@ import haxe.io.Path;
 		For example: a directory can be copied with `@:copyToBundle('../game-assets')` and files in that directory read from the bundle with
 		`Assets.readBundleFile('game-assets/theme.mp3', (bytes) -> {...})`.
 
+	- `@:packAtlas(directory: String, ?pageSize: Int, ?padding: Int)`
+		Packs the PNG and JPEG images in a directory into texture atlas pages at compile-time, the layout is available as `atlases.<directory name>`.
+		Pass it to `image.TextureAtlas.fromLayout()` with the decoded images in the order of its `regions`. The directory must also be copied with `@:copyToBundle`;
+		region paths match the pack's `paths`. `pageSize` defaults to 2048 and `padding` to 2
+
 	**Paths in metadata are evaluated relative to the extending class file path**
 	
 	For example:
@@ -65,6 +70,7 @@ class AssetPackMacro {
 
 			static public final embedded = ${handleEmbedMeta(localClass.meta, classDir)};
 			static public final paths = ${handleCopyToBundleMeta('asset-pack/$classAssetDirectory', localClass.meta, classDir)};
+			static public final atlases = ${handlePackAtlasMeta(localClass.meta, classDir)};
 
 			static public inline function readFile(
 				path: String,
@@ -232,6 +238,115 @@ class AssetPackMacro {
 		}
 	}
 
+	static function handlePackAtlasMeta(metaList: MetaAccess, classDir: String) {
+		var objectFields = new Array<ObjectField>();
+
+		for (meta in metaList.extract(':packAtlas')) {
+			switch meta.params[0] {
+				case {expr: EConst(CString(path))}:
+					var pageSize = meta.params[1] != null ? getIntParam(meta.params[1], '@:packAtlas pageSize') : 2048;
+					var padding = meta.params[2] != null ? getIntParam(meta.params[2], '@:packAtlas padding') : 2;
+
+					// paths are relative to the local class file
+					var pathAbsolute = sys.FileSystem.absolutePath(Path.join([classDir, path]));
+					if (!sys.FileSystem.exists(pathAbsolute) || !sys.FileSystem.isDirectory(pathAbsolute)) {
+						Context.error('@:packAtlas directory "$path" does not exist', meta.pos);
+					}
+
+					// paths within the bundle, matching handleCopyToBundleMeta
+					var bundlePaths = new Array<String>();
+					var sizes = new Array<{ width: Int, height: Int }>();
+
+					function addDirectory(sourcePath: String, bundlePath: String) {
+						var names = sys.FileSystem.readDirectory(sourcePath);
+						names.sort(Reflect.compare);
+						for (name in names) {
+							var filePath = Path.join([sourcePath, name]);
+							if (sys.FileSystem.isDirectory(filePath)) {
+								addDirectory(filePath, Path.join([bundlePath, name]));
+							} else if (!isIgnoredFilename(name)) {
+								var size = readImageSize(filePath);
+								if (size != null) {
+									bundlePaths.push(Path.join([bundlePath, name]));
+									sizes.push(size);
+								}
+							}
+						}
+					}
+
+					addDirectory(pathAbsolute, Path.withoutDirectory(path));
+
+					var rects = try image.AtlasPacker.pack(sizes, pageSize, pageSize, padding) catch (e: Any) {
+						Context.fatalError('@:packAtlas failed for "$path": $e', meta.pos);
+					}
+
+					var layout = {
+						pageWidth: pageSize,
+						pageHeight: pageSize,
+						regions: [for (i in 0...rects.length) {
+							path: bundlePaths[i],
+							page: rects[i].page,
+							x: rects[i].x,
+							y: rects[i].y,
+							width: rects[i].width,
+							height: rects[i].height,
+						}],
+					};
+
+					objectFields.push({
+						field: safeVariableName(Path.withoutDirectory(path)),
+						expr: macro ($v{layout}: image.TextureAtlas.AtlasLayout),
+					});
+
+				case null, _:
+					Context.error('@:packAtlas(directory, ?pageSize, ?padding) requires a directory path string as the first argument', meta.pos);
+			}
+		}
+
+		return {
+			pos: Context.currentPos(),
+			expr: EObjectDecl(objectFields)
+		}
+	}
+
+	static function getIntParam(expr: Expr, name: String): Int {
+		return switch expr.expr {
+			case EConst(CInt(v)): Std.parseInt(v);
+			default: Context.fatalError('$name must be an integer', expr.pos);
+		}
+	}
+
+	/**
+		Reads the pixel dimensions from a PNG or JPEG header, returns null for other files
+	**/
+	static function readImageSize(path: String): Null<{ width: Int, height: Int }> {
+		var bytes = try sys.io.File.getBytes(path) catch (e: Any) return null;
+
+		inline function uint16(i: Int) return (bytes.get(i) << 8) | bytes.get(i + 1);
+		inline function int32(i: Int) return (bytes.get(i) << 24) | (bytes.get(i + 1) << 16) | (bytes.get(i + 2) << 8) | bytes.get(i + 3);
+
+		// PNG: signature followed by the IHDR chunk
+		if (bytes.length >= 24 && bytes.get(0) == 0x89 && bytes.get(1) == 'P'.code && bytes.get(2) == 'N'.code && bytes.get(3) == 'G'.code) {
+			return { width: int32(16), height: int32(20) };
+		}
+
+		// JPEG: walk the marker segments to the first start-of-frame
+		if (bytes.length >= 4 && bytes.get(0) == 0xFF && bytes.get(1) == 0xD8) {
+			var i = 2;
+			while (i + 9 < bytes.length) {
+				if (bytes.get(i) != 0xFF) return null;
+				var marker = bytes.get(i + 1);
+				var isStartOfFrame = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+				if (isStartOfFrame) {
+					return { width: uint16(i + 7), height: uint16(i + 5) };
+				}
+				i += 2 + uint16(i + 2);
+			}
+		}
+
+		return null;
+	}
+
 	static function isIgnoredFilename(filename: String) {
 		return switch filename {
 			// macOS
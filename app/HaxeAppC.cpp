@@ -24,16 +24,20 @@
 #include <app/event/WheelEvent.h>
 #include <app/event/KeyboardEvent.h>
 #include <webgl/native/GLContext.h>
+#include <webgl/TextureUploadQueue.h>
 
 using namespace app;
 
 struct AppHandle {
     hx::Ref<app::HaxeAppInterface*> haxeRef;
+    // context passed to onGraphicsContextReady, until onGraphicsContextLost
+    hx::Ref<webgl::native::GLContext_obj*> glRef;
     AppHandle(hx::Native<app::HaxeAppInterface*> app) {
         haxeRef = app;
     }
     ~AppHandle() {
         haxeRef = 0;
+        glRef = 0;
     }
 };
 
@@ -117,8 +121,8 @@ void HaxeApp_onGraphicsContextReady(
     AppHandle* appHandle = (AppHandle*) ptr;
     HX_JUST_GC_STACKFRAME
     // create an gl context wrapper (the real context must already be created)
-    webgl::native::GLContext gl = webgl::native::GLContext_obj::__alloc(
-        HX_CTX,
+    // this is a GL2Context if the context supports OpenGL ES 3.0
+    webgl::native::GLContext gl = webgl::native::GLContext_obj::create(
         contextRef,
         alpha,
         depth,
@@ -128,6 +132,7 @@ void HaxeApp_onGraphicsContextReady(
         getDrawingBufferWidth,
         getDrawingBufferHeight
     );
+    appHandle->glRef = gl.mPtr;
     appHandle->haxeRef->onGraphicsContextReady(gl);
     postHaxeExecution();
 }
@@ -136,12 +141,26 @@ void HaxeApp_onGraphicsContextLost(void* ptr) {
     hx::NativeAttach haxeGcScope;
     AppHandle* appHandle = (AppHandle*) ptr;
     appHandle->haxeRef->onGraphicsContextLost();
+    // drop objects pending deletion so the lost context isn't made current again
+    if (appHandle->glRef.get() != 0) {
+        appHandle->glRef->onNativeContextLost();
+        appHandle->glRef = 0;
+    }
     postHaxeExecution();
 }
 
+void HaxeApp_setCurrentGraphicsContext(void* contextRef) {
+    hx::NativeAttach haxeGcScope;
+    webgl::native::GLContext_obj::setKnownCurrentReference(contextRef);
+}
+
 void HaxeApp_onDrawFrame(void* ptr, int32_t drawingBufferWidth, int32_t drawingBufferHeight) {
     hx::NativeAttach haxeGcScope;
     AppHandle* appHandle = (AppHandle*) ptr;
+    // delete gl objects released by the garbage collector since the last frame
+    webgl::native::GLContext_obj::deletePendingObjectsOfAllContexts();
+    // send queued texture uploads within their per-frame budgets
+    webgl::TextureUploadQueue_obj::processAll();
     appHandle->haxeRef->onDrawFrame(drawingBufferWidth, drawingBufferHeight);
     postHaxeExecution();
 }
@@ -251,9 +270,9 @@ void HaxeApp_onDeactivate(void* ptr) {
  * Should be called after executing haxe code and before returning to external code
  */
 void postHaxeExecution() {
-    // it's possible the active graphics context will be changed by external code
-    // by setting this variable to null, haxe will make sure the right graphics context is activated before executing any graphics calls in the future
-    webgl::native::GLContext_obj::knownCurrentReference = nullptr;
+    // it's possible the active graphics context and its state will be changed by external code
+    // this makes sure the right graphics context is activated (and any cached GL state is refreshed) before executing any graphics calls in the future
+    webgl::native::GLContext_obj::postHaxeExecution();
 
     // after executing haxe code we need to check if new events have been scheduled (and to wake the event loop if so)
     // in the future we should redefine MainLoop to wake the loop automatically
@@ -50,6 +50,11 @@ extern "C" {
         GetContextParamInt32 getDrawingBufferHeight
     );
     void  HaxeApp_onGraphicsContextLost(void* ptr);
+    /**
+     * Call before a callback into haxe when `contextRef` (as passed to onGraphicsContextReady) is already the current graphics context on this thread,
+     * haxe then skips its own setGraphicsContext() call. Pass NULL if the current context is unknown
+     */
+    void  HaxeApp_setCurrentGraphicsContext(void* contextRef);
     void  HaxeApp_onDrawFrame(void* ptr, int32_t drawingBufferWidth, int32_t drawingBufferHeight);
 
     /**
@@ -21,6 +21,9 @@ JAVA_METHOD(jlong, create) (JNIEnv * env, jobject obj,  jint width, jint height)
 }
 
 JAVA_METHOD(void, drawFrame) (JNIEnv * env, jobject obj, jlong ptr) {
+    // GLSurfaceView has already made the view's context current, so tell haxe rather than have it call make-current again
+    // (assumes the EGLContext was passed as contextRef to HaxeApp_onGraphicsContextReady)
+    HaxeApp_setCurrentGraphicsContext(eglGetCurrentContext());
     minimalGLDrawFrame((void*) ptr);
 }
 
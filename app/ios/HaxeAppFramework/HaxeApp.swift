@@ -102,6 +102,10 @@ public class HaxeApp {
     }
 
     public func onDrawFrame(_ drawingBufferWidth: Int32, _ drawingBufferHeight: Int32) {
+        // GLKView makes its context current before drawing
+        if let view = glkView {
+            HaxeApp_setCurrentGraphicsContext(Unmanaged.passUnretained(view).toOpaque())
+        }
         HaxeApp_onDrawFrame(ptr, drawingBufferWidth, drawingBufferHeight)
     }
     
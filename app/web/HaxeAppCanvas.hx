@@ -75,7 +75,13 @@ class HaxeAppCanvas {
 		addLifeCycleEventListeners();
 		addResizeEventListeners();
 
+		#if webgl2
+		// WebGL2 when available, see webgl.GL2Context.fromContext()
+		var gl2: Null<RenderingContext> = cast canvas.getContext('webgl2', webglContextAttributes);
+		gl = gl2 != null ? gl2 : canvas.getContext('webgl', webglContextAttributes);
+		#else
 		gl = canvas.getContext('webgl', webglContextAttributes);
+		#end
 		appInstance.onGraphicsContextReady(gl);
 
 		// startup resize event
@@ -343,6 +349,8 @@ class HaxeAppCanvas {
 	}
 
 	function frameLoop(t_ms: Float) {
+		// send queued texture uploads within their per-frame budgets
+		webgl.TextureUploadQueue.processAll();
 		// tell app to draw a frame 
 		appInstance.onDrawFrame(gl.drawingBufferWidth, gl.drawingBufferHeight);
 		requestAnimationFrameHandle = window.requestAnimationFrame(frameLoop);
@@ -6,6 +6,7 @@ typedef AudioBuffer = js.html.audio.AudioBuffer;
 
 #else
 import cpp.*;
+import audio.native.AudioDecoder;
 import audio.native.MiniAudio;
 
 /**
@@ -20,6 +21,11 @@ class AudioBuffer {
 	final interleavedPcmBytes: haxe.io.Bytes;
 	final config: DecoderConfig;
 
+	// interleavedPcmBytes converted to a context's output format, this is created on demand for buffers that don't already match
+	var convertedPcmBytes: Null<haxe.io.Bytes>;
+	var convertedChannels: UInt32 = 0;
+	var convertedSampleRate: UInt32 = 0;
+
 	function new(interleavedPcmBytes: haxe.io.Bytes, interleavedPcmBytesConfig: {
 		final channels: UInt32;
 		final sampleRate: UInt32;
@@ -32,6 +38,43 @@ class AudioBuffer {
 		);
 	}
 
+	/**
+		Returns interleaved F32 frames in the context's output channel count and sample rate so they can be read directly on the audio thread.
+		If the buffer is already in this format the original bytes are returned, otherwise the conversion is performed once and cached
+		@throws String
+	**/
+	function getInterleavedPcmBytesForContext(context: AudioContext): haxe.io.Bytes {
+		var channels = context.maDevice.playback.channels;
+		var sampleRate = context.maDevice.sampleRate;
+
+		if (config.channels == channels && config.sampleRate == sampleRate) {
+			return interleavedPcmBytes;
+		}
+
+		if (convertedPcmBytes != null && convertedChannels == channels && convertedSampleRate == sampleRate) {
+			return convertedPcmBytes;
+		}
+
+		var decoder = new PcmBufferDecoder(context, interleavedPcmBytes, {
+			channels: config.channels,
+			sampleRate: config.sampleRate
+		}, false);
+
+		// the decoder reports length in the input sample rate
+		var frameCount: UInt64 = Math.ceil(decoder.getLengthInPcmFrames() * (sampleRate / config.sampleRate));
+		var bytes = haxe.io.Bytes.alloc(cast decoder.bytesPerFrame() * frameCount);
+		var bytesAddress: Star<cpp.Void> = cast cpp.NativeArray.address(bytes.getData(), 0).raw;
+		var framesRead = decoder.nativeAudioDecoder.readPcmFrames(bytesAddress, frameCount);
+		if (framesRead < frameCount) {
+			bytes = bytes.sub(0, cast decoder.bytesPerFrame() * framesRead);
+		}
+
+		convertedPcmBytes = bytes;
+		convertedChannels = channels;
+		convertedSampleRate = sampleRate;
+		return bytes;
+	}
+
 }
 
 #end
\ No newline at end of file
@@ -6,6 +6,7 @@ typedef AudioBufferSourceNode = js.html.audio.AudioBufferSourceNode;
 
 #else
 
+import cpp.*;
 import audio.native.AudioDecoder;
 
 @:allow(audio.AudioContext)
@@ -19,20 +20,43 @@ class AudioBufferSourceNode extends AudioScheduledSourceNode {
 
 	public var loop (get, set): Bool;
 
+	/**
+		Time in seconds where looping restarts, only used when `loop` is true
+	**/
+	public var loopStart (get, set): Float;
+
+	/**
+		Time in seconds where looping ends (exclusive), 0 for the end of the buffer
+	**/
+	public var loopEnd (get, set): Float;
+
+	/**
+		Non-standard: duration in seconds at the end of the loop region that is linearly crossfaded with the start of the loop region, 0 for a hard loop
+	**/
+	public var loopCrossfade (get, set): Float;
+
 	public var buffer (get, set): AudioBuffer;
 	var _buffer: AudioBuffer;
 
+	// frames read by the audio thread, retained so they're not collected while in use
+	var pcmBytes: Null<haxe.io.Bytes>;
+
 	inline function get_buffer(): AudioBuffer {
 		return this._buffer;
 	}
 
-	inline function set_buffer(b: AudioBuffer): AudioBuffer {
-		// create a decoder for this buffer
-		var bytesDecoder = new PcmBufferDecoder(context, b.interleavedPcmBytes, {
-			channels: b.config.channels,
-			sampleRate: b.config.sampleRate
-		});
-		setDecoder(bytesDecoder);
+	function set_buffer(b: AudioBuffer): AudioBuffer {
+		// rather than a decoder, the audio thread reads frames directly from the buffer so looping never requires a seek
+		var bytes = b != null ? b.getInterleavedPcmBytesForContext(context) : null;
+		if (bytes != null) {
+			var channels = context.maDevice.playback.channels;
+			var frameCount: UInt64 = cast Std.int(bytes.length / (4 * channels));
+			var framesAddress: ConstStar<Float32> = cast cpp.NativeArray.address(bytes.getData(), 0).raw;
+			nativeNode.setPcmFrames(framesAddress, frameCount, channels);
+		} else {
+			nativeNode.setPcmFrames(null, 0, 0);
+		}
+		pcmBytes = bytes;
 		return _buffer = b;
 	}
 
@@ -44,6 +68,37 @@ class AudioBufferSourceNode extends AudioScheduledSourceNode {
 		return this.nativeNode.setLoop(v);
 	}
 
+	inline function get_loopStart(): Float {
+		return this.nativeNode.getLoopStartFrame() / context.sampleRate;
+	}
+
+	inline function set_loopStart(v: Float): Float {
+		this.nativeNode.setLoopStartFrame(secondsToFrames(v));
+		return v;
+	}
+
+	inline function get_loopEnd(): Float {
+		return this.nativeNode.getLoopEndFrame() / context.sampleRate;
+	}
+
+	inline function set_loopEnd(v: Float): Float {
+		this.nativeNode.setLoopEndFrame(secondsToFrames(v));
+		return v;
+	}
+
+	inline function get_loopCrossfade(): Float {
+		return this.nativeNode.getLoopCrossfadeFrames() / context.sampleRate;
+	}
+
+	inline function set_loopCrossfade(v: Float): Float {
+		this.nativeNode.setLoopCrossfadeFrames(cast secondsToFrames(v));
+		return v;
+	}
+
+	inline function secondsToFrames(t: Float): UInt64 {
+		return t > 0 ? cast Math.round(t * context.sampleRate) : 0;
+	}
+
 }
 
 #end
\ No newline at end of file
@@ -32,6 +32,8 @@ import audio.native.LockedValue;
 @:include('./native.h')
 @:sourceFile(#if winrt './native.c' #else './native.m' #end)
 @:allow(audio.AudioNode)
+@:allow(audio.AudioBuffer)
+@:allow(audio.AudioBufferSourceNode)
 @:allow(audio.native.AudioDecoder)
 class AudioContext {
 
@@ -40,18 +42,44 @@ class AudioContext {
     public var sampleRate (get, null): Float;
     public var state (get, null): AudioContextState;
 
+    /**
+        Number of frames processed by the audio graph in a single render quantum
+    **/
+    public var renderQuantumSize (get, null): Int;
+
+    /**
+        Seconds of processing latency incurred passing audio from the `AudioDestinationNode` to the audio subsystem; this is the duration of one device period
+    **/
+    public var baseLatency (get, null): Float;
+
+    /**
+        Estimated seconds of latency between the audio graph and the output device; this is the duration of the full device buffer (all periods)
+    **/
+    public var outputLatency (get, null): Float;
+
     final maDevice: Star<Device>;
     final userData: DeviceUserData;
     var _state: AudioContextState = SUSPENDED;
 
+    /**
+        @throws String
+    **/
     public function new(?contextOptions: {
         ?sampleRate: Int,
-        ?latencyHint: LatencyHint, // default "interactive"
+        ?latencyHint: haxe.extern.EitherType<LatencyHint, Float>, // default "interactive", a Float is interpreted as the requested output latency in seconds
+        ?renderQuantumSize: Int, // default 128
+        ?periodSizeInFrames: Int, // takes priority over latencyHint when set
+        ?periods: Int,
     }) {
         if (contextOptions == null) {
             contextOptions = {};
         }
 
+        var renderQuantumSize: Int = contextOptions.renderQuantumSize != null ? contextOptions.renderQuantumSize : DEFAULT_RENDER_QUANTUM_SIZE;
+        if (renderQuantumSize <= 0) {
+            throw 'renderQuantumSize must be greater than 0, got $renderQuantumSize';
+        }
+
         // @! explore if it's better to manually create the context here (currently it's created by miniaudio when the device is initialized)
 
         maDevice = Device.alloc();
@@ -59,11 +87,44 @@ class AudioContext {
         var deviceConfig = DeviceConfig.init(PLAYBACK);
         deviceConfig.sampleRate = contextOptions.sampleRate != null ? contextOptions.sampleRate : 0;
         deviceConfig.playback.format = F32;
-        deviceConfig.performanceProfile = switch contextOptions.latencyHint {
-            case null, INTERACTIVE: LOW_LATENCY;
-            case PLAYBACK, BALANCED: CONSERVATIVE; 
-            
-        };
+
+        var latencyHint: Dynamic = contextOptions.latencyHint;
+        if (Std.is(latencyHint, Float)) {
+            // explicit latency in seconds; miniaudio treats the buffer size as a hint and the achieved value is reported by outputLatency
+            var latency_s: Float = latencyHint;
+            if (latency_s < 0) {
+                throw 'latencyHint must be non-negative, got $latency_s';
+            }
+            deviceConfig.performanceProfile = latency_s <= LOW_LATENCY_THRESHOLD_S ? LOW_LATENCY : CONSERVATIVE;
+            if (deviceConfig.sampleRate != 0) {
+                deviceConfig.bufferSizeInFrames = Math.ceil(latency_s * deviceConfig.sampleRate);
+            } else {
+                deviceConfig.bufferSizeInMilliseconds = Math.ceil(latency_s * 1000);
+            }
+        } else {
+            deviceConfig.performanceProfile = switch (latencyHint: LatencyHint) {
+                case null, INTERACTIVE: LOW_LATENCY;
+                case PLAYBACK, BALANCED: CONSERVATIVE;
+                default: throw 'Unknown latencyHint "$latencyHint"';
+            };
+        }
+
+        if (contextOptions.periods != null) {
+            if (contextOptions.periods <= 0) {
+                throw 'periods must be greater than 0, got ${contextOptions.periods}';
+            }
+            deviceConfig.periods = contextOptions.periods;
+        }
+
+        if (contextOptions.periodSizeInFrames != null) {
+            if (contextOptions.periodSizeInFrames <= 0) {
+                throw 'periodSizeInFrames must be greater than 0, got ${contextOptions.periodSizeInFrames}';
+            }
+            var periods = contextOptions.periods != null ? contextOptions.periods : DEFAULT_PERIODS;
+            deviceConfig.periods = periods;
+            deviceConfig.bufferSizeInFrames = contextOptions.periodSizeInFrames * periods;
+        }
+
         deviceConfig.dataCallback = Function.fromStaticFunction(audioThread_deviceDataCallbackMixSources);
 
         // initialize device
@@ -74,7 +135,7 @@ class AudioContext {
 
         destination = new AudioDestinationNode(this);
 
-        userData = new DeviceUserData(this, Pointer.fromStar(destination.nativeNodeList));
+        userData = new DeviceUserData(this, Pointer.fromStar(destination.nativeNodeList), renderQuantumSize);
 
         maDevice.pUserData = cast Native.addressOf(userData);
 
@@ -145,6 +206,21 @@ class AudioContext {
                 // decode file into raw pcm frame bytes
                 var tmpDecoder = new FileBytesDecoder(this, copiedBytes, false);
                 var bytes = tmpDecoder.getInterleavedPcmFrames(0);
+
+                // remove MP3 encoder delay and padding so buffers loop gaplessly
+                var leadingFrames: UInt32 = 0;
+                var trailingFrames: UInt32 = 0;
+                var fileBytesAddress: ConstStar<cpp.Void> = cast cpp.NativeArray.address(copiedBytes.getData(), 0).raw;
+                if (getMp3GaplessTrim(fileBytesAddress, copiedBytes.length, Native.addressOf(leadingFrames), Native.addressOf(trailingFrames))) {
+                    var rateScale = tmpDecoder.sampleRate / tmpDecoder.nativeAudioDecoder.maDecoder.internalSampleRate;
+                    var bytesPerFrame = tmpDecoder.bytesPerFrame();
+                    var start = Math.round(leadingFrames * rateScale) * bytesPerFrame;
+                    var end = bytes.length - Math.round(trailingFrames * rateScale) * bytesPerFrame;
+                    if (end > start) {
+                        bytes = bytes.sub(start, end - start);
+                    }
+                }
+
                 var audioBuffer = new AudioBuffer(bytes, tmpDecoder);
                 if (successCallback != null) {
                     haxe.EntryPoint.runInMainThread(() -> successCallback(audioBuffer));
@@ -170,6 +246,24 @@ class AudioContext {
         return this.maDevice.sampleRate;
     }
 
+    inline function get_renderQuantumSize(): Int {
+        return userData.renderQuantumSize;
+    }
+
+    inline function get_baseLatency(): Float {
+        var periods: Int = maDevice.playback.internalPeriods > 0 ? maDevice.playback.internalPeriods : 1;
+        var periodSizeInFrames: Int = Std.int(maDevice.playback.internalBufferSizeInFrames / periods);
+        return periodSizeInFrames / maDevice.playback.internalSampleRate;
+    }
+
+    inline function get_outputLatency(): Float {
+        return maDevice.playback.internalBufferSizeInFrames / maDevice.playback.internalSampleRate;
+    }
+
+    static inline var DEFAULT_RENDER_QUANTUM_SIZE = 128;
+    static inline var DEFAULT_PERIODS = 3; // matches MA_DEFAULT_PERIODS
+    static inline var LOW_LATENCY_THRESHOLD_S = 0.02;
+
     static var gcReference = new List<AudioContext>();
 
     /**
@@ -188,10 +282,10 @@ class AudioContext {
         var schedulingCurrentFrameBlock: Int64 = userData.schedulingCurrentFrameBlock.getUnsafe();
         userData.schedulingCurrentFrameBlock.mutex.unlock();
 
-        // the audio graph is processed in blocks of 128 frames called a 'render-quantum'
+        // the audio graph is processed in blocks of frames called a 'render-quantum', this is 128 frames by default
         // https://webaudio.github.io/web-audio-api/#render-quantum
 
-        final quantaLength = 128;
+        final quantaLength = userData.renderQuantumSize;
         var framesRemaining = frameCount;
 
         while (framesRemaining > 0) {
@@ -220,6 +314,10 @@ class AudioContext {
         return untyped __global__.Audio_mixSources(sources, nChannels, frameCount, schedulingCurrentFrameBlock, output);
     }
 
+    static inline function getMp3GaplessTrim(fileBytes: ConstStar<cpp.Void>, byteLength: cpp.SizeT, leadingFrames: Star<UInt32>, trailingFrames: Star<UInt32>): Bool {
+        return untyped __global__.Audio_getMp3GaplessTrim(fileBytes, byteLength, leadingFrames, trailingFrames);
+    }
+
     static function finalizer(instance: AudioContext) {
         #if debug
         Stdio.printf("%s\n", "[debug] AudioContext.finalizer()");
@@ -236,10 +334,12 @@ class DeviceUserData {
 
     public final nativeNodeList: Star<NativeAudioNodeList>;
     public final schedulingCurrentFrameBlock: audio.native.LockedValue<Int64>;
+    public final renderQuantumSize: UInt32;
 
-    public function new(context: AudioContext, nativeNodeList: Pointer<NativeAudioNodeList>) {
+    public function new(context: AudioContext, nativeNodeList: Pointer<NativeAudioNodeList>, renderQuantumSize: UInt32) {
         this.nativeNodeList = nativeNodeList.ptr;
         this.schedulingCurrentFrameBlock = new LockedValue(context);
+        this.renderQuantumSize = renderQuantumSize;
     }
 
 }
@@ -30,8 +30,12 @@ class AudioScheduledSourceNode extends AudioNode {
 		activate();
 		nativeNode.setScheduledStartFrame(cast context.sampleRate * when);
 
-		if (offset != 0.0 && decoder != null) {
-			decoder.seekToPcmFrame(cast decoder.sampleRate * offset);
+		if (offset != 0.0) {
+			if (decoder != null) {
+				decoder.seekToPcmFrame(cast decoder.sampleRate * offset);
+			} else {
+				nativeNode.setPcmFrameIndex(cast context.sampleRate * offset);
+			}
 		}
 
 		if (duration != null) {
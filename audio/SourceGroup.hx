@@ -0,0 +1,184 @@
+package audio;
+
+#if js
+
+/**
+	Starts, stops and loops a set of `AudioBufferSourceNode`s together, for example phase-locked music stems.
+	WebAudio schedules sources sample-accurately when given the same `when` so this forwards to each source
+
+	WebAudio has no way to move the playhead of a started source or to change `loop` at a future time, so on js:
+	- `seek()` is not supported and throws
+	- `setLoop()` applies on a timer at `when`, accurate to the main thread's timers rather than to the frame
+**/
+class SourceGroup {
+
+	public final context: AudioContext;
+	public final sources: Array<AudioBufferSourceNode>;
+
+	public function new(context: AudioContext, ?sources: Array<AudioBufferSourceNode>) {
+		this.context = context;
+		this.sources = sources != null ? sources.copy() : [];
+	}
+
+	public function add(source: AudioBufferSourceNode) {
+		if (sources.indexOf(source) == -1) {
+			sources.push(source);
+		}
+	}
+
+	public function start(when: Float = 0.0, offset: Float = 0.0, ?duration: Float) {
+		for (source in sources) {
+			source.start(when, offset, duration);
+		}
+	}
+
+	public function stop(when: Float = 0.0) {
+		for (source in sources) {
+			source.stop(when);
+		}
+	}
+
+	/**
+		Not supported on js, started WebAudio sources cannot seek
+		@throws String always
+	**/
+	public function seek(offset: Float, when: Float = 0.0) {
+		throw 'SourceGroup.seek is not supported on js';
+	}
+
+	/**
+		Change `loop` on all sources at time `when`, on js this is timer-accurate rather than frame-accurate
+	**/
+	public function setLoop(loop: Bool, when: Float = 0.0) {
+		var delayMs = Math.round((when - context.currentTime) * 1000);
+		if (delayMs <= 0) {
+			for (source in sources) {
+				source.loop = loop;
+			}
+		} else {
+			haxe.Timer.delay(() -> setLoop(loop), delayMs);
+		}
+	}
+
+}
+
+#else
+
+import cpp.*;
+import audio.native.NativeAudioNode;
+
+/**
+	Starts, seeks, loops and stops a set of `AudioBufferSourceNode`s together, for example phase-locked music stems.
+
+	Each operation is sent to the audio thread as a single command that all sources observe on the same frame.
+	If the requested time has already passed (or is within the render quantum currently being mixed) the operation is delayed to the next render quantum
+**/
+@:access(audio.AudioContext)
+@:access(audio.AudioNode)
+@:access(audio.AudioScheduledSourceNode)
+class SourceGroup {
+
+	public final context: AudioContext;
+	public final sources: Array<AudioBufferSourceNode>;
+
+	var started = false;
+
+	public function new(context: AudioContext, ?sources: Array<AudioBufferSourceNode>) {
+		this.context = context;
+		this.sources = [];
+		if (sources != null) {
+			for (source in sources) add(source);
+		}
+	}
+
+	/**
+		@throws String
+	**/
+	public function add(source: AudioBufferSourceNode) {
+		if (started) {
+			throw "Failed to execute 'add' on 'SourceGroup': cannot add sources after start.";
+		}
+		if (source.context != context) {
+			throw "Failed to execute 'add' on 'SourceGroup': source belongs to a different AudioContext.";
+		}
+		if (sources.indexOf(source) == -1) {
+			sources.push(source);
+		}
+	}
+
+	/**
+		Start all sources on the same frame
+		@throws String
+	**/
+	public function start(when: Float = 0.0, offset: Float = 0.0, ?duration: Float) {
+		if (started) {
+			throw "Failed to execute 'start' on 'SourceGroup': cannot call start more than once.";
+		}
+		for (source in sources) {
+			if (source.nativeNode.getScheduledStartFrame() != -1) {
+				throw "Failed to execute 'start' on 'SourceGroup': a source has already been started.";
+			}
+		}
+		started = true;
+
+		// sources are held silent while they're connected into the graph, then released together
+		for (source in sources) {
+			source.nativeNode.setScheduledStartFrame(untyped __cpp__('AUDIO_NODE_FRAME_HELD'));
+			source.activate();
+		}
+
+		var startFrame: Int64 = secondsToFrames(when);
+		var stopFrame: Int64 = duration != null ? secondsToFrames(when + duration) : -1;
+		var offsetFrames: Int64 = secondsToFrames(offset);
+		schedule(startFrame, stopFrame, startFrame, offsetFrames, -1);
+
+		for (source in sources) {
+			source.pollReachedEndFlag();
+		}
+	}
+
+	/**
+		@throws String
+	**/
+	public function stop(when: Float = 0.0) {
+		if (!started) {
+			throw "Failed to execute 'stop' on 'SourceGroup': cannot call stop without calling start first";
+		}
+		schedule(-1, secondsToFrames(when), -1, -1, -1);
+	}
+
+	/**
+		Move all sources to `offset` seconds into their buffers at time `when`
+	**/
+	public function seek(offset: Float, when: Float = 0.0) {
+		schedule(-1, -1, secondsToFrames(when), secondsToFrames(offset), -1);
+	}
+
+	/**
+		Change `loop` on all sources at time `when`
+	**/
+	public function setLoop(loop: Bool, when: Float = 0.0) {
+		schedule(-1, -1, secondsToFrames(when), -1, loop ? 1 : 0);
+	}
+
+	function schedule(startFrame: Int64, stopFrame: Int64, commandFrame: Int64, frameIndex: Int64, loop: Int) {
+		var nativeNodes: Array<Star<NativeAudioNode>> = [for (source in sources) source.nativeNode];
+		NativeAudioNode.scheduleGroup(
+			nativeNodes,
+			startFrame,
+			stopFrame,
+			commandFrame,
+			frameIndex,
+			loop,
+			context.userData.schedulingCurrentFrameBlock,
+			context.userData.renderQuantumSize
+		);
+	}
+
+	inline function secondsToFrames(t: Float): Int64 {
+		return t > 0 ? cast Math.round(t * context.sampleRate) : 0;
+	}
+
+}
+
+#end
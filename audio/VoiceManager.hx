@@ -0,0 +1,176 @@
+package audio;
+
+/**
+	Caps the number of voices mixed by the audio thread.
+
+	Voices are ranked by priority, then by audibility. The top `maxVoices` audible voices are real, the rest are virtual: a virtual voice's playhead
+	keeps advancing (so it resumes in the right place when it becomes real again) but it is not read or mixed. Call `update()` after changing voice
+	gain, distance or priority, typically once per frame.
+
+	On js the browser mixes every source so virtual voices continue to play; only `stopWhenVirtual` voices are affected
+**/
+#if !js
+@:access(audio.AudioNode)
+#end
+class VoiceManager {
+
+	public final context: AudioContext;
+
+	/**
+		Hard limit of real voices
+	**/
+	public var maxVoices: Int;
+
+	/**
+		Voices with an audibility below this are virtual even when there are free real voices
+	**/
+	public var audibilityThreshold: Float;
+
+	public var voiceCount (get, never): Int;
+	public var realVoiceCount (default, null): Int = 0;
+
+	final voices = new Array<Voice>();
+
+	public function new(context: AudioContext, ?options: {
+		?maxVoices: Int, // default 64
+		?audibilityThreshold: Float, // default 0.001 (-60dB)
+	}) {
+		this.context = context;
+		this.maxVoices = options != null && options.maxVoices != null ? options.maxVoices : 64;
+		this.audibilityThreshold = options != null && options.audibilityThreshold != null ? options.audibilityThreshold : 0.001;
+	}
+
+	/**
+		Register `source` as a voice and start it. The voice is made real or virtual before it starts so it never exceeds the budget
+		@throws String
+	**/
+	public function play(source: AudioBufferSourceNode, ?options: {
+		?priority: Int, // higher priority voices are made real first, default 0
+		?gain: Float, // default 1
+		?distance: Float, // default 0
+		?refDistance: Float, // default 1
+		?stopWhenVirtual: Bool, // stop rather than virtualise when the voice loses its real slot, default false
+	}, when: Float = 0.0, offset: Float = 0.0, ?duration: Float): Voice {
+		var voice = new Voice(source, options);
+		voices.push(voice);
+		#if js
+		source.addEventListener('ended', () -> voice.ended = true);
+		#end
+		update();
+		if (!voice.ended) {
+			source.start(when, offset, duration);
+		}
+		return voice;
+	}
+
+	/**
+		Re-rank voices and assign real and virtual states; finished voices are removed
+	**/
+	public function update() {
+		var i = voices.length - 1;
+		while (i >= 0) {
+			var voice = voices[i];
+			#if !js
+			if (!voice.ended && voice.source.nativeNode.getOnReachEndFlag()) {
+				voice.ended = true;
+			}
+			#end
+			if (voice.ended) {
+				voices.splice(i, 1);
+			}
+			i--;
+		}
+
+		voices.sort(compareVoices);
+
+		realVoiceCount = 0;
+		for (voice in voices) {
+			var real = realVoiceCount < maxVoices && voice.audibility >= audibilityThreshold;
+			if (real) {
+				realVoiceCount++;
+			}
+			setVirtual(voice, !real);
+		}
+	}
+
+	function setVirtual(voice: Voice, isVirtual: Bool) {
+		if (voice.isVirtual == isVirtual) return;
+		voice.isVirtual = isVirtual;
+
+		if (isVirtual && voice.stopWhenVirtual) {
+			// a voice that hasn't started yet has no scheduled start so cannot be stopped; it's ended instead and never started
+			#if js
+			try voice.source.stop() catch (e: Any) {}
+			#else
+			if (voice.source.nativeNode.getScheduledStartFrame() != -1) {
+				voice.source.stop();
+			}
+			#end
+			voice.ended = true;
+			return;
+		}
+
+		#if !js
+		voice.source.nativeNode.setIsVirtual(isVirtual);
+		#end
+	}
+
+	inline function get_voiceCount() {
+		return voices.length;
+	}
+
+	static function compareVoices(a: Voice, b: Voice): Int {
+		if (a.priority != b.priority) {
+			return b.priority - a.priority;
+		}
+		var audibilityA = a.audibility;
+		var audibilityB = b.audibility;
+		return audibilityA > audibilityB ? -1 : (audibilityA < audibilityB ? 1 : 0);
+	}
+
+}
+
+@:allow(audio.VoiceManager)
+class Voice {
+
+	public final source: AudioBufferSourceNode;
+	public var priority: Int;
+
+	/**
+		Gain applied to this voice downstream, used to estimate audibility
+	**/
+	public var gain: Float;
+
+	/**
+		Distance from the listener, audibility falls off with the inverse distance model beyond `refDistance`
+	**/
+	public var distance: Float;
+	public var refDistance: Float;
+
+	public var stopWhenVirtual: Bool;
+
+	public var audibility (get, never): Float;
+	public var isVirtual (default, null): Bool = false;
+	public var ended (default, null): Bool = false;
+
+	function new(source: AudioBufferSourceNode, ?options: {
+		?priority: Int,
+		?gain: Float,
+		?distance: Float,
+		?refDistance: Float,
+		?stopWhenVirtual: Bool,
+	}) {
+		this.source = source;
+		this.priority = options != null && options.priority != null ? options.priority : 0;
+		this.gain = options != null && options.gain != null ? options.gain : 1.0;
+		this.distance = options != null && options.distance != null ? options.distance : 0.0;
+		this.refDistance = options != null && options.refDistance != null ? options.refDistance : 1.0;
+		this.stopWhenVirtual = options != null && options.stopWhenVirtual != null ? options.stopWhenVirtual : false;
+	}
+
+	function get_audibility(): Float {
+		var attenuation = distance > refDistance ? refDistance / distance : 1.0;
+		return Math.abs(gain) * attenuation;
+	}
+
+}
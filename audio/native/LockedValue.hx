@@ -41,6 +41,13 @@ import cpp.*;
 		return value = v;
 	}
 
+	/**
+		Address of the value for native code that locks `mutex` itself
+	**/
+	@:noDebug public inline function getUnsafeAddress(): Star<T> {
+		return Native.addressOf(value);
+	}
+
 }
 
 @:access(audio.native.LockedValue)
@@ -15,6 +15,14 @@ extern class NativeAudioNode {
 	var lock: Star<audio.native.MiniAudio.Mutex>;
 	private var readFramesCallback: ReadFramesCallback;
 	private var decoder: Star<NativeAudioDecoder>;
+	private var pcmFrames: ConstStar<Float32>;
+	private var pcmFrameCount: UInt64;
+	private var pcmChannels: UInt32;
+	private var pcmFrameIndex: UInt64;
+	private var loopStartFrame: UInt64;
+	private var loopEndFrame: UInt64;
+	private var loopCrossfadeFrames: UInt32;
+	private var isVirtual: Bool;
 	private var active: Bool;
 	private var scheduledStartFrame: Int64;
 	private var scheduledStopFrame: Int64;
@@ -38,6 +46,59 @@ extern class NativeAudioNode {
 		return lock.locked(() -> decoder);
 	}
 
+	/**
+		Set interleaved float32 frames to read directly on the audio thread, these take priority over the decoder.
+		The frames must remain allocated until replaced
+	**/
+	inline function setPcmFrames(frames: ConstStar<Float32>, frameCount: UInt64, channels: UInt32): Void {
+		lock.lock();
+		pcmFrames = frames;
+		pcmFrameCount = frameCount;
+		pcmChannels = channels;
+		pcmFrameIndex = 0;
+		lock.unlock();
+	}
+
+	inline function getPcmFrameIndex(): UInt64 {
+		return lock.locked(() -> pcmFrameIndex);
+	}
+
+	inline function setPcmFrameIndex(v: UInt64): UInt64 {
+		return lock.locked(() -> pcmFrameIndex = v);
+	}
+
+	inline function getLoopStartFrame(): UInt64 {
+		return lock.locked(() -> loopStartFrame);
+	}
+
+	inline function setLoopStartFrame(v: UInt64): UInt64 {
+		return lock.locked(() -> loopStartFrame = v);
+	}
+
+	inline function getLoopEndFrame(): UInt64 {
+		return lock.locked(() -> loopEndFrame);
+	}
+
+	inline function setLoopEndFrame(v: UInt64): UInt64 {
+		return lock.locked(() -> loopEndFrame = v);
+	}
+
+	inline function getLoopCrossfadeFrames(): UInt32 {
+		return lock.locked(() -> loopCrossfadeFrames);
+	}
+
+	inline function setLoopCrossfadeFrames(v: UInt32): UInt32 {
+		return lock.locked(() -> loopCrossfadeFrames = v);
+	}
+
+	inline function getIsVirtual(): Bool {
+		return lock.locked(() -> isVirtual);
+	}
+
+	inline function setIsVirtual(v: Bool): Bool {
+		return lock.locked(() -> isVirtual = v);
+	}
+
 	inline function getActive(): Bool {
 		return lock.locked(() -> active);
 	}
@@ -86,6 +147,41 @@ extern class NativeAudioNode {
 		return lock.locked(() -> userData);
 	}
 
+	/**
+		See `AudioNode_scheduleGroup` in native.h, returns the number of frames all requested frames were shifted by
+	**/
+	static inline function scheduleGroup(
+		nodes: Array<Star<NativeAudioNode>>,
+		startFrame: Int64,
+		stopFrame: Int64,
+		commandFrame: Int64,
+		frameIndex: Int64,
+		loop: Int,
+		frameBlock: audio.native.LockedValue<Int64>,
+		renderQuantumSize: UInt32
+	): Int64 {
+		if (nodes.length == 0) return 0;
+		var nodesPointer = NativeArray.address(nodes, 0);
+		var frameBlockMutex = frameBlock.mutex;
+		var frameBlockAddress = frameBlock.getUnsafeAddress();
+		// locking may wait on the audio thread so we allow the GC to run in the meantime
+		cpp.vm.Gc.enterGCFreeZone();
+		var shift: Int64 = untyped __global__.AudioNode_scheduleGroup(
+			nodesPointer,
+			nodes.length,
+			startFrame,
+			stopFrame,
+			commandFrame,
+			frameIndex,
+			loop,
+			frameBlockMutex,
+			frameBlockAddress,
+			renderQuantumSize
+		);
+		cpp.vm.Gc.exitGCFreeZone();
+		return shift;
+	}
+
 	@:native('AudioNode_create')
 	static function create(maContext: Star<audio.native.MiniAudio.Context>): Star<NativeAudioNode>;
 
@@ -87,6 +87,15 @@ AudioNode* AudioNode_create(ma_context* context) {
 
 	instance->readFramesCallback = NULL;
 	instance->decoder = NULL;
+	instance->pcmFrames = NULL;
+	instance->pcmFrameCount = 0;
+	instance->pcmChannels = 0;
+	instance->pcmFrameIndex = 0;
+	instance->loopStartFrame = 0;
+	instance->loopEndFrame = 0;
+	instance->loopCrossfadeFrames = 0;
+	instance->scheduledCommandCount = 0;
+	instance->isVirtual = MA_FALSE;
 	instance->active = MA_FALSE;
 	instance->scheduledStartFrame = -1;
 	instance->scheduledStopFrame = -1;
@@ -104,6 +113,212 @@ void AudioNode_destroy(AudioNode* instance) {
 	ma_free(instance);
 }
 
+/**
+ * Resolves the region the playhead wraps within, when not looping this is the whole buffer with no crossfade
+ */
+static void AudioNode_getPcmLoopRegion(AudioNode* node, ma_uint64* pLoopStart, ma_uint64* pLoopEnd, ma_uint64* pCrossfade) {
+	// when not looping we play through to the end of the buffer, regardless of the loop region
+	ma_uint64 loopStart = 0;
+	ma_uint64 loopEnd = node->pcmFrameCount;
+	ma_uint64 crossfade = 0;
+	if (node->loop == MA_TRUE) {
+		if (node->loopEndFrame != 0 && node->loopEndFrame < node->pcmFrameCount) {
+			loopEnd = node->loopEndFrame;
+		}
+		if (node->loopStartFrame < loopEnd) {
+			loopStart = node->loopStartFrame;
+		}
+		// the loop head is consumed by the crossfade so we limit it to half the loop length
+		crossfade = ma_min(node->loopCrossfadeFrames, (loopEnd - loopStart) / 2);
+	}
+	*pLoopStart = loopStart;
+	*pLoopEnd = loopEnd;
+	*pCrossfade = crossfade;
+}
+
+ma_uint32 AudioNode_readPcmFrames(AudioNode* node, ma_uint32 frameCount, float* pFramesOut) {
+	const ma_uint32 channels = node->pcmChannels;
+	const ma_bool32 loop = node->loop == MA_TRUE;
+
+	ma_uint64 loopStart, loopEnd, crossfade;
+	AudioNode_getPcmLoopRegion(node, &loopStart, &loopEnd, &crossfade);
+	const ma_uint64 fadeStart = loopEnd - crossfade;
+
+	ma_uint32 framesRead = 0;
+	while (framesRead < frameCount) {
+		if (node->pcmFrameIndex >= loopEnd) {
+			if (!loop || loopEnd == loopStart) break;
+			// the first `crossfade` frames of the loop head have already been played blended into the tail
+			node->pcmFrameIndex = loopStart + crossfade;
+		}
+
+		ma_uint64 index = node->pcmFrameIndex;
+		ma_uint32 framesToCopy = (ma_uint32) ma_min(frameCount - framesRead, loopEnd - index);
+		float* out = pFramesOut + framesRead * channels;
+
+		if (index + framesToCopy <= fadeStart) {
+			memcpy(out, node->pcmFrames + index * channels, framesToCopy * channels * sizeof(float));
+		} else {
+			// linear crossfade from the loop tail into the loop head
+			for (ma_uint32 i = 0; i < framesToCopy; i++) {
+				ma_uint64 frame = index + i;
+				const float* tail = node->pcmFrames + frame * channels;
+				if (frame < fadeStart) {
+					for (ma_uint32 c = 0; c < channels; c++) out[i * channels + c] = tail[c];
+				} else {
+					ma_uint64 fadeFrame = frame - fadeStart;
+					const float* head = node->pcmFrames + (loopStart + fadeFrame) * channels;
+					float t = (float) fadeFrame / (float) crossfade;
+					for (ma_uint32 c = 0; c < channels; c++) {
+						out[i * channels + c] = tail[c] * (1.0f - t) + head[c] * t;
+					}
+				}
+			}
+		}
+
+		node->pcmFrameIndex += framesToCopy;
+		framesRead += framesToCopy;
+	}
+
+	return framesRead;
+}
+
+ma_uint32 AudioNode_skipPcmFrames(AudioNode* node, ma_uint32 frameCount) {
+	const ma_bool32 loop = node->loop == MA_TRUE;
+
+	ma_uint64 loopStart, loopEnd, crossfade;
+	AudioNode_getPcmLoopRegion(node, &loopStart, &loopEnd, &crossfade);
+
+	ma_uint32 framesSkipped = 0;
+	while (framesSkipped < frameCount) {
+		if (node->pcmFrameIndex >= loopEnd) {
+			if (!loop || loopEnd == loopStart) break;
+			node->pcmFrameIndex = loopStart + crossfade;
+		}
+		ma_uint32 framesToSkip = (ma_uint32) ma_min(frameCount - framesSkipped, loopEnd - node->pcmFrameIndex);
+		node->pcmFrameIndex += framesToSkip;
+		framesSkipped += framesToSkip;
+	}
+
+	return framesSkipped;
+}
+
+static void AudioNodeCommand_merge(AudioNodeCommand* command, ma_int64 frameIndex, ma_int32 loop) {
+	if (frameIndex != -1) command->frameIndex = frameIndex;
+	if (loop != -1) command->loop = loop;
+}
+
+void AudioNode_queueCommand(AudioNode* node, ma_int64 frame, ma_int64 frameIndex, ma_int32 loop) {
+	AudioNodeCommand* commands = node->scheduledCommands;
+	ma_uint32 count = node->scheduledCommandCount;
+
+	// insert after every command on or before `frame`
+	ma_uint32 index = count;
+	while (index > 0 && commands[index - 1].frame > frame) index--;
+
+	if (index > 0 && commands[index - 1].frame == frame) {
+		AudioNodeCommand_merge(&commands[index - 1], frameIndex, loop);
+		return;
+	}
+
+	if (count == AUDIO_NODE_MAX_SCHEDULED_COMMANDS) {
+		// make room by merging the last two commands, the values of the later one win at the earlier one's frame
+		AudioNodeCommand_merge(&commands[count - 2], commands[count - 1].frameIndex, commands[count - 1].loop);
+		count--;
+		index = count;
+		while (index > 0 && commands[index - 1].frame > frame) index--;
+	}
+
+	memmove(&commands[index + 1], &commands[index], (count - index) * sizeof(*commands));
+	commands[index].frame = frame;
+	commands[index].frameIndex = frameIndex;
+	commands[index].loop = loop;
+	node->scheduledCommandCount = count + 1;
+}
+
+/**
+ * Applies the seek and loop change of the next group command and removes it from the queue, the node must be locked by the caller
+ */
+static void AudioNode_applyScheduledCommand(AudioNode* node) {
+	AudioNodeCommand command = node->scheduledCommands[0];
+	if (command.frameIndex != -1) {
+		if (node->pcmFrames != NULL) {
+			node->pcmFrameIndex = (ma_uint64) command.frameIndex;
+		} else if (node->decoder != NULL) {
+			AudioDecoder_seekToPcmFrame(node->decoder, (ma_uint64) command.frameIndex);
+		}
+	}
+	if (command.loop != -1) {
+		node->loop = command.loop ? MA_TRUE : MA_FALSE;
+	}
+	node->scheduledCommandCount--;
+	memmove(&node->scheduledCommands[0], &node->scheduledCommands[1], node->scheduledCommandCount * sizeof(command));
+}
+
+static int AudioNode_comparePointers(const void* a, const void* b) {
+	AudioNode* nodeA = *(AudioNode* const*)a;
+	AudioNode* nodeB = *(AudioNode* const*)b;
+	return (nodeA > nodeB) - (nodeA < nodeB);
+}
+
+ma_int64 AudioNode_scheduleGroup(
+	AudioNode** nodes,
+	ma_uint32   nodeCount,
+	ma_int64    startFrame,
+	ma_int64    stopFrame,
+	ma_int64    commandFrame,
+	ma_int64    frameIndex,
+	ma_int32    loop,
+	ma_mutex*   frameBlockLock,
+	const ma_int64* pFrameBlock,
+	ma_uint32   renderQuantumSize
+) {
+	if (nodeCount == 0) return 0;
+
+	// lock in a consistent (address) order so concurrent group commands cannot deadlock
+	AudioNode** sortedNodes = (AudioNode**)ma_malloc(sizeof(*sortedNodes) * nodeCount);
+	memcpy(sortedNodes, nodes, sizeof(*sortedNodes) * nodeCount);
+	qsort(sortedNodes, nodeCount, sizeof(*sortedNodes), AudioNode_comparePointers);
+
+	for (ma_uint32 i = 0; i < nodeCount; i++) {
+		if (i > 0 && sortedNodes[i] == sortedNodes[i - 1]) continue;
+		ma_mutex_lock(sortedNodes[i]->lock);
+	}
+
+	// while the nodes are locked the audio thread cannot read any of them, so the block currently being mixed (if any) starts at frameBlock
+	// and the earliest frame we can safely schedule for is the start of the block after it
+	ma_mutex_lock(frameBlockLock);
+	ma_int64 earliestFrame = (*pFrameBlock) + renderQuantumSize;
+	ma_mutex_unlock(frameBlockLock);
+
+	ma_int64 requestedFrame = -1;
+	if (startFrame != -1) requestedFrame = startFrame;
+	if (stopFrame != -1 && (requestedFrame == -1 || stopFrame < requestedFrame)) requestedFrame = stopFrame;
+	if (commandFrame != -1 && (requestedFrame == -1 || commandFrame < requestedFrame)) requestedFrame = commandFrame;
+
+	// shift everything by the same amount so relative timing is preserved
+	ma_int64 shift = (requestedFrame != -1 && requestedFrame < earliestFrame) ? earliestFrame - requestedFrame : 0;
+
+	for (ma_uint32 i = 0; i < nodeCount; i++) {
+		if (i > 0 && sortedNodes[i] == sortedNodes[i - 1]) continue;
+		AudioNode* node = sortedNodes[i];
+		if (startFrame != -1) node->scheduledStartFrame = startFrame + shift;
+		if (stopFrame != -1) node->scheduledStopFrame = stopFrame + shift;
+		if (commandFrame != -1) {
+			AudioNode_queueCommand(node, commandFrame + shift, frameIndex, loop);
+		}
+	}
+
+	for (ma_uint32 i = nodeCount; i > 0; i--) {
+		if (i < nodeCount && sortedNodes[i - 1] == sortedNodes[i]) continue;
+		ma_mutex_unlock(sortedNodes[i - 1]->lock);
+	}
+
+	ma_free(sortedNodes);
+
+	return shift;
+}
+
 /**
  * AudioNodeList
  */
@@ -128,8 +343,9 @@ void AudioNodeList_destroy(AudioNodeList* instance) {
 	// free source list nodes
 	AudioNodeListNode* currentSourceListNode = instance->sourceNext;
 	while (currentSourceListNode != NULL) {
+		AudioNodeListNode* nextSourceListNode = currentSourceListNode->next;
 		ma_free(currentSourceListNode);
-		currentSourceListNode = currentSourceListNode->next;
+		currentSourceListNode = nextSourceListNode;
 	}
 
 	ma_free(instance);
@@ -209,10 +425,9 @@ ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma
 		return 0;
 	}
 
-	static float decoderOutputBuffer[4096];
-	// clear the scratch buffer to 0, this is required because we might not replace all the bytes when reading
-	// (as scheduling makes it possible to create gaps)
-	memset(decoderOutputBuffer, 0, frameCount * channelCount);
+	// the scratch buffer lives on the stack rather than being static because this function is re-entered by nodes with a readFramesCallback
+	// (which mix their own inputs into the caller's scratch buffer) and may be called from multiple device threads
+	float decoderOutputBuffer[AUDIO_MIX_BUFFER_SAMPLE_COUNT];
 
 	ma_uint32 bufferMaxFrames = ma_countof(decoderOutputBuffer) / channelCount;
 	ma_uint32 writtenDataWidth = 0;
@@ -272,11 +487,16 @@ ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma
 					goto NEXT_SOURCE; 
 				}
 
-				// if we have neither a read frames callback or a decoder then we can't read anything
-				if (source->readFramesCallback == NULL && source->decoder == NULL) goto NEXT_SOURCE;
+				// if we have neither a read frames callback, pcm frames or a decoder then we can't read anything
+				if (source->readFramesCallback == NULL && source->pcmFrames == NULL && source->decoder == NULL) goto NEXT_SOURCE;
+
+				// pcm frames must already be in the output channel layout
+				if (source->readFramesCallback == NULL && source->pcmFrames != NULL && source->pcmChannels != channelCount) {
+					goto NEXT_SOURCE;
+				}
 
 				// if we do have a decoder, validate that it has the right output format and channel count
-				if (source->decoder != NULL) {
+				if (source->readFramesCallback == NULL && source->pcmFrames == NULL && source->decoder != NULL) {
 					// decoder should be setup to read into float buffers, if not then something has gone wrong
 					if (source->decoder->maDecoder->outputFormat != ma_format_f32) {
 						// error, output format must be F32
@@ -290,6 +510,12 @@ ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma
 					}
 				}
 
+				// virtual sources advance their playhead and scheduling state but are not mixed
+				// this only applies to sources, nodes with a readFramesCallback process their own inputs
+				// they still hold the node lock: the playhead, loop region, commands and schedule they advance are written by the haxe thread under the
+				// same lock (seek, setLoop, scheduleGroup, stop), so an unlocked skip could drop a seek or read a command queue mid-insert
+				const ma_bool32 isVirtual = source->isVirtual == MA_TRUE && source->readFramesCallback == NULL;
+
 				// read and mix frames in chunks of decoderOutputBuffer length
 				ma_uint32 totalFramesRead = 0;
 				int loopIndex = -1;
@@ -298,11 +524,32 @@ ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma
 					loopIndex++;
 					ma_uint32 framesRemaining = totalFramesToRead - totalFramesRead;
 					ma_uint32 chunkFrameCount = ma_min(framesRemaining, bufferMaxFrames);
+
+					// a pending group command is applied exactly at its frame: frames before it are read with the previous playhead and loop state
+					// a source that isn't playing at the command frame has nothing to read until its start, so the command is applied before its first frame
+					while (source->scheduledCommandCount > 0) {
+						ma_int64 framesUntilCommand = source->scheduledCommands[0].frame - (schedulingCurrentFrameBlock + localStartFrame + totalFramesRead);
+						if (framesUntilCommand <= 0) {
+							AudioNode_applyScheduledCommand(source);
+						} else {
+							if (framesUntilCommand < chunkFrameCount) chunkFrameCount = (ma_uint32) framesUntilCommand;
+							break;
+						}
+					}
 					
 					ma_uint32 framesRead;
 					if (source->readFramesCallback != NULL) {
+						// callbacks mix into the buffer rather than overwriting it so it must be cleared first
+						memset(decoderOutputBuffer, 0, chunkFrameCount * channelCount * sizeof(float));
+						// the callback's inputs are scheduled relative to the start of this chunk
+						ma_int64 chunkFrameBlock = schedulingCurrentFrameBlock + localStartFrame + totalFramesRead;
 						// be aware: the callback should not lock with the source (because it's already locked)
-						framesRead = source->readFramesCallback(source->userData, channelCount, chunkFrameCount, schedulingCurrentFrameBlock, decoderOutputBuffer);
+						framesRead = source->readFramesCallback(source->userData, channelCount, chunkFrameCount, chunkFrameBlock, decoderOutputBuffer);
+					} else if (source->pcmFrames != NULL) {
+						// looping is handled within the read so this only returns less than requested when the end is reached
+						framesRead = isVirtual
+							? AudioNode_skipPcmFrames(source, chunkFrameCount)
+							: AudioNode_readPcmFrames(source, chunkFrameCount, decoderOutputBuffer);
 					} else if (source->decoder != NULL) {
 						framesRead = (ma_uint32) AudioDecoder_readPcmFrames(source->decoder, chunkFrameCount, decoderOutputBuffer);
 					} else {
@@ -326,33 +573,43 @@ ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma
 					float* mixBuffer = pOutput + chunkOffset + startOffset;
 
 					// with compiler optimizations enabled, this should vectorize
-					for(ma_uint32 sampleIdx = 0; sampleIdx < sampleCount; ++sampleIdx) {
-						mixBuffer[sampleIdx] += decoderOutputBuffer[sampleIdx];
+					if (!isVirtual) {
+						for(ma_uint32 sampleIdx = 0; sampleIdx < sampleCount; ++sampleIdx) {
+							mixBuffer[sampleIdx] += decoderOutputBuffer[sampleIdx];
+						}
 					}
 
 					totalFramesRead += framesRead;
 
-					if (framesRead < chunkFrameCount) {
-						// we read less frames than we requested so we must have reached the end of this decoder
-						reachedBytesEndFlag = MA_TRUE;
+					if (framesRead > 0) {
+						// loopIndex counts reads since frames were last returned, so a looping decoder that returns no frames after seeking to its start is treated as empty
+						loopIndex = -1;
+					}
 
+					if (framesRead < chunkFrameCount) {
 						// if the decoder returns 0 frames after the first iteration (we've given it a chance to loop), then the decoder is probably empty; break to avoid infinite loop
 						if (framesRead == 0 && loopIndex >= 1) {
+							reachedBytesEndFlag = MA_TRUE;
 							break;
 						}
 
-						// if looping, seek to start and continue to read more frames
-						if (source->loop == MA_TRUE && source->decoder != NULL) {
+						// if looping a streaming decoder, seek to start and continue to read more frames
+						// (pcm frame sources loop without seeking so they never reach here when looping)
+						if (source->loop == MA_TRUE && source->readFramesCallback == NULL && source->pcmFrames == NULL && source->decoder != NULL) {
 							AudioDecoder_seekToPcmFrame(source->decoder, 0);
 							continue;
 						} else {
+							// we read less frames than we requested so we must have reached the end of this source
+							reachedBytesEndFlag = MA_TRUE;
 							break;
 						}
 					}
 				}
 
 				// update high water mark for width of data written
-				writtenDataWidth = ma_max(writtenDataWidth, localStartFrame + totalFramesRead);
+				if (!isVirtual) {
+					writtenDataWidth = ma_max(writtenDataWidth, localStartFrame + totalFramesRead);
+				}
 
 				if (reachedBytesEndFlag) {
 					source->onReachEndFlag = MA_TRUE;
@@ -366,4 +623,68 @@ ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma
 	ma_mutex_unlock(sourceList->lock);
 
 	return writtenDataWidth;
+}
+
+static ma_uint32 Audio_readUInt32BE(const ma_uint8* p) {
+	return ((ma_uint32)p[0] << 24) | ((ma_uint32)p[1] << 16) | ((ma_uint32)p[2] << 8) | (ma_uint32)p[3];
+}
+
+ma_bool32 Audio_getMp3GaplessTrim(const void* pData, size_t dataSize, ma_uint32* pLeadingFrames, ma_uint32* pTrailingFrames) {
+	const ma_uint8* bytes = (const ma_uint8*)pData;
+	size_t offset = 0;
+
+	*pLeadingFrames = 0;
+	*pTrailingFrames = 0;
+
+	// skip ID3v2 tag, its size is a 28-bit 'syncsafe' integer
+	if (dataSize >= 10 && bytes[0] == 'I' && bytes[1] == 'D' && bytes[2] == '3') {
+		size_t tagSize = ((size_t)(bytes[6] & 0x7F) << 21) | ((size_t)(bytes[7] & 0x7F) << 14) | ((size_t)(bytes[8] & 0x7F) << 7) | (size_t)(bytes[9] & 0x7F);
+		offset = 10 + tagSize + ((bytes[5] & 0x10) ? 10 : 0);
+	}
+
+	if (offset + 4 > dataSize) return MA_FALSE;
+	const ma_uint8* header = bytes + offset;
+
+	// expect a layer III frame sync
+	if (header[0] != 0xFF || (header[1] & 0xE0) != 0xE0 || ((header[1] >> 1) & 3) != 1) return MA_FALSE;
+
+	ma_bool32 isMpeg1 = ((header[1] >> 3) & 3) == 3;
+	ma_bool32 isMono = ((header[3] >> 6) & 3) == 3;
+	ma_bool32 hasCrc = (header[1] & 1) == 0;
+	size_t sideInfoSize = isMpeg1 ? (isMono ? 17 : 32) : (isMono ? 9 : 17);
+	ma_uint32 framesPerMp3Frame = isMpeg1 ? 1152 : 576;
+
+	const ma_uint8* tag = header + 4 + (hasCrc ? 2 : 0) + sideInfoSize;
+	if ((size_t)(tag - bytes) + 8 > dataSize) return MA_FALSE;
+	if (memcmp(tag, "Xing", 4) != 0 && memcmp(tag, "Info", 4) != 0) return MA_FALSE;
+
+	// the Xing/Info frame decodes to silence
+	*pLeadingFrames = framesPerMp3Frame;
+
+	ma_uint32 flags = Audio_readUInt32BE(tag + 4);
+	const ma_uint8* lameTag = tag + 8;
+	if (flags & 0x1) lameTag += 4;   // frame count
+	if (flags & 0x2) lameTag += 4;   // byte count
+	if (flags & 0x4) lameTag += 100; // seek table
+	if (flags & 0x8) lameTag += 4;   // quality
+
+	// the encoder delay and padding fields are only defined by the LAME extension, which starts with the encoder's name and version
+	// other encoders may write arbitrary bytes after the Xing/Info fields so without the signature nothing more is trimmed
+	ma_bool32 hasLameTag = (size_t)(lameTag - bytes) + 24 <= dataSize && (
+		memcmp(lameTag, "LAME", 4) == 0 ||
+		memcmp(lameTag, "Lavf", 4) == 0 ||
+		memcmp(lameTag, "Lavc", 4) == 0
+	);
+
+	if (hasLameTag) {
+		// LAME extension: 12-bit encoder delay and padding at byte 21
+		// 528 + 1 frames of decoder delay are included by convention
+		const ma_uint32 decoderDelay = 528 + 1;
+		ma_uint32 encoderDelay = ((ma_uint32)lameTag[21] << 4) | ((ma_uint32)lameTag[22] >> 4);
+		ma_uint32 encoderPadding = (((ma_uint32)lameTag[22] & 0xF) << 8) | (ma_uint32)lameTag[23];
+		*pLeadingFrames += encoderDelay + decoderDelay;
+		*pTrailingFrames = encoderPadding > decoderDelay ? encoderPadding - decoderDelay : 0;
+	}
+
+	return MA_TRUE;
 }
\ No newline at end of file
@@ -57,12 +57,38 @@ ma_result     AudioDecoder_seekToPcmFrame(AudioDecoder* decoder, ma_uint64 frame
 
 typedef struct AudioNode AudioNode;
 
+/**
+ * Number of group commands a node can hold before they apply, see AudioNode_queueCommand()
+ */
+#ifndef AUDIO_NODE_MAX_SCHEDULED_COMMANDS
+#define AUDIO_NODE_MAX_SCHEDULED_COMMANDS 8
+#endif
+
+/**
+ * A seek and/or loop change applied by the audio thread on exactly `frame`
+ */
+typedef struct {
+	ma_int64 frame;
+	ma_int64 frameIndex; // -1 for none
+	ma_int32 loop; // -1 for none
+} AudioNodeCommand;
+
 typedef ma_uint64 (* AudioNode_ReadFramesCallback) (void* audioNodeUserData, ma_uint32 nChannels, ma_uint64 frameCount, ma_int64 schedulingCurrentFrameBlock, float* buffer);
 
 struct AudioNode {
 	AudioNode_ReadFramesCallback readFramesCallback; // allowed to be  NULL, when not null, this takes priority over reading from the decoder
 	ma_mutex*                    lock;
 	AudioDecoder*                decoder; // allowed to be  NULL
+	const float*                 pcmFrames; // allowed to be NULL, interleaved f32 frames read directly (without a decoder); takes priority over the decoder
+	ma_uint64                    pcmFrameCount;
+	ma_uint32                    pcmChannels;
+	ma_uint64                    pcmFrameIndex; // playhead into pcmFrames
+	ma_uint64                    loopStartFrame; // only applies to pcmFrames sources
+	ma_uint64                    loopEndFrame; // exclusive, 0 for the end of pcmFrames
+	ma_uint32                    loopCrossfadeFrames; // frames of the loop tail that are blended with the loop head, 0 for a hard loop
+	AudioNodeCommand             scheduledCommands[AUDIO_NODE_MAX_SCHEDULED_COMMANDS]; // ordered by frame, the first applies next
+	ma_uint32                    scheduledCommandCount;
+	ma_bool32                    isVirtual; // when true a source's playhead advances without being mixed, pcmFrames sources skip reading entirely
 	ma_int64                     scheduledStartFrame; // -1 for none
 	ma_int64                     scheduledStopFrame;  // -1 for none
 	ma_bool32                    loop;
@@ -78,6 +104,52 @@ struct AudioNode {
 AudioNode* AudioNode_create(ma_context* context);
 void       AudioNode_destroy(AudioNode* instance);
 
+/**
+ * Reads frames from the node's pcmFrames, wrapping within the loop region when looping
+ * The node must be locked by the caller
+ */
+ma_uint32  AudioNode_readPcmFrames(AudioNode* node, ma_uint32 frameCount, float* pFramesOut);
+
+/**
+ * Advances the node's pcmFrames playhead as AudioNode_readPcmFrames would, without reading any frames
+ * The node must be locked by the caller
+ */
+ma_uint32  AudioNode_skipPcmFrames(AudioNode* node, ma_uint32 frameCount);
+
+/**
+ * Queues a seek to frameIndex and/or a loop change (-1 to leave either unchanged) to apply on exactly `frame`
+ * Commands are kept in frame order and each one only changes the values it sets, so an earlier command that hasn't applied yet is not lost.
+ * A command for the same frame as a queued one is merged into it. When the queue is full the last two queued commands are merged into one at the earlier frame
+ * The node must be locked by the caller
+ */
+void       AudioNode_queueCommand(AudioNode* node, ma_int64 frame, ma_int64 frameIndex, ma_int32 loop);
+
+/**
+ * Used as a scheduledStartFrame to hold an active node silent until it's scheduled
+ */
+#define AUDIO_NODE_FRAME_HELD ((ma_int64)0x7FFFFFFFFFFFFFFFLL)
+
+/**
+ * Schedules a group of source nodes with a single update so that all nodes in the group observe the change on the same frame
+ * - All nodes are locked together and no frame earlier than the next render quantum is used, so no node can be mid-way through a block that
+ *   the change applies to. If the requested frames are too early, they're all shifted later by the same amount and this shift is returned
+ * - startFrame and stopFrame are written directly, frameIndex and loop are queued with AudioNode_queueCommand() to apply on exactly commandFrame, which may fall within a render quantum
+ * - Pass -1 to leave a value unchanged
+ * - Nodes must be source nodes (with no inputs) so the lock order cannot conflict with the audio thread
+ */
+ma_int64   AudioNode_scheduleGroup(
+	AudioNode** nodes,
+	ma_uint32   nodeCount,
+	ma_int64    startFrame,
+	ma_int64    stopFrame,
+	ma_int64    commandFrame,
+	ma_int64    frameIndex,
+	ma_int32    loop,
+	ma_mutex*   frameBlockLock,
+	const ma_int64* pFrameBlock,
+	ma_uint32   renderQuantumSize
+);
+
 /**
  * AudioNodeListNode
  * 
@@ -111,12 +183,27 @@ int            AudioNodeList_sourceCount(AudioNodeList* list);
  * Global Audio Functions
  */
 
+/**
+ * Size of the scratch buffer used by Audio_mixSources, sources are read in chunks of at most this many samples
+ */
+#ifndef AUDIO_MIX_BUFFER_SAMPLE_COUNT
+#define AUDIO_MIX_BUFFER_SAMPLE_COUNT 4096
+#endif
+
 /**
  * The sourceList must have decoders with output format Float32 channelCount that matches the output buffer channel count
  * If channel count and format mismatches are detected mixing will be skipped for that decoder
  */
 ma_uint32 Audio_mixSources(AudioNodeList* sourceList, ma_uint32 channelCount, ma_uint32 frameCount, ma_int64 schedulingCurrentFrameBlock, float* pOutput);
 
+/**
+ * Reads the Xing/Info + LAME header of an MP3 file to determine the frames that should be trimmed from the start and end of the decoded output for gapless playback
+ * Encoder delay and padding are only trimmed when the header has a LAME extension written by LAME or FFmpeg (Lavf/Lavc), otherwise only the Xing/Info frame is trimmed
+ * Frame counts are in the file's sample rate
+ * Returns MA_FALSE if the file has no Xing/Info header
+ */
+ma_bool32 Audio_getMp3GaplessTrim(const void* pData, size_t dataSize, ma_uint32* pLeadingFrames, ma_uint32* pTrailingFrames);
+
 #ifdef __cplusplus
 }
 #endif
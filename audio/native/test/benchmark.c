@@ -0,0 +1,190 @@
+/**
+ * Mix throughput benchmarks for Audio_mixSources
+ *
+ * Output follows Google Benchmark's console format so results can be compared across commits:
+ *   ./benchmark                 table on stdout
+ *   ./benchmark --json > a.json results as JSON
+ * Each benchmark renders one second of 48kHz stereo in 128 frame quanta, repeated until at least `minTime` seconds have passed.
+ * The quantum sweep entries render the same graph in 64 to 512 frame quanta and are named `<benchmark>/<n>/quantum:<frames>`
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+
+#include "./graph.h"
+
+#define SAMPLE_RATE 48000
+#define CHANNELS 2
+#define DEFAULT_QUANTUM 128
+// VoiceManager's default maxVoices
+#define REAL_VOICES 64
+
+typedef enum {
+	GRAPH_SOURCES,    // n sources mixed directly into the destination
+	GRAPH_GAIN_CHAIN, // one source through a chain of n gains
+	GRAPH_GAIN_FAN,   // n sources each through their own gain
+	GRAPH_LOOPS,      // n looping sources with a crossfade
+	GRAPH_VIRTUAL,    // n virtual sources
+	GRAPH_VOICES,     // n requested voices of which REAL_VOICES are real and the rest virtual, as VoiceManager leaves them
+} GraphKind;
+
+typedef struct {
+	const char* name;
+	GraphKind kind;
+	ma_uint32 n;
+	// render quantum in frames, 0 for DEFAULT_QUANTUM
+	ma_uint32 quantum;
+} Benchmark;
+
+static double nowSeconds(clockid_t clock) {
+	struct timespec t;
+	clock_gettime(clock, &t);
+	return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void runBenchmark(const Benchmark* benchmark, double minTime, ma_bool32 json, ma_bool32 last) {
+	const ma_uint32 quantum = benchmark->quantum != 0 ? benchmark->quantum : DEFAULT_QUANTUM;
+	Graph graph;
+	Graph_init(&graph, CHANNELS, quantum);
+
+	const ma_uint64 length = SAMPLE_RATE;
+	float* sine = Graph_createSine(CHANNELS, length, 440, SAMPLE_RATE);
+	AudioNode** sources = (AudioNode**)malloc(sizeof(*sources) * benchmark->n);
+	GainNode** gains = (GainNode**)malloc(sizeof(*gains) * benchmark->n);
+	ma_uint32 gainCount = 0;
+
+	for (ma_uint32 i = 0; i < benchmark->n; i++) {
+		sources[i] = NULL;
+		if (benchmark->kind == GRAPH_GAIN_CHAIN && i > 0) continue;
+		sources[i] = Graph_createSource(&graph, sine, length);
+		sources[i]->loop = MA_TRUE;
+		if (benchmark->kind == GRAPH_LOOPS) {
+			sources[i]->loopStartFrame = 1000;
+			sources[i]->loopEndFrame = 1000 + 4800;
+			sources[i]->loopCrossfadeFrames = 256;
+		}
+		if (benchmark->kind == GRAPH_VIRTUAL || (benchmark->kind == GRAPH_VOICES && i >= REAL_VOICES)) {
+			sources[i]->isVirtual = MA_TRUE;
+		}
+	}
+
+	switch (benchmark->kind) {
+		case GRAPH_SOURCES:
+		case GRAPH_LOOPS:
+		case GRAPH_VIRTUAL:
+		case GRAPH_VOICES:
+			for (ma_uint32 i = 0; i < benchmark->n; i++) AudioNodeList_add(graph.destination, sources[i]);
+			break;
+		case GRAPH_GAIN_CHAIN:
+			for (ma_uint32 i = 0; i < benchmark->n; i++) {
+				gains[gainCount] = Graph_createGain(&graph, 0.999f);
+				AudioNodeList_add(gains[gainCount]->inputs, i == 0 ? sources[0] : gains[gainCount - 1]->node);
+				gainCount++;
+			}
+			AudioNodeList_add(graph.destination, gains[gainCount - 1]->node);
+			break;
+		case GRAPH_GAIN_FAN:
+			for (ma_uint32 i = 0; i < benchmark->n; i++) {
+				gains[gainCount] = Graph_createGain(&graph, 0.5f);
+				AudioNodeList_add(gains[gainCount]->inputs, sources[i]);
+				AudioNodeList_add(graph.destination, gains[gainCount]->node);
+				gainCount++;
+			}
+			break;
+	}
+
+	float* output = (float*)malloc(length * CHANNELS * sizeof(float));
+
+	// warm up caches and page in buffers
+	Graph_render(&graph, (ma_uint32)length, output);
+
+	ma_uint64 iterations = 0;
+	double wallStart = nowSeconds(CLOCK_MONOTONIC);
+	double cpuStart = nowSeconds(CLOCK_PROCESS_CPUTIME_ID);
+	double wallElapsed;
+	do {
+		Graph_render(&graph, (ma_uint32)length, output);
+		iterations++;
+		wallElapsed = nowSeconds(CLOCK_MONOTONIC) - wallStart;
+	} while (wallElapsed < minTime);
+	double cpuElapsed = nowSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart;
+
+	double wallNs = wallElapsed * 1e9 / (double)iterations;
+	double cpuNs = cpuElapsed * 1e9 / (double)iterations;
+	double framesPerSecond = (double)(length * iterations) / cpuElapsed;
+	// how many times faster than realtime one second of audio is mixed
+	double realtimeFactor = 1e9 / cpuNs;
+
+	char name[64];
+	if (benchmark->quantum != 0) {
+		snprintf(name, sizeof(name), "%s/%u/quantum:%u", benchmark->name, benchmark->n, quantum);
+	} else {
+		snprintf(name, sizeof(name), "%s/%u", benchmark->name, benchmark->n);
+	}
+	if (json) {
+		printf(
+			"    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.0f, \"cpu_time\": %.0f, \"time_unit\": \"ns\", \"items_per_second\": %.0f, \"realtime_factor\": %.1f, \"render_quantum\": %u}%s\n",
+			name, (unsigned long long)iterations, wallNs, cpuNs, framesPerSecond, realtimeFactor, quantum, last ? "" : ","
+		);
+	} else {
+		printf("%-36s %12.0f ns %12.0f ns %10llu frames_per_second=%.4gM realtime_factor=%.1f\n", name, wallNs, cpuNs, (unsigned long long)iterations, framesPerSecond * 1e-6, realtimeFactor);
+	}
+
+	for (ma_uint32 i = 0; i < gainCount; i++) Graph_destroyGain(gains[i]);
+	for (ma_uint32 i = 0; i < benchmark->n; i++) if (sources[i] != NULL) AudioNode_destroy(sources[i]);
+	free(gains);
+	free(sources);
+	free(output);
+	free(sine);
+	Graph_uninit(&graph);
+}
+
+int main(int argc, char** argv) {
+	ma_bool32 json = MA_FALSE;
+	double minTime = 0.5;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) json = MA_TRUE;
+		if (strncmp(argv[i], "--min-time=", 11) == 0) minTime = atof(argv[i] + 11);
+	}
+
+	const Benchmark benchmarks[] = {
+		{ "BM_MixSources", GRAPH_SOURCES, 1 },
+		{ "BM_MixSources", GRAPH_SOURCES, 8 },
+		{ "BM_MixSources", GRAPH_SOURCES, 64 },
+		{ "BM_MixGainChain", GRAPH_GAIN_CHAIN, 1 },
+		{ "BM_MixGainChain", GRAPH_GAIN_CHAIN, 8 },
+		{ "BM_MixGainFan", GRAPH_GAIN_FAN, 8 },
+		{ "BM_MixGainFan", GRAPH_GAIN_FAN, 64 },
+		{ "BM_MixLoopCrossfade", GRAPH_LOOPS, 8 },
+		{ "BM_MixVirtual", GRAPH_VIRTUAL, 64 },
+		// compare with BM_MixSources/64: the extra 1936 virtual voices should cost little next to the 64 real ones
+		{ "BM_MixVoices", GRAPH_VOICES, 2000 },
+		// per-quantum overhead (locking, command and schedule checks, graph walk) against the mixing work itself
+		{ "BM_MixSources", GRAPH_SOURCES, 64, 64 },
+		{ "BM_MixSources", GRAPH_SOURCES, 64, 128 },
+		{ "BM_MixSources", GRAPH_SOURCES, 64, 256 },
+		{ "BM_MixSources", GRAPH_SOURCES, 64, 512 },
+		{ "BM_MixGainFan", GRAPH_GAIN_FAN, 64, 64 },
+		{ "BM_MixGainFan", GRAPH_GAIN_FAN, 64, 128 },
+		{ "BM_MixGainFan", GRAPH_GAIN_FAN, 64, 256 },
+		{ "BM_MixGainFan", GRAPH_GAIN_FAN, 64, 512 },
+	};
+	const size_t benchmarkCount = graph_countof(benchmarks);
+
+	if (json) {
+		printf("{\n  \"context\": {\"sample_rate\": %d, \"channels\": %d, \"default_render_quantum\": %d},\n  \"benchmarks\": [\n", SAMPLE_RATE, CHANNELS, DEFAULT_QUANTUM);
+	} else {
+		printf("%-36s %15s %15s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+		printf("----------------------------------------------------------------------------------------\n");
+	}
+
+	for (size_t i = 0; i < benchmarkCount; i++) {
+		runBenchmark(&benchmarks[i], minTime, json, i == benchmarkCount - 1);
+	}
+
+	if (json) {
+		printf("  ]\n}\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * Offline driver for Audio_mixSources, shared by the tests and benchmarks
+ *
+ * Renders a node list in render quanta exactly as the device data callback in AudioContext.hx does, without a device.
+ * Gain nodes are built the same way as PcmTransformNode + GainNode: a node with a readFramesCallback that mixes its own input list and then applies the gain
+ */
+
+#ifndef AUDIO_NATIVE_TEST_GRAPH_H
+#define AUDIO_NATIVE_TEST_GRAPH_H
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../native.h"
+
+// miniaudio only defines its helper macros with the implementation
+#define graph_countof(x) (sizeof(x) / sizeof(x[0]))
+#define graph_min(x, y) (((x) < (y)) ? (x) : (y))
+
+typedef struct {
+	ma_context context;
+	AudioNodeList* destination;
+	ma_uint32 channelCount;
+	ma_uint32 renderQuantumSize;
+	ma_int64 frameBlock;
+} Graph;
+
+typedef struct {
+	AudioNode* node;
+	AudioNodeList* inputs;
+	float gain;
+} GainNode;
+
+static void Graph_init(Graph* graph, ma_uint32 channelCount, ma_uint32 renderQuantumSize) {
+	// the null backend has no device io, miniaudio is only used for its mutexes
+	ma_backend backends[] = { ma_backend_null };
+	if (ma_context_init(backends, 1, NULL, &graph->context) != MA_SUCCESS) {
+		fprintf(stderr, "Failed to initialize miniaudio context with the null backend\n");
+		exit(1);
+	}
+	graph->destination = AudioNodeList_create(&graph->context);
+	graph->channelCount = channelCount;
+	graph->renderQuantumSize = renderQuantumSize;
+	graph->frameBlock = 0;
+}
+
+static void Graph_uninit(Graph* graph) {
+	AudioNodeList_destroy(graph->destination);
+	ma_context_uninit(&graph->context);
+}
+
+/**
+ * Mix `frameCount` frames of the destination list into `pOutput`, which is cleared first as miniaudio does for the device callback
+ */
+static void Graph_render(Graph* graph, ma_uint32 frameCount, float* pOutput) {
+	memset(pOutput, 0, frameCount * graph->channelCount * sizeof(float));
+	ma_uint32 framesRemaining = frameCount;
+	while (framesRemaining > 0) {
+		ma_uint32 framesToRead = graph_min(framesRemaining, graph->renderQuantumSize);
+		float* quantumOutput = pOutput + (frameCount - framesRemaining) * graph->channelCount;
+		Audio_mixSources(graph->destination, graph->channelCount, framesToRead, graph->frameBlock, quantumOutput);
+		framesRemaining -= framesToRead;
+		graph->frameBlock += framesToRead;
+	}
+}
+
+/**
+ * Source node playing interleaved `pcmFrames`, active and unscheduled
+ */
+static AudioNode* Graph_createSource(Graph* graph, const float* pcmFrames, ma_uint64 pcmFrameCount) {
+	AudioNode* node = AudioNode_create(&graph->context);
+	node->pcmFrames = pcmFrames;
+	node->pcmFrameCount = pcmFrameCount;
+	node->pcmChannels = graph->channelCount;
+	node->active = MA_TRUE;
+	return node;
+}
+
+static ma_uint64 GainNode_readFrames(void* userData, ma_uint32 nChannels, ma_uint64 frameCount, ma_int64 schedulingCurrentFrameBlock, float* buffer) {
+	GainNode* gainNode = (GainNode*)userData;
+	ma_uint32 framesRead = Audio_mixSources(gainNode->inputs, nChannels, (ma_uint32)frameCount, schedulingCurrentFrameBlock, buffer);
+	ma_uint32 sampleCount = framesRead * nChannels;
+	for (ma_uint32 i = 0; i < sampleCount; i++) {
+		buffer[i] *= gainNode->gain;
+	}
+	return framesRead;
+}
+
+static GainNode* Graph_createGain(Graph* graph, float gain) {
+	GainNode* gainNode = (GainNode*)malloc(sizeof(*gainNode));
+	gainNode->node = AudioNode_create(&graph->context);
+	gainNode->inputs = AudioNodeList_create(&graph->context);
+	gainNode->gain = gain;
+	gainNode->node->readFramesCallback = GainNode_readFrames;
+	gainNode->node->userData = gainNode;
+	gainNode->node->active = MA_TRUE;
+	return gainNode;
+}
+
+static void Graph_destroyGain(GainNode* gainNode) {
+	AudioNodeList_destroy(gainNode->inputs);
+	AudioNode_destroy(gainNode->node);
+	free(gainNode);
+}
+
+/**
+ * Interleaved sine with the same phase on every channel
+ */
+static float* Graph_createSine(ma_uint32 channelCount, ma_uint64 frameCount, double frequency, double sampleRate) {
+	float* frames = (float*)malloc(frameCount * channelCount * sizeof(float));
+	for (ma_uint64 i = 0; i < frameCount; i++) {
+		float value = (float)sin(2.0 * 3.14159265358979323846 * frequency * (double)i / sampleRate);
+		for (ma_uint32 c = 0; c < channelCount; c++) {
+			frames[i * channelCount + c] = value;
+		}
+	}
+	return frames;
+}
+
+#endif
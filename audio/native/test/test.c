@@ -0,0 +1,702 @@
+/**
+ * Sample-exact tests for Audio_mixSources on synthetic graphs
+ *
+ * Each test builds a graph with the offline driver in graph.h, renders it in render quanta and compares every output sample with the expected value.
+ * Expected values are computed with the same float operations as the mixer so comparisons are exact
+ */
+
+#include "./graph.h"
+
+static int testCount = 0;
+static int failureCount = 0;
+
+#define CHECK(condition, ...) do { \
+	testCount++; \
+	if (!(condition)) { \
+		failureCount++; \
+		printf("  FAIL %s:%d: ", __FILE__, __LINE__); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+	} \
+} while (0)
+
+/**
+ * Returns the index of the first sample that differs, or -1 when all `sampleCount` samples are equal
+ */
+static long firstMismatch(const float* output, const float* expected, ma_uint64 sampleCount) {
+	for (ma_uint64 i = 0; i < sampleCount; i++) {
+		if (output[i] != expected[i]) return (long)i;
+	}
+	return -1;
+}
+
+#define CHECK_SAMPLES(output, expected, sampleCount) do { \
+	long mismatch = firstMismatch(output, expected, sampleCount); \
+	CHECK(mismatch == -1, "sample %ld is %.9g, expected %.9g", mismatch, mismatch == -1 ? 0.0 : (output)[mismatch], mismatch == -1 ? 0.0 : (expected)[mismatch]); \
+} while (0)
+
+/**
+ * Buffer where each frame's value is its index, so the output shows which frame was played
+ */
+static float* createRamp(ma_uint32 channelCount, ma_uint64 frameCount) {
+	float* frames = (float*)malloc(frameCount * channelCount * sizeof(float));
+	for (ma_uint64 i = 0; i < frameCount; i++) {
+		for (ma_uint32 c = 0; c < channelCount; c++) {
+			frames[i * channelCount + c] = (float)i + (float)c * 0.5f;
+		}
+	}
+	return frames;
+}
+
+static void testSine(void) {
+	printf("sine source\n");
+	const ma_uint32 channels = 2;
+	const ma_uint64 length = 1000;
+
+	Graph graph;
+	Graph_init(&graph, channels, 128);
+	float* sine = Graph_createSine(channels, length, 440, 48000);
+	AudioNode* source = Graph_createSource(&graph, sine, length);
+	AudioNodeList_add(graph.destination, source);
+
+	// render past the end of the buffer with a partial final quantum
+	const ma_uint32 frameCount = 1100;
+	float* output = (float*)malloc(frameCount * channels * sizeof(float));
+	float* expected = (float*)calloc(frameCount * channels, sizeof(float));
+	memcpy(expected, sine, length * channels * sizeof(float));
+
+	Graph_render(&graph, frameCount, output);
+	CHECK_SAMPLES(output, expected, frameCount * channels);
+	CHECK(source->onReachEndFlag == MA_TRUE, "end of a non-looping source sets onReachEndFlag");
+
+	AudioNode_destroy(source);
+	free(output);
+	free(expected);
+	free(sine);
+	Graph_uninit(&graph);
+}
+
+static void testSourcesSum(void) {
+	printf("sources are summed\n");
+	const ma_uint32 channels = 1;
+	const ma_uint64 length = 512;
+
+	Graph graph;
+	Graph_init(&graph, channels, 128);
+	float* a = Graph_createSine(channels, length, 440, 48000);
+	float* b = Graph_createSine(channels, length, 1000, 48000);
+	AudioNode* sourceA = Graph_createSource(&graph, a, length);
+	AudioNode* sourceB = Graph_createSource(&graph, b, length);
+	AudioNodeList_add(graph.destination, sourceA);
+	AudioNodeList_add(graph.destination, sourceB);
+
+	float output[512];
+	float expected[512];
+	for (ma_uint32 i = 0; i < length; i++) {
+		expected[i] = 0.0f;
+		expected[i] += a[i];
+		expected[i] += b[i];
+	}
+	Graph_render(&graph, length, output);
+	CHECK_SAMPLES(output, expected, length);
+
+	AudioNode_destroy(sourceA);
+	AudioNode_destroy(sourceB);
+	free(a);
+	free(b);
+	Graph_uninit(&graph);
+}
+
+static void testGainChain(void) {
+	printf("gain chains\n");
+	const ma_uint32 channels = 2;
+	const ma_uint64 length = 700;
+
+	Graph graph;
+	Graph_init(&graph, channels, 128);
+	float* sine = Graph_createSine(channels, length, 440, 48000);
+
+	// source -> gain(0.5) -> gain(0.25) -> gain(3) -> destination
+	AudioNode* source = Graph_createSource(&graph, sine, length);
+	GainNode* gains[3] = { Graph_createGain(&graph, 0.5f), Graph_createGain(&graph, 0.25f), Graph_createGain(&graph, 3.0f) };
+	AudioNodeList_add(gains[0]->inputs, source);
+	AudioNodeList_add(gains[1]->inputs, gains[0]->node);
+	AudioNodeList_add(gains[2]->inputs, gains[1]->node);
+	AudioNodeList_add(graph.destination, gains[2]->node);
+
+	float* output = (float*)malloc(length * channels * sizeof(float));
+	float* expected = (float*)malloc(length * channels * sizeof(float));
+	for (ma_uint64 i = 0; i < length * channels; i++) {
+		float value = sine[i];
+		value *= 0.5f;
+		value *= 0.25f;
+		value *= 3.0f;
+		expected[i] = value;
+	}
+	Graph_render(&graph, length, output);
+	CHECK_SAMPLES(output, expected, length * channels);
+
+	// a gain with two inputs applies to their sum
+	Graph_destroyGain(gains[0]);
+	Graph_destroyGain(gains[1]);
+	Graph_destroyGain(gains[2]);
+	AudioNode_destroy(source);
+	Graph_uninit(&graph);
+
+	Graph_init(&graph, channels, 128);
+	float* ramp = createRamp(channels, length);
+	AudioNode* sourceA = Graph_createSource(&graph, sine, length);
+	AudioNode* sourceB = Graph_createSource(&graph, ramp, length);
+	GainNode* gain = Graph_createGain(&graph, 0.125f);
+	AudioNodeList_add(gain->inputs, sourceA);
+	AudioNodeList_add(gain->inputs, sourceB);
+	AudioNodeList_add(graph.destination, gain->node);
+	for (ma_uint64 i = 0; i < length * channels; i++) {
+		float value = 0.0f;
+		value += sine[i];
+		value += ramp[i];
+		expected[i] = value * 0.125f;
+	}
+	Graph_render(&graph, length, output);
+	CHECK_SAMPLES(output, expected, length * channels);
+
+	Graph_destroyGain(gain);
+	AudioNode_destroy(sourceA);
+	AudioNode_destroy(sourceB);
+	free(ramp);
+	free(output);
+	free(expected);
+	free(sine);
+	Graph_uninit(&graph);
+}
+
+static void testScheduling(void) {
+	printf("scheduled start and stop\n");
+	const ma_uint32 channels = 1;
+	const ma_uint32 quantum = 128;
+	const ma_uint64 length = 2048;
+
+	struct { ma_int64 start; ma_int64 stop; } cases[] = {
+		{ 200, 500 },   // both within quanta
+		{ 256, 384 },   // both on quantum boundaries
+		{ 127, 129 },   // straddling a boundary by one frame
+		{ 0, 1 },       // a single frame
+		{ 300, 300 },   // stop at start, nothing plays
+		{ 600, 400 },   // stop before start, nothing plays
+		{ 1000, -1 },   // no stop, plays to the end of the render
+	};
+
+	float* ramp = createRamp(channels, length);
+	const ma_uint32 frameCount = 1200;
+	float output[1200];
+	float expected[1200];
+
+	for (size_t k = 0; k < graph_countof(cases); k++) {
+		Graph graph;
+		Graph_init(&graph, channels, quantum);
+		AudioNode* source = Graph_createSource(&graph, ramp, length);
+		source->scheduledStartFrame = cases[k].start;
+		source->scheduledStopFrame = cases[k].stop;
+		AudioNodeList_add(graph.destination, source);
+
+		for (ma_int64 i = 0; i < frameCount; i++) {
+			ma_bool32 playing = i >= cases[k].start && (cases[k].stop == -1 || i < cases[k].stop);
+			expected[i] = playing ? ramp[i - cases[k].start] : 0.0f;
+		}
+		Graph_render(&graph, frameCount, output);
+		long mismatch = firstMismatch(output, expected, frameCount);
+		CHECK(mismatch == -1, "start %lld stop %lld: sample %ld is %g, expected %g", (long long)cases[k].start, (long long)cases[k].stop, mismatch, mismatch == -1 ? 0.0 : output[mismatch], mismatch == -1 ? 0.0 : expected[mismatch]);
+		if (cases[k].stop != -1) {
+			CHECK(source->onReachEndFlag == MA_TRUE, "start %lld stop %lld: reaching the stop frame sets onReachEndFlag", (long long)cases[k].start, (long long)cases[k].stop);
+		}
+
+		AudioNode_destroy(source);
+		Graph_uninit(&graph);
+	}
+
+	// held sources are silent until they're scheduled
+	Graph graph;
+	Graph_init(&graph, channels, quantum);
+	AudioNode* source = Graph_createSource(&graph, ramp, length);
+	source->scheduledStartFrame = AUDIO_NODE_FRAME_HELD;
+	AudioNodeList_add(graph.destination, source);
+	for (ma_uint32 i = 0; i < frameCount; i++) expected[i] = 0.0f;
+	Graph_render(&graph, frameCount, output);
+	CHECK_SAMPLES(output, expected, frameCount);
+	CHECK(source->pcmFrameIndex == 0, "held source playhead does not move");
+
+	AudioNode_destroy(source);
+	Graph_uninit(&graph);
+	free(ramp);
+}
+
+/**
+ * Per-frame model of AudioNode_readPcmFrames
+ */
+static void referenceLoop(const float* frames, ma_uint64 frameCount, ma_uint64 loopStart, ma_uint64 loopEnd, ma_uint64 crossfade, float* expected, ma_uint32 outputFrameCount) {
+	ma_uint64 fadeStart = loopEnd - crossfade;
+	ma_uint64 index = 0;
+	(void)frameCount;
+	for (ma_uint32 i = 0; i < outputFrameCount; i++) {
+		if (index >= loopEnd) index = loopStart + crossfade;
+		if (index < fadeStart) {
+			expected[i] = frames[index];
+		} else {
+			ma_uint64 fadeFrame = index - fadeStart;
+			float t = (float)fadeFrame / (float)crossfade;
+			expected[i] = frames[index] * (1.0f - t) + frames[loopStart + fadeFrame] * t;
+		}
+		index++;
+	}
+}
+
+static void testLoops(void) {
+	printf("loops\n");
+	const ma_uint32 channels = 1;
+	const ma_uint64 length = 100;
+	const ma_uint32 frameCount = 1000;
+	float* ramp = createRamp(channels, length);
+	float output[1000];
+	float expected[1000];
+
+	struct { ma_uint64 loopStart; ma_uint64 loopEnd; ma_uint32 crossfade; } cases[] = {
+		{ 0, 0, 0 },     // whole buffer
+		{ 10, 50, 0 },   // loop region
+		{ 10, 50, 8 },   // loop region with a crossfade
+		{ 0, 100, 16 },  // whole buffer with a crossfade
+		{ 90, 0, 0 },    // loop start with the default loop end
+		{ 40, 44, 100 }, // crossfade longer than the loop is limited to half the loop
+		{ 3, 4, 0 },     // one frame loop
+	};
+
+	for (size_t k = 0; k < graph_countof(cases); k++) {
+		Graph graph;
+		Graph_init(&graph, channels, 128);
+		AudioNode* source = Graph_createSource(&graph, ramp, length);
+		source->loop = MA_TRUE;
+		source->loopStartFrame = cases[k].loopStart;
+		source->loopEndFrame = cases[k].loopEnd;
+		source->loopCrossfadeFrames = cases[k].crossfade;
+		AudioNodeList_add(graph.destination, source);
+
+		ma_uint64 loopEnd = cases[k].loopEnd != 0 ? cases[k].loopEnd : length;
+		ma_uint64 crossfade = graph_min(cases[k].crossfade, (loopEnd - cases[k].loopStart) / 2);
+		referenceLoop(ramp, length, cases[k].loopStart, loopEnd, crossfade, expected, frameCount);
+
+		Graph_render(&graph, frameCount, output);
+		long mismatch = firstMismatch(output, expected, frameCount);
+		CHECK(mismatch == -1, "loop [%llu, %llu) crossfade %u: sample %ld is %g, expected %g", (unsigned long long)cases[k].loopStart, (unsigned long long)cases[k].loopEnd, cases[k].crossfade, mismatch, mismatch == -1 ? 0.0 : output[mismatch], mismatch == -1 ? 0.0 : expected[mismatch]);
+		CHECK(source->onReachEndFlag == MA_FALSE, "loop [%llu, %llu): looping source never reaches its end", (unsigned long long)cases[k].loopStart, (unsigned long long)cases[k].loopEnd);
+
+		AudioNode_destroy(source);
+		Graph_uninit(&graph);
+	}
+
+	// a virtual looping source advances exactly as an audible one without being mixed
+	Graph graph;
+	Graph_init(&graph, channels, 128);
+	AudioNode* audible = Graph_createSource(&graph, ramp, length);
+	AudioNode* virtualSource = Graph_createSource(&graph, ramp, length);
+	audible->loop = virtualSource->loop = MA_TRUE;
+	audible->loopStartFrame = virtualSource->loopStartFrame = 10;
+	audible->loopEndFrame = virtualSource->loopEndFrame = 50;
+	audible->loopCrossfadeFrames = virtualSource->loopCrossfadeFrames = 8;
+	virtualSource->isVirtual = MA_TRUE;
+	AudioNodeList_add(graph.destination, virtualSource);
+	AudioNodeList_add(graph.destination, audible);
+	referenceLoop(ramp, length, 10, 50, 8, expected, 777);
+	Graph_render(&graph, 777, output);
+	CHECK_SAMPLES(output, expected, 777);
+	CHECK(virtualSource->pcmFrameIndex == audible->pcmFrameIndex, "virtual playhead %llu matches audible playhead %llu", (unsigned long long)virtualSource->pcmFrameIndex, (unsigned long long)audible->pcmFrameIndex);
+
+	AudioNode_destroy(audible);
+	AudioNode_destroy(virtualSource);
+	Graph_uninit(&graph);
+	free(ramp);
+}
+
+static void testCycles(void) {
+	printf("cycles and shared nodes\n");
+	const ma_uint32 channels = 1;
+	const ma_uint64 length = 600;
+	float* ramp = createRamp(channels, length);
+	float output[600];
+	float expected[600];
+
+	// source -> a -> b -> a: b is read within a, a is skipped within b because it's already been read in this quantum
+	Graph graph;
+	Graph_init(&graph, channels, 128);
+	AudioNode* source = Graph_createSource(&graph, ramp, length);
+	GainNode* a = Graph_createGain(&graph, 0.5f);
+	GainNode* b = Graph_createGain(&graph, 0.25f);
+	AudioNodeList_add(a->inputs, source);
+	AudioNodeList_add(a->inputs, b->node);
+	AudioNodeList_add(b->inputs, a->node);
+	AudioNodeList_add(graph.destination, a->node);
+	for (ma_uint64 i = 0; i < length; i++) expected[i] = ramp[i] * 0.5f;
+	Graph_render(&graph, length, output);
+	CHECK_SAMPLES(output, expected, length);
+	CHECK(a->node->_lastReadFrameBlock == graph.frameBlock - (ma_int64)(length % 128 == 0 ? 128 : length % 128), "cycle node marked with the last quantum");
+
+	Graph_destroyGain(a);
+	Graph_destroyGain(b);
+	AudioNode_destroy(source);
+	Graph_uninit(&graph);
+
+	// a node that is its own input
+	Graph_init(&graph, channels, 128);
+	source = Graph_createSource(&graph, ramp, length);
+	a = Graph_createGain(&graph, 2.0f);
+	AudioNodeList_add(a->inputs, a->node);
+	AudioNodeList_add(a->inputs, source);
+	AudioNodeList_add(graph.destination, a->node);
+	for (ma_uint64 i = 0; i < length; i++) expected[i] = ramp[i] * 2.0f;
+	Graph_render(&graph, length, output);
+	CHECK_SAMPLES(output, expected, length);
+
+	Graph_destroyGain(a);
+	AudioNode_destroy(source);
+	Graph_uninit(&graph);
+
+	// a node is read at most once per render quantum, so a source shared by two gains is only heard through the first
+	Graph_init(&graph, channels, 128);
+	source = Graph_createSource(&graph, ramp, length);
+	a = Graph_createGain(&graph, 0.5f);
+	b = Graph_createGain(&graph, 0.25f);
+	AudioNodeList_add(a->inputs, source);
+	AudioNodeList_add(b->inputs, source);
+	AudioNodeList_add(graph.destination, a->node);
+	AudioNodeList_add(graph.destination, b->node);
+	for (ma_uint64 i = 0; i < length; i++) expected[i] = ramp[i] * 0.5f;
+	Graph_render(&graph, length, output);
+	CHECK_SAMPLES(output, expected, length);
+	CHECK(source->pcmFrameIndex == length, "shared source playhead advanced once per frame, at %llu", (unsigned long long)source->pcmFrameIndex);
+
+	Graph_destroyGain(a);
+	Graph_destroyGain(b);
+	AudioNode_destroy(source);
+	Graph_uninit(&graph);
+	free(ramp);
+}
+
+/**
+ * Renders a deep chain of gains twice from the same initial state, nested mixes each use their own scratch buffer so the results must be identical
+ */
+static void testDeterminism(void) {
+	printf("nested graphs are deterministic\n");
+	const ma_uint32 channels = 2;
+	const ma_uint64 length = 4096;
+	const ma_uint32 depth = 16;
+	float* sine = Graph_createSine(channels, length, 440, 48000);
+	float* outputs[2];
+	float* expected = (float*)malloc(length * channels * sizeof(float));
+
+	for (ma_uint64 i = 0; i < length * channels; i++) {
+		float value = sine[i];
+		for (ma_uint32 d = 0; d < depth; d++) value *= 0.9f;
+		expected[i] = value;
+	}
+
+	for (int run = 0; run < 2; run++) {
+		Graph graph;
+		// a quantum larger than the scratch buffer splits each mix into several chunks
+		Graph_init(&graph, channels, AUDIO_MIX_BUFFER_SAMPLE_COUNT);
+		AudioNode* source = Graph_createSource(&graph, sine, length);
+		GainNode* chain[16];
+		for (ma_uint32 d = 0; d < depth; d++) {
+			chain[d] = Graph_createGain(&graph, 0.9f);
+			AudioNodeList_add(chain[d]->inputs, d == 0 ? source : chain[d - 1]->node);
+		}
+		AudioNodeList_add(graph.destination, chain[depth - 1]->node);
+
+		outputs[run] = (float*)malloc(length * channels * sizeof(float));
+		Graph_render(&graph, length, outputs[run]);
+
+		for (ma_uint32 d = 0; d < depth; d++) Graph_destroyGain(chain[d]);
+		AudioNode_destroy(source);
+		Graph_uninit(&graph);
+	}
+
+	CHECK_SAMPLES(outputs[0], expected, length * channels);
+	CHECK(memcmp(outputs[0], outputs[1], length * channels * sizeof(float)) == 0, "repeated renders are bit-identical");
+
+	free(outputs[0]);
+	free(outputs[1]);
+	free(expected);
+	free(sine);
+}
+
+/**
+ * Sources scheduled together with AudioNode_scheduleGroup start, seek and stop on exactly the requested frames, including frames within a render quantum
+ */
+static void testGroupAlignment(void) {
+	printf("group commands are frame-aligned\n");
+	const ma_uint32 channels = 1;
+	const ma_uint32 quantum = 128;
+	const ma_uint64 length = 4096;
+	const ma_uint32 sourceCount = 4;
+
+	Graph graph;
+	Graph_init(&graph, channels, quantum);
+	ma_mutex frameBlockLock;
+	ma_mutex_init(&graph.context, &frameBlockLock);
+
+	// each stem is the ramp scaled by a different integer so a source that is off by a frame changes the sum
+	float* stems[4];
+	AudioNode* sources[4];
+	for (ma_uint32 k = 0; k < sourceCount; k++) {
+		stems[k] = createRamp(channels, length);
+		for (ma_uint64 i = 0; i < length; i++) stems[k][i] *= (float)(k + 1);
+		sources[k] = Graph_createSource(&graph, stems[k], length);
+		sources[k]->scheduledStartFrame = AUDIO_NODE_FRAME_HELD;
+		AudioNodeList_add(graph.destination, sources[k]);
+	}
+	const float scale = 1 + 2 + 3 + 4;
+
+	// start at frame 200 from 10 frames into the buffers, as SourceGroup.start does
+	ma_int64 shift = AudioNode_scheduleGroup(sources, sourceCount, 200, -1, 200, 10, -1, &frameBlockLock, &graph.frameBlock, quantum);
+	CHECK(shift == 0, "start is not shifted, shifted by %lld", (long long)shift);
+
+	const ma_uint32 firstFrameCount = 640;
+	float output[2048];
+	float expected[2048];
+	for (ma_uint32 i = 0; i < firstFrameCount; i++) {
+		expected[i] = i < 200 ? 0.0f : (float)(10 + i - 200) * scale;
+	}
+	Graph_render(&graph, firstFrameCount, output);
+	CHECK_SAMPLES(output, expected, firstFrameCount);
+
+	// seek to frame 50 at frame 900 and stop at frame 1100, both part way through a quantum
+	shift = AudioNode_scheduleGroup(sources, sourceCount, -1, -1, 900, 50, -1, &frameBlockLock, &graph.frameBlock, quantum);
+	CHECK(shift == 0, "seek is not shifted, shifted by %lld", (long long)shift);
+	shift = AudioNode_scheduleGroup(sources, sourceCount, -1, 1100, -1, -1, -1, &frameBlockLock, &graph.frameBlock, quantum);
+	CHECK(shift == 0, "stop is not shifted, shifted by %lld", (long long)shift);
+
+	const ma_uint32 secondFrameCount = 640;
+	for (ma_uint32 j = 0; j < secondFrameCount; j++) {
+		ma_uint32 frame = firstFrameCount + j;
+		if (frame < 900) {
+			expected[j] = (float)(10 + frame - 200) * scale;
+		} else if (frame < 1100) {
+			expected[j] = (float)(50 + frame - 900) * scale;
+		} else {
+			expected[j] = 0.0f;
+		}
+	}
+	Graph_render(&graph, secondFrameCount, output);
+	CHECK_SAMPLES(output, expected, secondFrameCount);
+	for (ma_uint32 k = 0; k < sourceCount; k++) {
+		CHECK(sources[k]->pcmFrameIndex == 250, "source %u stopped at buffer frame %llu, expected 250", k, (unsigned long long)sources[k]->pcmFrameIndex);
+		CHECK(sources[k]->scheduledCommandCount == 0, "source %u applied its command", k);
+	}
+
+	// a command within the quantum after the one being mixed is shifted to the following quantum, with the same shift for every frame
+	ma_int64 frameBlock = graph.frameBlock;
+	shift = AudioNode_scheduleGroup(sources, sourceCount, frameBlock + 10, frameBlock + 300, frameBlock + 10, 0, -1, &frameBlockLock, &graph.frameBlock, quantum);
+	CHECK(shift == quantum - 10, "early start shifted by %lld, expected %u", (long long)shift, quantum - 10);
+	for (ma_uint32 k = 0; k < sourceCount; k++) {
+		CHECK(sources[k]->scheduledStartFrame == frameBlock + quantum && sources[k]->scheduledStopFrame == frameBlock + 300 + shift, "source %u keeps the requested duration", k);
+	}
+
+	for (ma_uint32 k = 0; k < sourceCount; k++) {
+		AudioNode_destroy(sources[k]);
+		free(stems[k]);
+	}
+	ma_mutex_uninit(&frameBlockLock);
+	Graph_uninit(&graph);
+}
+
+/**
+ * Seeks and loop changes within a quantum apply on their frame, frames before it are read from the previous playhead
+ */
+static void testCommandWithinQuantum(void) {
+	printf("commands apply within a render quantum\n");
+	const ma_uint32 channels = 2;
+	const ma_uint64 length = 1000;
+	float* ramp = createRamp(channels, length);
+	float output[512 * 2];
+	float expected[512 * 2];
+
+	ma_int64 commandFrames[] = { 0, 1, 63, 127, 128, 129, 300, 511 };
+	for (size_t k = 0; k < graph_countof(commandFrames); k++) {
+		Graph graph;
+		Graph_init(&graph, channels, 128);
+		AudioNode* source = Graph_createSource(&graph, ramp, length);
+		AudioNode_queueCommand(source, commandFrames[k], 400, -1);
+		AudioNodeList_add(graph.destination, source);
+
+		for (ma_int64 i = 0; i < 512; i++) {
+			ma_int64 bufferFrame = i < commandFrames[k] ? i : 400 + (i - commandFrames[k]);
+			for (ma_uint32 c = 0; c < channels; c++) expected[i * channels + c] = ramp[bufferFrame * channels + c];
+		}
+		Graph_render(&graph, 512, output);
+		long mismatch = firstMismatch(output, expected, 512 * channels);
+		CHECK(mismatch == -1, "seek at frame %lld: sample %ld is %g, expected %g", (long long)commandFrames[k], mismatch, mismatch == -1 ? 0.0 : output[mismatch], mismatch == -1 ? 0.0 : expected[mismatch]);
+
+		AudioNode_destroy(source);
+		Graph_uninit(&graph);
+	}
+
+	// enabling a loop at frame 300 of a 250 frame loop region wraps on the next pass through its end
+	Graph graph;
+	Graph_init(&graph, channels, 128);
+	AudioNode* source = Graph_createSource(&graph, ramp, length);
+	source->loopEndFrame = 250;
+	AudioNode_queueCommand(source, 300, 200, 1);
+	AudioNodeList_add(graph.destination, source);
+	for (ma_int64 i = 0; i < 512; i++) {
+		ma_int64 bufferFrame = i < 300 ? i : 200 + (i - 300) % 50;
+		if (i >= 350) bufferFrame = (i - 350) % 250;
+		for (ma_uint32 c = 0; c < channels; c++) expected[i * channels + c] = ramp[bufferFrame * channels + c];
+	}
+	Graph_render(&graph, 512, output);
+	CHECK_SAMPLES(output, expected, 512 * channels);
+
+	AudioNode_destroy(source);
+	Graph_uninit(&graph);
+	free(ramp);
+}
+
+/**
+ * Commands scheduled before earlier ones have applied are queued rather than replacing them, as with SourceGroup.start() followed by setLoop() or seek() followed by setLoop()
+ */
+static void testQueuedCommands(void) {
+	printf("queued commands keep earlier commands\n");
+	const ma_uint32 channels = 1;
+	const ma_uint32 quantum = 128;
+	const ma_uint64 length = 1000;
+	float* ramp = createRamp(channels, length);
+	float output[1024];
+	float expected[1024];
+
+	Graph graph;
+	Graph_init(&graph, channels, quantum);
+	ma_mutex frameBlockLock;
+	ma_mutex_init(&graph.context, &frameBlockLock);
+	AudioNode* source = Graph_createSource(&graph, ramp, length);
+	source->scheduledStartFrame = AUDIO_NODE_FRAME_HELD;
+	source->loopEndFrame = 300;
+	AudioNodeList_add(graph.destination, source);
+
+	// start at frame 200 from 10 frames in, then loop from frame 0, which is shifted to the next quantum and applies before the start
+	AudioNode_scheduleGroup(&source, 1, 200, -1, 200, 10, -1, &frameBlockLock, &graph.frameBlock, quantum);
+	AudioNode_scheduleGroup(&source, 1, -1, -1, 0, -1, 1, &frameBlockLock, &graph.frameBlock, quantum);
+	CHECK(source->scheduledCommandCount == 2, "both commands are queued, %u queued", source->scheduledCommandCount);
+
+	// the start offset is kept, and the loop wraps at frame 300 of the buffer
+	for (ma_uint32 i = 0; i < 1024; i++) {
+		expected[i] = i < 200 ? 0.0f : (float)((10 + i - 200) % 300);
+	}
+	Graph_render(&graph, 1024, output);
+	CHECK_SAMPLES(output, expected, 1024);
+
+	// seek at frame 1200 then stop looping at frame 1300, both before either applies
+	AudioNode_scheduleGroup(&source, 1, -1, -1, 1200, 100, -1, &frameBlockLock, &graph.frameBlock, quantum);
+	AudioNode_scheduleGroup(&source, 1, -1, -1, 1300, -1, 0, &frameBlockLock, &graph.frameBlock, quantum);
+	for (ma_uint32 j = 0; j < 1024; j++) {
+		ma_uint32 frame = 1024 + j;
+		if (frame < 1200) {
+			expected[j] = (float)((10 + frame - 200) % 300);
+		} else {
+			// plays on past the loop end once looping stops at frame 1300
+			expected[j] = (float)(100 + frame - 1200);
+		}
+	}
+	Graph_render(&graph, 1024, output);
+	CHECK_SAMPLES(output, expected, 1024);
+	CHECK(source->loop == MA_FALSE && source->scheduledCommandCount == 0, "the loop change after the seek applied");
+
+	// commands in any order apply in frame order, and a full queue merges its last two commands
+	AudioNode_destroy(source);
+	source = Graph_createSource(&graph, ramp, length);
+	for (ma_int64 k = AUDIO_NODE_MAX_SCHEDULED_COMMANDS; k > 0; k--) {
+		AudioNode_queueCommand(source, k * 10, k, -1);
+	}
+	CHECK(source->scheduledCommands[0].frame == 10 && source->scheduledCommands[AUDIO_NODE_MAX_SCHEDULED_COMMANDS - 1].frame == AUDIO_NODE_MAX_SCHEDULED_COMMANDS * 10, "commands are ordered by frame");
+	AudioNode_queueCommand(source, 5, -1, 1);
+	CHECK(source->scheduledCommandCount == AUDIO_NODE_MAX_SCHEDULED_COMMANDS && source->scheduledCommands[0].frame == 5, "a full queue still takes an earlier command");
+	AudioNodeCommand last = source->scheduledCommands[AUDIO_NODE_MAX_SCHEDULED_COMMANDS - 1];
+	CHECK(last.frame == (AUDIO_NODE_MAX_SCHEDULED_COMMANDS - 1) * 10 && last.frameIndex == AUDIO_NODE_MAX_SCHEDULED_COMMANDS, "the last two commands merged at the earlier frame with the later values");
+
+	AudioNode_destroy(source);
+	ma_mutex_uninit(&frameBlockLock);
+	Graph_uninit(&graph);
+	free(ramp);
+}
+
+/**
+ * First frame of a CBR MPEG-1 layer III stream holding an Info header with every optional field, followed by a LAME extension when `encoder` is not NULL
+ */
+static size_t createInfoFrame(ma_uint8* frame, size_t frameSize, const char* encoder, ma_uint32 encoderDelay, ma_uint32 encoderPadding) {
+	memset(frame, 0, frameSize);
+	// sync, MPEG-1, layer III, no CRC, stereo
+	frame[0] = 0xFF;
+	frame[1] = 0xFB;
+	frame[2] = 0x90;
+	frame[3] = 0x00;
+	// the Info tag follows 32 bytes of side information
+	ma_uint8* tag = frame + 4 + 32;
+	memcpy(tag, "Info", 4);
+	tag[7] = 0x0F;
+	ma_uint8* lameTag = tag + 8 + 4 + 4 + 100 + 4;
+	if (encoder == NULL) {
+		// bytes another encoder might leave after the Xing/Info fields
+		memset(lameTag, 0xAB, 36);
+	} else {
+		memcpy(lameTag, encoder, strlen(encoder));
+		lameTag[21] = (ma_uint8)(encoderDelay >> 4);
+		lameTag[22] = (ma_uint8)(((encoderDelay & 0xF) << 4) | (encoderPadding >> 8));
+		lameTag[23] = (ma_uint8)(encoderPadding & 0xFF);
+	}
+	return (size_t)(lameTag - frame) + 36;
+}
+
+static void testMp3GaplessTrim(void) {
+	printf("mp3 gapless trim\n");
+	ma_uint8 frame[417];
+	ma_uint32 leading, trailing;
+	const ma_uint32 decoderDelay = 528 + 1;
+
+	const char* encoders[] = { "LAME3.100", "Lavf58.29", "Lavc58.54" };
+	for (size_t i = 0; i < graph_countof(encoders); i++) {
+		size_t size = createInfoFrame(frame, sizeof(frame), encoders[i], 576, 1000);
+		ma_bool32 found = Audio_getMp3GaplessTrim(frame, size, &leading, &trailing);
+		CHECK(found == MA_TRUE, "%s: Info header found", encoders[i]);
+		CHECK(leading == 1152 + 576 + decoderDelay, "%s: leading frames %u", encoders[i], leading);
+		CHECK(trailing == 1000 - decoderDelay, "%s: trailing frames %u", encoders[i], trailing);
+	}
+
+	// without an encoder signature only the Info frame itself is trimmed
+	size_t size = createInfoFrame(frame, sizeof(frame), NULL, 0, 0);
+	ma_bool32 found = Audio_getMp3GaplessTrim(frame, size, &leading, &trailing);
+	CHECK(found == MA_TRUE, "unknown encoder: Info header found");
+	CHECK(leading == 1152, "unknown encoder: leading frames %u, expected only the Info frame", leading);
+	CHECK(trailing == 0, "unknown encoder: trailing frames %u, expected none", trailing);
+
+	// truncated before the end of the LAME extension
+	size = createInfoFrame(frame, sizeof(frame), "LAME3.100", 576, 1000);
+	found = Audio_getMp3GaplessTrim(frame, size - 14, &leading, &trailing);
+	CHECK(found == MA_TRUE && leading == 1152 && trailing == 0, "truncated LAME extension is ignored");
+
+	// no Xing/Info header
+	memset(frame + 4 + 32, 0, 4);
+	found = Audio_getMp3GaplessTrim(frame, size, &leading, &trailing);
+	CHECK(found == MA_FALSE && leading == 0 && trailing == 0, "frames without an Info header are not trimmed");
+}
+
+int main(void) {
+	testSine();
+	testSourcesSum();
+	testGainChain();
+	testScheduling();
+	testLoops();
+	testCycles();
+	testDeterminism();
+	testGroupAlignment();
+	testCommandWithinQuantum();
+	testQueuedCommands();
+	testMp3GaplessTrim();
+
+	printf("%d checks, %d failed\n", testCount, failureCount);
+	return failureCount == 0 ? 0 : 1;
+}
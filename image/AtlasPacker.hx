@@ -0,0 +1,146 @@
+package image;
+
+/**
+    Skyline bottom-left rectangle packer
+
+    Used by `TextureAtlas` at runtime and by `@:packAtlas` AssetPack metadata at compile-time
+**/
+class AtlasPacker {
+
+    /**
+        Pack rectangles into as few `pageWidth` x `pageHeight` pages as possible, with `padding` pixels between rectangles.
+        Returns placements in the same order as `sizes`
+        @throws String if a rectangle is larger than a page
+    **/
+    static public function pack(sizes: Array<{ width: Int, height: Int }>, pageWidth: Int, pageHeight: Int, padding: Int = 0): Array<AtlasRect> {
+        // taller rectangles first leaves a flatter skyline for the rest
+        var order = [for (i in 0...sizes.length) i];
+        order.sort((a, b) -> {
+            var dh = sizes[b].height - sizes[a].height;
+            return dh != 0 ? dh : sizes[b].width - sizes[a].width;
+        });
+
+        var pages = new Array<Array<SkylineSegment>>();
+        var rects = new Array<AtlasRect>();
+        rects.resize(sizes.length);
+
+        for (index in order) {
+            var size = sizes[index];
+            if (size.width > pageWidth || size.height > pageHeight) {
+                throw 'Rectangle ${size.width}x${size.height} does not fit in a ${pageWidth}x${pageHeight} atlas page';
+            }
+            // padding is not needed past the page edge
+            var width = imin(size.width + padding, pageWidth);
+            var height = imin(size.height + padding, pageHeight);
+
+            var placed = false;
+            for (page in 0...pages.length) {
+                var position = findPosition(pages[page], width, height, pageWidth, pageHeight);
+                if (position != -1) {
+                    rects[index] = place(pages[page], position, width, height, pageWidth, page, size);
+                    placed = true;
+                    break;
+                }
+            }
+
+            if (!placed) {
+                var skyline: Array<SkylineSegment> = [{ x: 0, y: 0, width: pageWidth }];
+                pages.push(skyline);
+                rects[index] = place(skyline, 0, width, height, pageWidth, pages.length - 1, size);
+            }
+        }
+
+        return rects;
+    }
+
+    /**
+        Returns the skyline segment index to place the rectangle's left edge at, or -1 if it doesn't fit.
+        The lowest top edge wins, ties go to the leftmost position
+    **/
+    static function findPosition(skyline: Array<SkylineSegment>, width: Int, height: Int, pageWidth: Int, pageHeight: Int): Int {
+        var bestIndex = -1;
+        var bestTop = pageHeight + 1;
+        for (i in 0...skyline.length) {
+            var y = fitY(skyline, i, width, pageWidth);
+            if (y == -1) continue;
+            var top = y + height;
+            if (top <= pageHeight && top < bestTop) {
+                bestTop = top;
+                bestIndex = i;
+            }
+        }
+        return bestIndex;
+    }
+
+    /**
+        Lowest y a rectangle of `width` can rest at with its left edge at segment `index`, or -1 if it runs off the page
+    **/
+    static function fitY(skyline: Array<SkylineSegment>, index: Int, width: Int, pageWidth: Int): Int {
+        var x = skyline[index].x;
+        if (x + width > pageWidth) return -1;
+        var y = 0;
+        var remaining = width;
+        var i = index;
+        while (remaining > 0) {
+            var segment = skyline[i];
+            y = imax(y, segment.y);
+            remaining -= segment.width;
+            i++;
+        }
+        return y;
+    }
+
+    static function place(skyline: Array<SkylineSegment>, index: Int, width: Int, height: Int, pageWidth: Int, page: Int, size: { width: Int, height: Int }): AtlasRect {
+        var x = skyline[index].x;
+        var y = fitY(skyline, index, width, pageWidth);
+
+        skyline.insert(index, { x: x, y: y + height, width: width });
+
+        // trim or remove the segments now covered by the new one
+        var right = x + width;
+        var i = index + 1;
+        while (i < skyline.length) {
+            var segment = skyline[i];
+            if (segment.x >= right) break;
+            var overlap = right - segment.x;
+            if (overlap >= segment.width) {
+                skyline.splice(i, 1);
+            } else {
+                segment.x += overlap;
+                segment.width -= overlap;
+                break;
+            }
+        }
+
+        // merge neighbours at the same height
+        i = 0;
+        while (i < skyline.length - 1) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.splice(i + 1, 1);
+            } else {
+                i++;
+            }
+        }
+
+        return { page: page, x: x, y: y, width: size.width, height: size.height };
+    }
+
+    static inline function imin(a: Int, b: Int) return a < b ? a : b;
+    static inline function imax(a: Int, b: Int) return a > b ? a : b;
+
+}
+
+typedef AtlasRect = {
+    final page: Int;
+    final x: Int;
+    final y: Int;
+    final width: Int;
+    final height: Int;
+}
+
+private typedef SkylineSegment = {
+    var x: Int;
+    var y: Int;
+    var width: Int;
+}
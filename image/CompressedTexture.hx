@@ -0,0 +1,524 @@
+package image;
+
+import typedarray.ArrayBuffer;
+import typedarray.Uint8Array;
+import webgl.GLContext;
+#if basis_universal
+import image.native.BasisTranscoder;
+import image.native.DecodePool;
+#end
+
+/**
+    Block-compressed texture data from a KTX, KTX2 or DDS container
+
+    Mip levels are views into the container's buffer so pixel data is never copied. On native targets `mapFile()` maps the container directly from disk.
+    The GL internal format must be enabled with the matching extension, for example `gl.getExtension(WEBGL_compressed_texture_s3tc)`, before calling `upload()`
+
+    Basis Universal (ETC1S and UASTC) KTX2 files are transcoded on native targets with `transcode()`
+**/
+class CompressedTexture {
+
+    public final internalFormat: Int;
+    public final width: Int;
+    public final height: Int;
+
+    /**
+        1, or 6 for cube maps with faces in the order +X, -X, +Y, -Y, +Z, -Z
+    **/
+    public final faceCount: Int;
+
+    /**
+        Level 0 first
+    **/
+    public final levels: Array<CompressedTextureLevel>;
+
+    #if !js
+    var mappedFile: cpp.Star<cpp.Void> = null;
+    var mappedByteLength: Int = 0;
+    #end
+
+    function new(internalFormat: Int, width: Int, height: Int, faceCount: Int, levels: Array<CompressedTextureLevel>) {
+        this.internalFormat = internalFormat;
+        this.width = width;
+        this.height = height;
+        this.faceCount = faceCount;
+        this.levels = levels;
+    }
+
+    /**
+        Upload every mip level with `compressedTexImage2D` to the texture bound to `target`, or `texImage2D` for textures transcoded to `RGBA32`. Cube maps are uploaded to each face of the texture bound to `TEXTURE_CUBE_MAP`
+    **/
+    public function upload(gl: GLContext, ?target: TextureTarget) {
+        if (target == null) target = TEXTURE_2D;
+        for (i in 0...levels.length) {
+            var level = levels[i];
+            for (face in 0...faceCount) {
+                var faceTarget: TextureTarget = faceCount == 6 ? cast ((TEXTURE_CUBE_MAP_POSITIVE_X: GLenum) + face) : target;
+                if (internalFormat == RGBA) {
+                    gl.texImage2D(faceTarget, i, cast RGBA, level.width, level.height, 0, cast RGBA, UNSIGNED_BYTE, level.faces[face]);
+                } else {
+                    gl.compressedTexImage2D(faceTarget, i, cast internalFormat, level.width, level.height, 0, level.faces[face]);
+                }
+            }
+        }
+    }
+
+    /**
+        Parse a KTX, KTX2 or DDS container; levels reference `buffer` without copying
+        @throws String if the container is not recognized or holds data that isn't block-compressed
+    **/
+    static public function parse(buffer: ArrayBuffer): CompressedTexture {
+        var bytes: haxe.io.Bytes = buffer;
+        if (hasIdentifier(bytes, KTX_IDENTIFIER)) {
+            return parseKtx(buffer, bytes);
+        }
+        if (hasIdentifier(bytes, KTX2_IDENTIFIER)) {
+            return parseKtx2(buffer, bytes);
+        }
+        if (bytes.length >= 4 && bytes.getInt32(0) == DDS_MAGIC) {
+            return parseDds(buffer, bytes);
+        }
+        throw 'Unrecognized compressed texture container, expected KTX, KTX2 or DDS';
+    }
+
+    #if !js
+    /**
+        Map a KTX, KTX2 or DDS file into memory and parse it; the file is read by the OS as levels are uploaded.
+        The mapping is read-only and is released when this object is garbage collected or `release()` is called
+        @throws String
+    **/
+    static public function mapFile(path: String): CompressedTexture {
+        var byteLength: cpp.Int32 = 0;
+        var data = image.native.NativeImage.mapFile(path, cpp.Native.addressOf(byteLength));
+        if (data == null) {
+            throw 'Failed to map file "$path"';
+        }
+
+        var texture = try parse(ArrayBuffer.fromCPointer(cast data, byteLength)) catch (e: Any) {
+            image.native.NativeImage.unmapFile(data, byteLength);
+            throw e;
+        }
+        texture.mappedFile = data;
+        texture.mappedByteLength = byteLength;
+        cpp.vm.Gc.setFinalizer(texture, cpp.Function.fromStaticFunction(finalizer));
+        return texture;
+    }
+
+    /**
+        Unmap the file, after this the level views must not be used
+    **/
+    public function release() {
+        if (mappedFile != null) {
+            image.native.NativeImage.unmapFile(mappedFile, mappedByteLength);
+            mappedFile = null;
+        }
+    }
+
+    static function finalizer(instance: CompressedTexture) {
+        instance.release();
+    }
+    #end
+
+    /**
+        Choose the format to transcode a Basis file into given the extension names from `gl.getSupportedExtensions()`.
+        UASTC prefers formats it transcodes to with the least loss (ASTC then BC7), ETC1S prefers the formats it transcodes to fastest (ETC then BC1/BC3)
+    **/
+    static public function selectTranscodeTarget(supportedExtensions: Array<String>, isUastc: Bool, hasAlpha: Bool): TranscodeTarget {
+        inline function has(name: String) return supportedExtensions.indexOf(name) != -1;
+        var astc = has('WEBGL_compressed_texture_astc');
+        var bptc = has('EXT_texture_compression_bptc') || has('ARB_texture_compression_bptc');
+        var s3tc = has('WEBGL_compressed_texture_s3tc');
+        var etc2 = has('WEBGL_compressed_texture_etc');
+        var etc1 = has('WEBGL_compressed_texture_etc1');
+
+        return if (isUastc) {
+            if (astc) ASTC_4x4_RGBA;
+            else if (bptc) BC7_RGBA;
+            else if (etc2) hasAlpha ? ETC2_RGBA : ETC1_RGB;
+            else if (s3tc) hasAlpha ? BC3_RGBA : BC1_RGB;
+            else if (etc1 && !hasAlpha) ETC1_RGB;
+            else RGBA32;
+        } else if (hasAlpha) {
+            if (etc2) ETC2_RGBA;
+            else if (bptc) BC7_RGBA;
+            else if (s3tc) BC3_RGBA;
+            else if (astc) ASTC_4x4_RGBA;
+            else RGBA32;
+        } else {
+            if (etc1 || etc2) ETC1_RGB;
+            else if (s3tc) BC1_RGB;
+            else if (bptc) BC7_RGBA;
+            else if (astc) ASTC_4x4_RGBA;
+            else RGBA32;
+        }
+    }
+
+    static function transcodeTargetInternalFormat(target: TranscodeTarget, supportedExtensions: Array<String>): Int {
+        return switch target {
+            // ETC1 data is valid ETC2, so it's uploaded as ETC2 where ETC1 isn't supported directly
+            case ETC1_RGB: supportedExtensions.indexOf('WEBGL_compressed_texture_etc1') != -1 ? COMPRESSED_RGB_ETC1_WEBGL : COMPRESSED_RGB8_ETC2;
+            case ETC2_RGBA: COMPRESSED_RGBA8_ETC2_EAC;
+            case BC1_RGB: COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case BC3_RGBA: COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case BC7_RGBA: COMPRESSED_RGBA_BPTC_UNORM_EXT;
+            case ASTC_4x4_RGBA: COMPRESSED_RGBA_ASTC_4x4_KHR;
+            case RGBA32: RGBA;
+        }
+    }
+
+    #if basis_universal
+    /**
+        **Asynchronously** transcode a Basis Universal (ETC1S or UASTC) KTX2 file on the decode worker pool into the best format supported by `gl`, see `selectTranscodeTarget()`
+
+        Requires `-D basis_universal=<path to basis_universal>`
+    **/
+    static public function transcode(buffer: ArrayBuffer, gl: GLContext, ?successCallback: CompressedTexture -> Void, ?errorCallback: String -> Void) {
+        // GL calls must be made on the main thread
+        var supportedExtensions = gl.getSupportedExtensions();
+
+        DecodePool.run(() -> {
+            var texture: Null<CompressedTexture> = null;
+            var error: Null<String> = null;
+            try {
+                texture = transcodeKtx2(buffer, supportedExtensions);
+            } catch (e: Any) {
+                error = Std.string(e);
+            }
+
+            if (error != null) {
+                if (errorCallback != null) {
+                    haxe.EntryPoint.runInMainThread(() -> errorCallback(error));
+                }
+            } else if (successCallback != null) {
+                haxe.EntryPoint.runInMainThread(() -> successCallback(texture));
+            }
+        });
+    }
+
+    static function transcodeKtx2(buffer: ArrayBuffer, supportedExtensions: Array<String>): CompressedTexture {
+        var ktx2 = BasisTranscoder.open(buffer.toCPointer(), buffer.byteLength);
+        if (ktx2 == null) {
+            throw 'Unsupported KTX2 file: expected Basis ETC1S or UASTC';
+        }
+
+        try {
+            var width: cpp.Int32 = 0, height: cpp.Int32 = 0, levelCount: cpp.Int32 = 0, faceCount: cpp.Int32 = 0, isUastc: cpp.Int32 = 0, hasAlpha: cpp.Int32 = 0;
+            BasisTranscoder.info(ktx2, cpp.Native.addressOf(width), cpp.Native.addressOf(height), cpp.Native.addressOf(levelCount), cpp.Native.addressOf(faceCount), cpp.Native.addressOf(isUastc), cpp.Native.addressOf(hasAlpha));
+
+            var target = selectTranscodeTarget(supportedExtensions, isUastc != 0, hasAlpha != 0);
+
+            var levels = new Array<CompressedTextureLevel>();
+            for (i in 0...imax(levelCount, 1)) {
+                var levelWidth: cpp.Int32 = 0, levelHeight: cpp.Int32 = 0;
+                var byteLength = BasisTranscoder.levelByteLength(ktx2, i, target, cpp.Native.addressOf(levelWidth), cpp.Native.addressOf(levelHeight));
+                if (byteLength < 0) throw 'Invalid KTX2 file: missing level $i';
+
+                var faces = new Array<Uint8Array>();
+                for (face in 0...faceCount) {
+                    var data = new ArrayBuffer(byteLength);
+                    if (BasisTranscoder.transcodeLevel(ktx2, i, face, target, data.toCPointer(), byteLength) == 0) {
+                        throw 'Failed to transcode KTX2 level $i';
+                    }
+                    faces.push(new Uint8Array(data));
+                }
+                levels.push({ width: levelWidth, height: levelHeight, faces: faces });
+            }
+
+            BasisTranscoder.close(ktx2);
+            return new CompressedTexture(transcodeTargetInternalFormat(target, supportedExtensions), width, height, faceCount, levels);
+        } catch (e: Any) {
+            BasisTranscoder.close(ktx2);
+            throw e;
+        }
+    }
+    #end
+
+    static function parseKtx(buffer: ArrayBuffer, bytes: haxe.io.Bytes): CompressedTexture {
+        if (bytes.length < 64) throw 'Invalid KTX file: truncated header';
+        if (bytes.getInt32(12) != 0x04030201) throw 'Unsupported KTX file: big-endian';
+
+        var glType = bytes.getInt32(16);
+        var glFormat = bytes.getInt32(24);
+        var glInternalFormat = bytes.getInt32(28);
+        var width = bytes.getInt32(36);
+        var height = bytes.getInt32(40);
+        var depth = bytes.getInt32(44);
+        var arrayElements = bytes.getInt32(48);
+        var faceCount = bytes.getInt32(52);
+        var levelCount = imax(bytes.getInt32(56), 1);
+        var keyValueByteLength = bytes.getInt32(60);
+
+        if (glType != 0 || glFormat != 0) throw 'Unsupported KTX file: not block-compressed';
+        if (depth > 1 || arrayElements > 0) throw 'Unsupported KTX file: array and 3D textures are not supported';
+        if (faceCount != 1 && faceCount != 6) throw 'Invalid KTX file: $faceCount faces';
+
+        var levels = new Array<CompressedTextureLevel>();
+        var offset = 64 + keyValueByteLength;
+        for (i in 0...levelCount) {
+            var levelWidth = imax(width >> i, 1);
+            var levelHeight = imax(height >> i, 1);
+            checkRange(bytes, offset, 4, 'KTX');
+            // for non-array cube maps imageSize is the size of one face
+            var imageSize = bytes.getInt32(offset);
+            offset += 4;
+            var faces = new Array<Uint8Array>();
+            for (_ in 0...faceCount) {
+                checkRange(bytes, offset, imageSize, 'KTX');
+                faces.push(new Uint8Array(buffer, offset, imageSize));
+                offset = align4(offset + imageSize);
+            }
+            levels.push({ width: levelWidth, height: levelHeight, faces: faces });
+        }
+
+        return new CompressedTexture(glInternalFormat, width, height, faceCount, levels);
+    }
+
+    static function parseKtx2(buffer: ArrayBuffer, bytes: haxe.io.Bytes): CompressedTexture {
+        if (bytes.length < 80) throw 'Invalid KTX2 file: truncated header';
+
+        var vkFormat = bytes.getInt32(12);
+        var width = bytes.getInt32(20);
+        var height = bytes.getInt32(24);
+        var depth = bytes.getInt32(28);
+        var layerCount = bytes.getInt32(32);
+        var faceCount = bytes.getInt32(36);
+        var levelCount = imax(bytes.getInt32(40), 1);
+        var supercompressionScheme = bytes.getInt32(44);
+
+        if (supercompressionScheme != 0) throw 'Unsupported KTX2 file: supercompression scheme $supercompressionScheme, Basis files must be transcoded with CompressedTexture.transcode()';
+        if (depth > 1 || layerCount > 1) throw 'Unsupported KTX2 file: array and 3D textures are not supported';
+        if (faceCount != 1 && faceCount != 6) throw 'Invalid KTX2 file: $faceCount faces';
+
+        var internalFormat = vkFormatToGL(vkFormat);
+        if (internalFormat == -1) {
+            throw vkFormat == 0 ? 'Unsupported KTX2 file: UASTC must be transcoded with CompressedTexture.transcode()' : 'Unsupported KTX2 file: vkFormat $vkFormat is not block-compressed';
+        }
+
+        var levels = new Array<CompressedTextureLevel>();
+        for (i in 0...levelCount) {
+            var index = 80 + i * 24;
+            checkRange(bytes, index, 24, 'KTX2');
+            var byteOffset = getUInt64AsInt(bytes, index);
+            var byteLength = getUInt64AsInt(bytes, index + 8);
+            checkRange(bytes, byteOffset, byteLength, 'KTX2');
+            var faceByteLength = Std.int(byteLength / faceCount);
+            levels.push({
+                width: imax(width >> i, 1),
+                height: imax(height >> i, 1),
+                faces: [for (face in 0...faceCount) new Uint8Array(buffer, byteOffset + face * faceByteLength, faceByteLength)],
+            });
+        }
+
+        return new CompressedTexture(internalFormat, width, height, faceCount, levels);
+    }
+
+    static function parseDds(buffer: ArrayBuffer, bytes: haxe.io.Bytes): CompressedTexture {
+        if (bytes.length < 128) throw 'Invalid DDS file: truncated header';
+
+        var flags = bytes.getInt32(8);
+        var height = bytes.getInt32(12);
+        var width = bytes.getInt32(16);
+        // dwMipMapCount is only valid when DDSD_MIPMAPCOUNT is set, some writers leave garbage in it otherwise
+        var levelCount = flags & DDSD_MIPMAPCOUNT != 0 ? imax(bytes.getInt32(28), 1) : 1;
+        var pixelFormatFlags = bytes.getInt32(80);
+        var fourCC = bytes.getInt32(84);
+        var caps2 = bytes.getInt32(112);
+
+        if (pixelFormatFlags & DDPF_FOURCC == 0) throw 'Unsupported DDS file: not block-compressed';
+
+        var dataOffset = 128;
+        var faceCount = caps2 & DDSCAPS2_CUBEMAP != 0 ? 6 : 1;
+        var internalFormat = -1;
+        if (fourCC == FOURCC_DXT1) {
+            internalFormat = pixelFormatFlags & DDPF_ALPHAPIXELS != 0 ? COMPRESSED_RGBA_S3TC_DXT1_EXT : COMPRESSED_RGB_S3TC_DXT1_EXT;
+        } else if (fourCC == FOURCC_DXT3) {
+            internalFormat = COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        } else if (fourCC == FOURCC_DXT5) {
+            internalFormat = COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        } else if (fourCC == FOURCC_ATI1 || fourCC == FOURCC_BC4U) {
+            internalFormat = COMPRESSED_RED_RGTC1_EXT;
+        } else if (fourCC == FOURCC_ATI2 || fourCC == FOURCC_BC5U) {
+            internalFormat = COMPRESSED_RED_GREEN_RGTC2_EXT;
+        } else if (fourCC == FOURCC_DX10) {
+            if (bytes.length < 148) throw 'Invalid DDS file: truncated DX10 header';
+            dataOffset = 148;
+            if (bytes.getInt32(136) & DDS_RESOURCE_MISC_TEXTURECUBE != 0) faceCount = 6;
+            if (bytes.getInt32(140) > 1 && faceCount == 1) throw 'Unsupported DDS file: array textures are not supported';
+            internalFormat = dxgiFormatToGL(bytes.getInt32(128));
+        }
+
+        if (internalFormat == -1) throw 'Unsupported DDS file: unknown compressed format';
+
+        // BC1 and BC4 use 8 byte blocks, the other BC formats 16
+        var blockByteLength = (
+            internalFormat == COMPRESSED_RGB_S3TC_DXT1_EXT ||
+            internalFormat == COMPRESSED_RGBA_S3TC_DXT1_EXT ||
+            internalFormat == COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT ||
+            internalFormat == COMPRESSED_RED_RGTC1_EXT ||
+            internalFormat == COMPRESSED_SIGNED_RED_RGTC1_EXT
+        ) ? 8 : 16;
+
+        // DDS stores each face's full mip chain in turn
+        var levels: Array<CompressedTextureLevel> = [for (i in 0...levelCount) { width: imax(width >> i, 1), height: imax(height >> i, 1), faces: new Array<Uint8Array>() }];
+        var offset = dataOffset;
+        for (_ in 0...faceCount) {
+            for (level in levels) {
+                var byteLength = imax((level.width + 3) >> 2, 1) * imax((level.height + 3) >> 2, 1) * blockByteLength;
+                checkRange(bytes, offset, byteLength, 'DDS');
+                level.faces.push(new Uint8Array(buffer, offset, byteLength));
+                offset += byteLength;
+            }
+        }
+
+        return new CompressedTexture(internalFormat, width, height, faceCount, levels);
+    }
+
+    static function vkFormatToGL(vkFormat: Int): Int {
+        return switch vkFormat {
+            case 131: COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case 132: COMPRESSED_SRGB_S3TC_DXT1_EXT;
+            case 133: COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case 134: COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 135: COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case 136: COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 137: COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case 138: COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 139: COMPRESSED_RED_RGTC1_EXT;
+            case 140: COMPRESSED_SIGNED_RED_RGTC1_EXT;
+            case 141: COMPRESSED_RED_GREEN_RGTC2_EXT;
+            case 142: COMPRESSED_SIGNED_RED_GREEN_RGTC2_EXT;
+            case 143: COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_EXT;
+            case 144: COMPRESSED_RGB_BPTC_SIGNED_FLOAT_EXT;
+            case 145: COMPRESSED_RGBA_BPTC_UNORM_EXT;
+            case 146: COMPRESSED_SRGB_ALPHA_BPTC_UNORM_EXT;
+            case 147: COMPRESSED_RGB8_ETC2;
+            case 148: COMPRESSED_SRGB8_ETC2;
+            case 149: COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 150: COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 151: COMPRESSED_RGBA8_ETC2_EAC;
+            case 152: COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+            case 153: COMPRESSED_R11_EAC;
+            case 154: COMPRESSED_SIGNED_R11_EAC;
+            case 155: COMPRESSED_RG11_EAC;
+            case 156: COMPRESSED_SIGNED_RG11_EAC;
+            // ASTC LDR block sizes alternate UNORM, SRGB from 4x4 to 12x12
+            case v if (v >= 157 && v <= 184):
+                ((v - 157) & 1 == 0 ? COMPRESSED_RGBA_ASTC_4x4_KHR : COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR) + ((v - 157) >> 1);
+            default: -1;
+        }
+    }
+
+    static function dxgiFormatToGL(dxgiFormat: Int): Int {
+        return switch dxgiFormat {
+            case 71: COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case 72: COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 74: COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case 75: COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 77: COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case 78: COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 80: COMPRESSED_RED_RGTC1_EXT;
+            case 81: COMPRESSED_SIGNED_RED_RGTC1_EXT;
+            case 83: COMPRESSED_RED_GREEN_RGTC2_EXT;
+            case 84: COMPRESSED_SIGNED_RED_GREEN_RGTC2_EXT;
+            case 95: COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_EXT;
+            case 96: COMPRESSED_RGB_BPTC_SIGNED_FLOAT_EXT;
+            case 98: COMPRESSED_RGBA_BPTC_UNORM_EXT;
+            case 99: COMPRESSED_SRGB_ALPHA_BPTC_UNORM_EXT;
+            default: -1;
+        }
+    }
+
+    static function hasIdentifier(bytes: haxe.io.Bytes, identifier: Array<Int>) {
+        if (bytes.length < identifier.length) return false;
+        for (i in 0...identifier.length) {
+            if (bytes.get(i) != identifier[i]) return false;
+        }
+        return true;
+    }
+
+    static function getUInt64AsInt(bytes: haxe.io.Bytes, offset: Int): Int {
+        if (bytes.getInt32(offset + 4) != 0 || bytes.getInt32(offset) < 0) throw 'Unsupported KTX2 file: offsets larger than 2GB';
+        return bytes.getInt32(offset);
+    }
+
+    static inline function checkRange(bytes: haxe.io.Bytes, offset: Int, length: Int, container: String) {
+        if (offset < 0 || length < 0 || offset + length > bytes.length) {
+            throw 'Invalid $container file: data out of range';
+        }
+    }
+
+    static inline function align4(v: Int) return (v + 3) & ~3;
+    static inline function imax(a: Int, b: Int) return a > b ? a : b;
+
+    static final KTX_IDENTIFIER = [0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A];
+    static final KTX2_IDENTIFIER = [0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A];
+
+    static inline final DDS_MAGIC = 0x20534444; // 'DDS '
+    static inline final DDSD_MIPMAPCOUNT = 0x20000;
+    static inline final DDPF_ALPHAPIXELS = 0x1;
+    static inline final DDPF_FOURCC = 0x4;
+    static inline final DDSCAPS2_CUBEMAP = 0x200;
+    static inline final DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+    static inline final FOURCC_DXT1 = 0x31545844;
+    static inline final FOURCC_DXT3 = 0x33545844;
+    static inline final FOURCC_DXT5 = 0x35545844;
+    static inline final FOURCC_ATI1 = 0x31495441;
+    static inline final FOURCC_ATI2 = 0x32495441;
+    static inline final FOURCC_BC4U = 0x55344342;
+    static inline final FOURCC_BC5U = 0x55354342;
+    static inline final FOURCC_DX10 = 0x30315844;
+
+    static inline final COMPRESSED_RGB_S3TC_DXT1_EXT = 0x83F0;
+    static inline final COMPRESSED_RGBA_S3TC_DXT1_EXT = 0x83F1;
+    static inline final COMPRESSED_RGBA_S3TC_DXT3_EXT = 0x83F2;
+    static inline final COMPRESSED_RGBA_S3TC_DXT5_EXT = 0x83F3;
+    static inline final COMPRESSED_SRGB_S3TC_DXT1_EXT = 0x8C4C;
+    static inline final COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT = 0x8C4D;
+    static inline final COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT = 0x8C4E;
+    static inline final COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT = 0x8C4F;
+    static inline final COMPRESSED_RED_RGTC1_EXT = 0x8DBB;
+    static inline final COMPRESSED_SIGNED_RED_RGTC1_EXT = 0x8DBC;
+    static inline final COMPRESSED_RED_GREEN_RGTC2_EXT = 0x8DBD;
+    static inline final COMPRESSED_SIGNED_RED_GREEN_RGTC2_EXT = 0x8DBE;
+    static inline final COMPRESSED_RGBA_BPTC_UNORM_EXT = 0x8E8C;
+    static inline final COMPRESSED_SRGB_ALPHA_BPTC_UNORM_EXT = 0x8E8D;
+    static inline final COMPRESSED_RGB_BPTC_SIGNED_FLOAT_EXT = 0x8E8E;
+    static inline final COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_EXT = 0x8E8F;
+    static inline final COMPRESSED_R11_EAC = 0x9270;
+    static inline final COMPRESSED_SIGNED_R11_EAC = 0x9271;
+    static inline final COMPRESSED_RG11_EAC = 0x9272;
+    static inline final COMPRESSED_SIGNED_RG11_EAC = 0x9273;
+    static inline final COMPRESSED_RGB8_ETC2 = 0x9274;
+    static inline final COMPRESSED_SRGB8_ETC2 = 0x9275;
+    static inline final COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9276;
+    static inline final COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9277;
+    static inline final COMPRESSED_RGBA8_ETC2_EAC = 0x9278;
+    static inline final COMPRESSED_SRGB8_ALPHA8_ETC2_EAC = 0x9279;
+    static inline final COMPRESSED_RGBA_ASTC_4x4_KHR = 0x93B0;
+    static inline final COMPRESSED_RGB_ETC1_WEBGL = 0x8D64;
+    static inline final RGBA = 0x1908;
+    static inline final COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR = 0x93D0;
+
+}
+
+typedef CompressedTextureLevel = {
+    final width: Int;
+    final height: Int;
+    /**
+        One view per face
+    **/
+    final faces: Array<Uint8Array>;
+}
+
+/**
+    Transcode target formats, values match `basist::transcoder_texture_format`
+**/
+enum abstract TranscodeTarget(Int) to Int {
+    var ETC1_RGB = 0;
+    var ETC2_RGBA = 1;
+    var BC1_RGB = 2;
+    var BC3_RGBA = 3;
+    var BC7_RGBA = 6;
+    var ASTC_4x4_RGBA = 10;
+    var RGBA32 = 13;
+}
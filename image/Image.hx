@@ -7,11 +7,33 @@ import js.html.URL;
 import typedarray.ArrayBuffer;
 
 /**
-    HTMLImageElement extended to add `decodeImageData()`
+    HTMLImageElement extended to add `decodeImageData()` and `decodeImageFile()`
 **/
 @:forward
 abstract Image(js.html.Image) from js.html.Image to js.html.Image {
 
+    /**
+        Always null on js, use `generateMipmap()`
+    **/
+    public var mipmaps(get, never): Null<Array<MipmapLevel>>;
+
+    inline function get_mipmaps(): Null<Array<MipmapLevel>> {
+        return null;
+    }
+
+    /**
+        Ignored on js, images loaded from `src` are decoded by the browser
+    **/
+    public var internalFormatHint(get, set): Null<InternalFormatHint>;
+
+    inline function get_internalFormatHint(): Null<InternalFormatHint> {
+        return null;
+    }
+
+    inline function set_internalFormatHint(v: Null<InternalFormatHint>) {
+        return v;
+    }
+
     /**
         **Asynchronously** decode an arraybuffer with the contents of a supported image file format
         `internalFormatHint` is used for native targets and is ignored for js
@@ -47,12 +69,52 @@ abstract Image(js.html.Image) from js.html.Image to js.html.Image {
         image.src = objectUrl;
     }
 
+    /**
+        **Asynchronously** load and decode an image from a url
+        `internalFormatHint` is used for native targets and is ignored for js
+    **/
+    static public function decodeImageFile(path: String, ?successCallback: Image -> Void, ?errorCallback: String -> Void, ?internalFormatHint: InternalFormatHint): ImageDecodeTask {
+        var image = new js.html.Image();
+        var task: ImageDecodeTask = null;
+
+        function onError(e: Any) {
+            if (errorCallback != null && !task.cancelled) {
+                errorCallback('Failed to load image "$path"');
+            }
+            image.removeEventListener('error', onError);
+        }
+
+        function onLoad(e: Any) {
+            if (successCallback != null && !task.cancelled) {
+                successCallback(image);
+            }
+            image.removeEventListener('load', onLoad);
+        }
+
+        task = new ImageDecodeTask(() -> {
+            image.removeEventListener('error', onError);
+            image.removeEventListener('load', onLoad);
+            image.src = '';
+        });
+
+        image.addEventListener('error', onError, true);
+        image.addEventListener('load', onLoad, true);
+
+        image.decoding = 'async';
+
+        image.src = path;
+
+        return task;
+    }
+
 }
 
 #else
 
 import cpp.*;
 import typedarray.ArrayBuffer;
+import image.native.DecodePool;
+import image.native.NativeImage;
 import image.native.StbImage;
 
 /**
@@ -60,6 +122,7 @@ import image.native.StbImage;
     Pixel data is always tightly packed; in OpenGL terms the packing alignment is 1
     Uses stb_image.h
 **/
+@:allow(image.ImageCache)
 class Image {
 
     public var width: Int;
@@ -67,20 +130,85 @@ class Image {
     public var naturalWidth(default, null): Int = -1;
     public var naturalHeight(default, null): Int = -1;
 
-    // @! todo: we need events before we can enable loading from a `src` path
-    // public var src(default, set): String;
+    /**
+        Setting `src` loads and decodes an image from the app bundle asynchronously, then calls `onload` or `onerror`.
+        Images loaded from the same path with the same `internalFormatHint` share decoded pixel data through `ImageCache`
+    **/
+    public var src(default, set): String = '';
+
+    /**
+        False while an image is loading from `src`
+    **/
+    public var complete(default, null): Bool = true;
+
+    public var onload: Null<() -> Void> = null;
+    public var onerror: Null<String -> Void> = null;
+
+    /**
+        Format to decode images loaded from `src` into, see `decodeImageData()`
+    **/
+    public var internalFormatHint: Null<InternalFormatHint> = null;
+
+    /**
+        Maximum bytes of converted pixel data each image keeps in addition to the pixel data decoded from the source file.
+        When exceeded, the least recently used conversions are freed
+    **/
+    static public var convertedPixelDataBudget: Int = 32 * 1024 * 1024;
+
+    /**
+        Initial value of `releaseSourceFileAfterDecode` for new images
+    **/
+    static public var defaultReleaseSourceFileAfterDecode: Bool = false;
+
+    /**
+        Initial value of `releasePixelDataAfterUpload` for new images
+    **/
+    static public var defaultReleasePixelDataAfterUpload: Bool = false;
+
+    /**
+        Free the source file bytes once `decodeImageData` has decoded the image into the hinted format.
+        Formats that cannot be converted from the cached pixel data are then unavailable
+    **/
+    public var releaseSourceFileAfterDecode: Bool = defaultReleaseSourceFileAfterDecode;
+
+    /**
+        Free all cached pixel data after the image has been uploaded with `texImage2DImageSource` or `texSubImage2DImageSource`.
+        Later uploads decode the source file again, so this is best combined with keeping the source file
+    **/
+    public var releasePixelDataAfterUpload: Bool = defaultReleasePixelDataAfterUpload;
 
     // internal image data
-    var sourceFileBytes: Null<ArrayBuffer> = null;
+    var sourceFileBytes(default, set): Null<ArrayBuffer> = null;
+    // images decoded with `decodeImageFile()` read their file through stbi callbacks rather than keeping its bytes
+    var sourceFilePath: Null<String> = null;
+    // set while `decodeImageFile()` owns a cancellable reader for this image
+    var sourceFileReader: Star<NativeImageFileReader> = null;
+
+    // source file properties, set when the file is first decoded
+    var nChannelsInFile: Int = -1;
+    var isHdrFile: Bool = false;
+    var isIphonePng: Bool = false;
+    // integer factor the source file is downscaled by when decoded, see `InternalFormatHint.downscale`
+    var decodeDownscale: Int = 1;
+    // size of decoded pixel data, naturalWidth and naturalHeight remain the file's size
+    var decodedWidth(get, never): Int;
+    var decodedHeight(get, never): Int;
+
+    // least recently used first
+    final pixelDataCache = new Array<CachedPixelData>();
+    var convertedPixelDataBytes: Int = 0;
+
+    /**
+        Mipmap levels 1 and above, created by `generateMipmaps()` or `InternalFormatHint.mipmaps`; level 0 is the image itself.
+        Levels are not flipped, upload them with `texImage2D` using the same format and type as the image
+    **/
+    public var mipmaps(default, null): Null<Array<MipmapLevel>> = null;
+    var mipmapCPointers = new Array<Star<cpp.Void>>();
 
-    var cachedPixelData(default, set): Null<{
-        final pixelsCPointer: Star<cpp.Void>;
-        final pixels: ArrayBuffer;
-        final nChannels: Int;
-        final dataType: PixelDataType;
-        final flipY: Bool;
-        final forceUnpremultiply: Bool;
-    }> = null;
+    // set for images loaded from `src`, pixel data is owned by the shared image in ImageCache
+    var cacheOwner: Null<Image> = null;
+    // incremented when `src` changes so that loads of earlier values are ignored
+    var srcLoadId: Int = 0;
 
     public function new(width: Int = 0, height: Int = 0) {
         this.width = width;
@@ -91,46 +219,213 @@ class Image {
         #end
     }
 
+    /**
+        Free the encoded image file; after this only formats that can be converted from cached pixel data are available
+    **/
+    public function releaseSourceFile() {
+        sourceFileBytes = null;
+        sourceFilePath = null;
+    }
+
+    /**
+        Free all decoded and converted pixel data; it is decoded again from the source file when next required
+    **/
+    public function releasePixelData() {
+        while (pixelDataCache.length > 0) {
+            removeCachedPixelData(pixelDataCache[0]);
+        }
+    }
+
+    /**
+        Create a resized copy of this image, filtering in linear space
+        The default filter is `LANCZOS3`
+        @throws String if the image has no pixel data
+    **/
+    public function resize(width: Int, height: Int, nChannels: Int, dataType: PixelDataType, ?options: ResizeOptions): Image {
+        var pixels = getData(nChannels, dataType, false, false);
+        if (pixels == null) {
+            throw 'Failed to resize image: no pixel data';
+        }
+
+        var pixelsCPointer = resizePixels(pixels, decodedWidth, decodedHeight, width, height, nChannels, dataType, options, LANCZOS3);
+
+        var image = new Image(width, height);
+        image.naturalWidth = width;
+        image.naturalHeight = height;
+        image.nChannelsInFile = nChannels;
+        image.isHdrFile = dataType == FLOAT;
+
+        var byteLength = width * height * nChannels * bytesPerChannel(dataType);
+        image.pixelDataCache.push({
+            pixelsCPointer: pixelsCPointer,
+            pixels: ArrayBuffer.fromCPointer(cast pixelsCPointer, byteLength),
+            width: width,
+            height: height,
+            nChannels: nChannels,
+            dataType: dataType,
+            flipY: false,
+            forceUnpremultiply: false,
+            premultiplyAlpha: false,
+            converted: false,
+        });
+        ImageMemoryStats.add(0, byteLength, 0);
+
+        return image;
+    }
+
+    /**
+        Create the full mipmap chain down to 1x1, replacing any existing `mipmaps`
+        Each level is filtered from the one above in linear space; the default filter is `BOX`
+        @throws String if the image has no pixel data
+    **/
+    public function generateMipmaps(nChannels: Int, dataType: PixelDataType, ?options: ResizeOptions) {
+        var pixels = getData(nChannels, dataType, false, false);
+        if (pixels == null) {
+            throw 'Failed to generate mipmaps: no pixel data';
+        }
+
+        releaseMipmaps();
+
+        var levels = new Array<MipmapLevel>();
+        var levelWidth = decodedWidth;
+        var levelHeight = decodedHeight;
+        var levelPixels = pixels;
+
+        while (levelWidth > 1 || levelHeight > 1) {
+            var nextWidth = levelWidth > 1 ? levelWidth >> 1 : 1;
+            var nextHeight = levelHeight > 1 ? levelHeight >> 1 : 1;
+
+            var pixelsCPointer = resizePixels(levelPixels, levelWidth, levelHeight, nextWidth, nextHeight, nChannels, dataType, options, BOX);
+            var byteLength = nextWidth * nextHeight * nChannels * bytesPerChannel(dataType);
+
+            levelWidth = nextWidth;
+            levelHeight = nextHeight;
+            levelPixels = ArrayBuffer.fromCPointer(cast pixelsCPointer, byteLength);
+
+            mipmapCPointers.push(pixelsCPointer);
+            levels.push({
+                width: levelWidth,
+                height: levelHeight,
+                nChannels: nChannels,
+                dataType: dataType,
+                pixels: levelPixels,
+            });
+            ImageMemoryStats.add(0, 0, 0, byteLength);
+        }
+
+        mipmaps = levels;
+    }
+
+    /**
+        Free `mipmaps`, for example once they have been uploaded. These are not freed by `releasePixelData()`
+    **/
+    public function releaseMipmaps() {
+        // mipmaps shared from the image cache are not owned by this image
+        if (mipmaps != null && mipmapCPointers.length > 0) {
+            for (level in mipmaps) {
+                ImageMemoryStats.add(0, 0, 0, -level.pixels.byteLength);
+            }
+        }
+        mipmaps = null;
+        for (pixelsCPointer in mipmapCPointers) {
+            StbImage.stbi_image_free(pixelsCPointer);
+        }
+        // emptied in place, this is reached from the finalizer
+        mipmapCPointers.resize(0);
+    }
+
+    /**
+        Returns stbi allocated pixels
+    **/
+    static function resizePixels(pixels: ArrayBuffer, width: Int, height: Int, newWidth: Int, newHeight: Int, nChannels: Int, dataType: PixelDataType, options: Null<ResizeOptions>, defaultFilter: ResizeFilter): Star<cpp.Void> {
+        if (options == null) options = {};
+        var pixelsCPointer = NativeImage.resize(
+            cast pixels.toCPointer(),
+            width,
+            height,
+            nChannels,
+            dataType == FLOAT,
+            newWidth,
+            newHeight,
+            options.filter != null ? options.filter : defaultFilter,
+            options.srgb != null ? options.srgb : true,
+            options.premultipliedAlpha != null ? options.premultipliedAlpha : false
+        );
+        if (pixelsCPointer == null) {
+            throw 'Failed to resize pixels from ${width}x${height} to ${newWidth}x${newHeight}';
+        }
+        return pixelsCPointer;
+    }
+
     /**
         Will also free stbi allocated pixel data in the cache
+        This runs in the GC finalizer, where allocating is not allowed, so it and everything it calls (including `ImageMemoryStats.add()`) must only free, null and empty in place
     **/
     function clearInternalState() {
         naturalWidth = 0;
         naturalHeight = 0;
-        sourceFileBytes = null;
-        cachedPixelData = null;
+        cacheOwner = null;
+        releaseSourceFile();
+        releasePixelData();
+        releaseMipmaps();
     }
     
     /**
         Returns a tightly packed buffer of pixels given format requirements
+
+        The source file is decoded once; other formats are converted from cached pixel data when possible, which is much faster than decoding again.
+        The returned buffer is owned by the image and remains valid until the image is collected, `releasePixelData()` is called or the conversion is evicted from the cache
         @throws String if parsing the original file fails
     **/
-    function getData(nChannels: Int, dataType: PixelDataType, flipY: Bool, forceUnpremultiply: Bool): Null<ArrayBuffer> {
-        if (cachedPixelData != null &&
-            cachedPixelData.nChannels == nChannels &&
-            cachedPixelData.dataType == dataType &&
-            cachedPixelData.flipY == flipY &&
-            cachedPixelData.forceUnpremultiply == forceUnpremultiply
-        ) {
-            return cachedPixelData.pixels;
+    function getData(nChannels: Int, dataType: PixelDataType, flipY: Bool, forceUnpremultiply: Bool, premultiplyAlpha: Bool = false): Null<ArrayBuffer> {
+        if (cacheOwner != null) {
+            return cacheOwner.getData(nChannels, dataType, flipY, forceUnpremultiply, premultiplyAlpha);
         }
 
-        if (sourceFileBytes == null) {
-            return null;
+        for (entry in pixelDataCache) {
+            if (entry.nChannels == nChannels &&
+                entry.dataType == dataType &&
+                entry.flipY == flipY &&
+                (entry.forceUnpremultiply == forceUnpremultiply || !isIphonePng) &&
+                entry.premultiplyAlpha == (premultiplyAlpha && hasAlpha(nChannels))
+            ) {
+                // move to the end of the least recently used list
+                pixelDataCache.remove(entry);
+                pixelDataCache.push(entry);
+                return entry.pixels;
+            }
         }
 
-        // #if debug
-        if (cachedPixelData != null) {
-            trace([
-                    'Warning: pixel format requested that does not match the internal format; reformatting is required',
-                    '   Requested:',
-                    '       nChannels: $nChannels, dataType: $dataType, flipY: $flipY, forceUnpremultiply: $forceUnpremultiply',
-                    '   Cached:',
-                    '       nChannels: ${cachedPixelData.nChannels}, dataType: ${cachedPixelData.dataType}, flipY: ${cachedPixelData.flipY}, forceUnpremultiply: ${cachedPixelData.forceUnpremultiply}',
-            ].join('\n'));
+        var source = findConversionSource(nChannels, dataType, forceUnpremultiply);
+
+        if (source == null) {
+            if (sourceFileBytes == null && sourceFilePath == null) {
+                return null;
+            }
+
+            #if debug
+            if (pixelDataCache.length > 0) {
+                trace([
+                        'Warning: pixel format requested cannot be converted from the cached pixel data; decoding the source file again',
+                        '   Requested:',
+                        '       nChannels: $nChannels, dataType: $dataType, flipY: $flipY, forceUnpremultiply: $forceUnpremultiply',
+                ].join('\n'));
+            }
+            #end
+
+            var decoded = decodeSourceFile(nChannels, dataType, flipY, forceUnpremultiply);
+
+            if (!premultiplyAlpha || !hasAlpha(nChannels)) {
+                return decoded.pixels;
+            }
+
+            source = decoded;
         }
-        // #end
 
+        return convertPixelData(source, nChannels, dataType, flipY, premultiplyAlpha).pixels;
+    }
+
+    function decodeSourceFile(nChannels: Int, dataType: PixelDataType, flipY: Bool, forceUnpremultiply: Bool): CachedPixelData {
         var width: Int32 = -1;
         var height: Int32 = -1;
         var nChannelsInFile: Int32 = -1;
@@ -140,12 +435,42 @@ class Image {
             case FLOAT: 4;
         }
 
-        StbImage.stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
-        StbImage.stbi_set_unpremultiply_on_load(forceUnpremultiply ? 1 : 0);
+        var reader: Star<NativeImageFileReader> = null;
+
+        if (sourceFileBytes != null) {
+            isIphonePng = NativeImage.isIphonePng(sourceFileBytes.toCPointer(), sourceFileBytes.byteLength) != 0;
+            isHdrFile = StbImage.stbi_is_hdr_from_memory(sourceFileBytes.toCPointer(), sourceFileBytes.byteLength) != 0;
+        } else {
+            reader = sourceFileReader != null ? sourceFileReader : NativeImage.openFileReader(sourceFilePath);
+            if (reader == null) {
+                throw 'Failed to open image file "$sourceFilePath"';
+            }
+            var x: Int32 = -1, y: Int32 = -1, comp: Int32 = -1, is16Bit: Int32 = 0, isHdr: Int32 = 0, isIphone: Int32 = 0;
+            NativeImage.fileReaderInfo(reader, Native.addressOf(x), Native.addressOf(y), Native.addressOf(comp), Native.addressOf(is16Bit), Native.addressOf(isHdr), Native.addressOf(isIphone));
+            isIphonePng = isIphone != 0;
+            isHdrFile = isHdr != 0;
+        }
 
-        var imageBytes: Star<cpp.Void> = switch dataType {
-            case UNSIGNED_BYTE: cast StbImage.stbi_load_from_memory(sourceFileBytes.toCPointer(), sourceFileBytes.byteLength, Native.addressOf(width), Native.addressOf(height), Native.addressOf(nChannelsInFile), nChannels);
-            case FLOAT: cast StbImage.stbi_loadf_from_memory(sourceFileBytes.toCPointer(), sourceFileBytes.byteLength, Native.addressOf(width), Native.addressOf(height), Native.addressOf(nChannelsInFile), nChannels);
+        // stb_image's load flags are process-global and images may be decoded concurrently, so we leave them unset and flip after decoding
+        // the unpremultiply flag only affects iPhone PNGs, decoding these is serialized so the flag is set for the duration of the decode
+        if (isIphonePng) {
+            stbiUnpremultiplyMutex.acquire();
+            StbImage.stbi_set_unpremultiply_on_load(forceUnpremultiply ? 1 : 0);
+        }
+
+        var imageBytes: Star<cpp.Void> = if (reader != null) {
+            NativeImage.loadFromFileReader(reader, Native.addressOf(width), Native.addressOf(height), Native.addressOf(nChannelsInFile), nChannels, dataType == FLOAT, decodeDownscale);
+        } else {
+            NativeImage.loadFromMemory(sourceFileBytes.toCPointer(), sourceFileBytes.byteLength, Native.addressOf(width), Native.addressOf(height), Native.addressOf(nChannelsInFile), nChannels, dataType == FLOAT, decodeDownscale);
+        }
+
+        if (isIphonePng) {
+            StbImage.stbi_set_unpremultiply_on_load(0);
+            stbiUnpremultiplyMutex.release();
+        }
+
+        if (reader != null && reader != sourceFileReader) {
+            NativeImage.closeFileReader(reader);
         }
 
         if (imageBytes == null || width == -1 || height == -1 || nChannels == -1) {
@@ -153,53 +478,221 @@ class Image {
 
             throw 'Failed to parse image buffer: $failureReason';
         }
+
+        this.nChannelsInFile = nChannelsInFile;
         
         var byteLength = width * height * nChannels * bytesPerChannel;
 
-        var pixelData = ArrayBuffer.fromCPointer(cast imageBytes, byteLength);
+        if (flipY) {
+            NativeImage.flipVertically(imageBytes, width, height, nChannels * bytesPerChannel);
+        }
 
-        cachedPixelData = {
+        var entry: CachedPixelData = {
             pixelsCPointer: imageBytes,
-            pixels: pixelData,
+            pixels: ArrayBuffer.fromCPointer(cast imageBytes, byteLength),
+            width: width,
+            height: height,
             nChannels: nChannels,
             dataType: dataType,
             flipY: flipY,
             forceUnpremultiply: forceUnpremultiply,
+            premultiplyAlpha: false,
+            converted: false,
+        }
+        pixelDataCache.push(entry);
+        ImageMemoryStats.add(0, byteLength, 0);
+
+        return entry;
+    }
+
+    /**
+        Returns cached pixel data that can be converted to the requested format with the same result as decoding the source file, or null
+    **/
+    function findConversionSource(nChannels: Int, dataType: PixelDataType, forceUnpremultiply: Bool): Null<CachedPixelData> {
+        var source: Null<CachedPixelData> = null;
+        for (entry in pixelDataCache) {
+            if (entry.premultiplyAlpha) continue;
+            if (isIphonePng && entry.forceUnpremultiply != forceUnpremultiply) continue;
+            // channels the file has but the entry dropped
+            if (hasAlpha(nChannels) && hasAlpha(nChannelsInFile) && !hasAlpha(entry.nChannels)) continue;
+            if (hasColor(nChannels) && hasColor(nChannelsInFile) && !hasColor(entry.nChannels)) continue;
+            // 8-bit pixels of HDR files have lost their range
+            if (isHdrFile && entry.dataType == UNSIGNED_BYTE && dataType == FLOAT) continue;
+            // stb_image computes luminance from 8-bit values for LDR files (and averages HDR files), so only 8-bit LDR pixels convert exactly
+            if (hasColor(entry.nChannels) && !hasColor(nChannels) && (isHdrFile || entry.dataType == FLOAT)) continue;
+
+            // prefer entries that don't require a data type conversion
+            if (source == null || (entry.dataType == dataType && source.dataType != dataType)) {
+                source = entry;
+            }
+        }
+        return source;
+    }
+
+    function convertPixelData(source: CachedPixelData, nChannels: Int, dataType: PixelDataType, flipY: Bool, premultiplyAlpha: Bool): CachedPixelData {
+        var bytesPerChannel = switch dataType {
+            case UNSIGNED_BYTE: 1;
+            case FLOAT: 4;
+        }
+
+        var pixelsCPointer = NativeImage.convertPixels(
+            source.pixelsCPointer,
+            source.width,
+            source.height,
+            source.nChannels,
+            source.dataType == FLOAT,
+            nChannels,
+            dataType == FLOAT,
+            source.flipY != flipY,
+            premultiplyAlpha
+        );
+
+        if (pixelsCPointer == null) {
+            throw 'Failed to convert pixel data: out of memory';
+        }
+
+        var byteLength = source.width * source.height * nChannels * bytesPerChannel;
+
+        var entry: CachedPixelData = {
+            pixelsCPointer: pixelsCPointer,
+            pixels: ArrayBuffer.fromCPointer(cast pixelsCPointer, byteLength),
+            width: source.width,
+            height: source.height,
+            nChannels: nChannels,
+            dataType: dataType,
+            flipY: flipY,
+            forceUnpremultiply: source.forceUnpremultiply,
+            premultiplyAlpha: premultiplyAlpha && hasAlpha(nChannels),
+            converted: true,
+        }
+
+        // free least recently used conversions, the new entry is always kept
+        convertedPixelDataBytes += byteLength;
+        var i = 0;
+        while (convertedPixelDataBytes > convertedPixelDataBudget && i < pixelDataCache.length) {
+            var old = pixelDataCache[i];
+            if (old.converted) {
+                removeCachedPixelData(old);
+            } else {
+                i++;
+            }
+        }
+
+        pixelDataCache.push(entry);
+        ImageMemoryStats.add(0, 0, byteLength);
+
+        return entry;
+    }
+
+    function removeCachedPixelData(entry: CachedPixelData) {
+        pixelDataCache.remove(entry);
+        if (entry.converted) {
+            convertedPixelDataBytes -= entry.pixels.byteLength;
+            ImageMemoryStats.add(0, 0, -entry.pixels.byteLength);
+        } else {
+            ImageMemoryStats.add(0, -entry.pixels.byteLength, 0);
         }
+        // Image_convertPixels allocates with the same allocator as stb_image
+        StbImage.stbi_image_free(entry.pixelsCPointer);
+    }
 
-        return pixelData;
+    inline function get_decodedWidth() {
+        return Std.int((naturalWidth + decodeDownscale - 1) / decodeDownscale);
+    }
+
+    inline function get_decodedHeight() {
+        return Std.int((naturalHeight + decodeDownscale - 1) / decodeDownscale);
+    }
+
+    function set_sourceFileBytes(v: Null<ArrayBuffer>) {
+        ImageMemoryStats.add(
+            (v != null ? v.byteLength : 0) - (this.sourceFileBytes != null ? this.sourceFileBytes.byteLength : 0),
+            0,
+            0
+        );
+        return this.sourceFileBytes = v;
     }
     
-    // function set_src(v: String) {
-    //     clearInternalState();
-    //     // load file from filesystem
-    //     return this.src = v;
-    // }
-
-    function set_cachedPixelData(v) {
-        // free the cached StbImage allocated pixel buffer
-        if (this.cachedPixelData != null) {
-            StbImage.stbi_image_free(this.cachedPixelData.pixelsCPointer);
-        }
-        return this.cachedPixelData = v;
+    function set_src(v: String) {
+        clearInternalState();
+        width = height = 0;
+        var loadId = ++srcLoadId;
+
+        if (v == null || v == '') {
+            complete = true;
+            return this.src = v;
+        }
+
+        complete = false;
+        ImageCache.load(v, internalFormatHint, (shared) -> {
+            if (loadId != srcLoadId) return;
+            cacheOwner = shared;
+            naturalWidth = shared.naturalWidth;
+            naturalHeight = shared.naturalHeight;
+            decodeDownscale = shared.decodeDownscale;
+            width = decodedWidth;
+            height = decodedHeight;
+            mipmaps = shared.mipmaps;
+            complete = true;
+            if (onload != null) onload();
+        }, (error) -> {
+            if (loadId != srcLoadId) return;
+            complete = true;
+            if (onerror != null) onerror(error);
+        });
+
+        return this.src = v;
+    }
+
+    /**
+        Bytes of decoded and converted pixel data and mipmaps owned by this image
+    **/
+    function pixelByteLength(): Int {
+        var total = 0;
+        for (entry in pixelDataCache) {
+            total += entry.pixels.byteLength;
+        }
+        if (mipmaps != null && mipmapCPointers.length > 0) {
+            for (level in mipmaps) {
+                total += level.pixels.byteLength;
+            }
+        }
+        return total;
+    }
+
+    static inline function bytesPerChannel(dataType: PixelDataType) {
+        return switch dataType {
+            case UNSIGNED_BYTE: 1;
+            case FLOAT: 4;
+        }
+    }
+
+    static inline function hasAlpha(nChannels: Int) {
+        return nChannels == 2 || nChannels == 4;
+    }
+
+    static inline function hasColor(nChannels: Int) {
+        return nChannels >= 3;
     }
 
     /**
         **Asynchronously** decode an arraybuffer with the contents of a supported image file format
 
-        `internalFormatHint` is used to specify how the pixel data is formatted internally. If pixel data of a different format is required then expensive synchronous reformatting is required. To avoid this, provide details of the expected format.
+        `internalFormatHint` is used to specify how the pixel data is formatted internally. If pixel data of a different format is required then it is converted synchronously from the decoded pixels (or in rare cases the file is decoded again). To avoid this, provide details of the expected format.
         For example: if when passing the image to `texImage2DImageSource` in WebGL format and type are RGBA and UNSIGNED_BYTE, then pass
             `{ nChannels: 4, dataType: UNSIGNED_BYTE }`
 
         By default, `internalFormatHint` is
             `{ nChannels: <matches source file>, dataType: > 8 bits-per-channel ? FLOAT : UNSIGNED_BYTE }`
 
-        Use `-D debug` to receive warnings when reformatting occurs
+        Use `-D debug` to receive warnings when a format requires decoding the file again
         
+        Decoding runs on a bounded pool of worker threads, see `image.native.DecodePool.maxWorkers`
+
         See stb_image.h for supported image formats
     **/
     static public function decodeImageData(imageFileBytes: ArrayBuffer, ?successCallback: Image -> Void, ?errorCallback: String -> Void, ?internalFormatHint: InternalFormatHint): Void {
-        sys.thread.Thread.create(() -> {
+        DecodePool.run(() -> {
             var width: Int32 = -1;
             var height: Int32 = -1;
             var nChannels: Int32 = -1;
@@ -220,15 +713,19 @@ class Image {
                 image.naturalHeight = height;
                 image.sourceFileBytes = imageFileBytes;
 
-                internalFormatHint = internalFormatHint == null ? {} : internalFormatHint;
-                
                 // synchronously decode the image file and cache it internally
-                image.getData(
-                    internalFormatHint.nChannels != null ? internalFormatHint.nChannels : nChannels,
-                    internalFormatHint.dataType != null ? internalFormatHint.dataType : (is16Bit ? FLOAT : UNSIGNED_BYTE),
-                    internalFormatHint.flipY != null ? internalFormatHint.flipY : false,
-                    internalFormatHint.forceUnpremultiply != null ? internalFormatHint.forceUnpremultiply : false
-                );
+                try {
+                    image.decodeWithHint(nChannels, is16Bit, internalFormatHint);
+                } catch (e: Any) {
+                    if (errorCallback != null) {
+                        haxe.EntryPoint.runInMainThread(() -> errorCallback(Std.string(e)));
+                    }
+                    return;
+                }
+
+                if (image.releaseSourceFileAfterDecode) {
+                    image.releaseSourceFile();
+                }
 
                 if (successCallback != null) {
                     haxe.EntryPoint.runInMainThread(() -> successCallback(image));
@@ -237,6 +734,109 @@ class Image {
         });
     }
 
+    /**
+        **Asynchronously** decode an image file by streaming it from the filesystem, the encoded file is never fully loaded into memory.
+        Later format conversions that require decoding again read the file again unless `releaseSourceFile()` is called
+
+        The decode can be cancelled with the returned task, after which neither callback is called
+
+        See `decodeImageData` for details of `internalFormatHint`
+    **/
+    static public function decodeImageFile(path: String, ?successCallback: Image -> Void, ?errorCallback: String -> Void, ?internalFormatHint: InternalFormatHint): ImageDecodeTask {
+        var task = new ImageDecodeTask();
+
+        DecodePool.run(() -> {
+            if (task.cancelled) return;
+
+            var reader = NativeImage.openFileReader(path);
+
+            if (reader == null) {
+                if (errorCallback != null) {
+                    haxe.EntryPoint.runInMainThread(() -> errorCallback('Failed to open image file "$path"'));
+                }
+                return;
+            }
+
+            if (!task.attachReader(reader)) {
+                NativeImage.closeFileReader(reader);
+                return;
+            }
+
+            var width: Int32 = -1, height: Int32 = -1, nChannels: Int32 = -1, is16Bit: Int32 = 0, isHdr: Int32 = 0, isIphone: Int32 = 0;
+            var image: Null<Image> = null;
+            var error: Null<String> = null;
+
+            var result = NativeImage.fileReaderInfo(reader, Native.addressOf(width), Native.addressOf(height), Native.addressOf(nChannels), Native.addressOf(is16Bit), Native.addressOf(isHdr), Native.addressOf(isIphone)) > 0;
+
+            if (!result || width == -1 || height == -1 || nChannels == -1) {
+                error = 'Failed to parse image file: ${StbImage.stbi_failure_reason().toString()}';
+            } else {
+                image = new Image(width, height);
+                image.naturalWidth = width;
+                image.naturalHeight = height;
+                image.sourceFilePath = path;
+                image.sourceFileReader = reader;
+
+                try {
+                    image.decodeWithHint(nChannels, is16Bit != 0, internalFormatHint);
+                } catch (e: Any) {
+                    error = Std.string(e);
+                }
+
+                image.sourceFileReader = null;
+
+                if (image.releaseSourceFileAfterDecode) {
+                    image.releaseSourceFile();
+                }
+            }
+
+            task.detachReader();
+            NativeImage.closeFileReader(reader);
+
+            if (task.cancelled) return;
+
+            if (error != null) {
+                if (errorCallback != null) {
+                    haxe.EntryPoint.runInMainThread(() -> errorCallback(error));
+                }
+            } else if (successCallback != null) {
+                haxe.EntryPoint.runInMainThread(() -> if (!task.cancelled) successCallback(image));
+            }
+        });
+
+        return task;
+    }
+
+    function decodeWithHint(nChannelsInFile: Int, is16Bit: Bool, internalFormatHint: Null<InternalFormatHint>) {
+        if (internalFormatHint == null) internalFormatHint = {};
+
+        if (internalFormatHint.downscale != null) {
+            decodeDownscale = switch internalFormatHint.downscale {
+                case 1, 2, 4, 8: internalFormatHint.downscale;
+                default: throw 'Unsupported downscale ${internalFormatHint.downscale}, expected 1, 2, 4 or 8';
+            }
+            width = decodedWidth;
+            height = decodedHeight;
+        }
+
+        var nChannels = internalFormatHint.nChannels != null ? internalFormatHint.nChannels : nChannelsInFile;
+        var dataType = internalFormatHint.dataType != null ? internalFormatHint.dataType : (is16Bit ? FLOAT : UNSIGNED_BYTE);
+
+        getData(
+            nChannels,
+            dataType,
+            internalFormatHint.flipY != null ? internalFormatHint.flipY : false,
+            internalFormatHint.forceUnpremultiply != null ? internalFormatHint.forceUnpremultiply : false,
+            internalFormatHint.premultiplyAlpha != null ? internalFormatHint.premultiplyAlpha : false
+        );
+
+        if (internalFormatHint.mipmaps != null) {
+            generateMipmaps(nChannels, dataType, internalFormatHint.mipmaps);
+        }
+    }
+
+    static final stbiUnpremultiplyMutex = new sys.thread.Mutex();
+
     static function finalizer(instance: Image) {
         #if debug
         Stdio.printf("%s\n", "[debug] Image.finalizer()");
@@ -246,6 +846,20 @@ class Image {
 
 }
 
+private typedef CachedPixelData = {
+    final pixelsCPointer: Star<cpp.Void>;
+    final pixels: ArrayBuffer;
+    final width: Int;
+    final height: Int;
+    final nChannels: Int;
+    final dataType: PixelDataType;
+    final flipY: Bool;
+    final forceUnpremultiply: Bool;
+    final premultiplyAlpha: Bool;
+    // converted from other cached pixel data rather than decoded from the source file
+    final converted: Bool;
+}
+
 #end
 
 /**
@@ -264,4 +878,40 @@ typedef InternalFormatHint = {
     ?dataType: PixelDataType,
     ?flipY: Bool,
     ?forceUnpremultiply: Bool,
+    ?premultiplyAlpha: Bool,
+    /**
+        Decode at 1/2, 1/4 or 1/8 of the file's resolution, for example for thumbnails. The image's width and height are the reduced size, naturalWidth and naturalHeight remain the file's size.
+        JPEGs are scaled in the DCT domain so decoding is faster than at full size; other formats are decoded at full size and box filtered, which only saves memory.
+        Ignored on js
+    **/
+    ?downscale: Int,
+    /**
+        Generate `Image.mipmaps` for the hinted format on the decode worker, pass `{}` for the default options.
+        Ignored on js, use `generateMipmap()` instead
+    **/
+    ?mipmaps: ResizeOptions,
+}
+
+enum abstract ResizeFilter(Int) to Int {
+    var BOX = 0;
+    var TRIANGLE = 1;
+    var LANCZOS3 = 2;
+    /** Kaiser-windowed sinc, width 3 and alpha 4 **/
+    var KAISER = 3;
+}
+
+typedef ResizeOptions = {
+    ?filter: ResizeFilter,
+    /** 8-bit colour channels are sRGB encoded and are filtered in linear space, default true **/
+    ?srgb: Bool,
+    /** Colour is already premultiplied by alpha, otherwise colour is weighted by alpha while filtering, default false **/
+    ?premultipliedAlpha: Bool,
+}
+
+typedef MipmapLevel = {
+    final width: Int;
+    final height: Int;
+    final nChannels: Int;
+    final dataType: PixelDataType;
+    final pixels: typedarray.ArrayBuffer;
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+package image;
+
+/**
+    Process-wide cache of images loaded by setting `Image.src`, keyed by path and `Image.internalFormatHint`
+
+    Images loaded from the same path with the same hint share one decoded image, so loading an asset again (for example when a scene is re-entered) costs no file read or decode.
+    When `byteLength` exceeds `budget` the least recently used entries are dropped; their memory is freed once no image loaded from them remains.
+
+    On js the browser caches images itself and these are always 0
+**/
+#if !js
+@:allow(image.Image)
+#end
+class ImageCache {
+
+    /**
+        Maximum bytes of pixel data retained by cached images
+    **/
+    static public var budget: Int = 256 * 1024 * 1024;
+
+    /**
+        Pixel data held by cached images, including mipmaps and conversions made for images loaded from them
+    **/
+    static public var byteLength(get, never): Int;
+
+    /**
+        Loads served from memory, including loads that joined one already in progress
+    **/
+    static public var hits(default, null): Int = 0;
+
+    /**
+        Loads that read and decoded the file
+    **/
+    static public var misses(default, null): Int = 0;
+
+    #if !js
+
+    // least recently used first
+    static final entries = new Array<{ key: String, image: Image }>();
+    static final pending = new Map<String, Array<{ success: Image -> Void, error: String -> Void }>>();
+
+    /**
+        Drop all entries
+    **/
+    static public function clear() {
+        entries.resize(0);
+    }
+
+    static function load(path: String, internalFormatHint: Null<InternalFormatHint>, success: Image -> Void, error: String -> Void) {
+        var key = path + '|' + hintKey(internalFormatHint);
+
+        for (entry in entries) {
+            if (entry.key == key) {
+                hits++;
+                entries.remove(entry);
+                entries.push(entry);
+                // load events are always asynchronous, as in the browser
+                haxe.EntryPoint.runInMainThread(() -> success(entry.image));
+                return;
+            }
+        }
+
+        var callbacks = pending.get(key);
+        if (callbacks != null) {
+            hits++;
+            callbacks.push({ success: success, error: error });
+            return;
+        }
+
+        misses++;
+        pending.set(key, [{ success: success, error: error }]);
+
+        function complete(image: Null<Image>, message: Null<String>) {
+            var callbacks = pending.get(key);
+            pending.remove(key);
+            if (image != null) {
+                add(key, image);
+            }
+            for (callback in callbacks) {
+                if (image != null) callback.success(image) else callback.error(message);
+            }
+        }
+
+        filesystem.File.readBundleFile(
+            app.HaxeApp.getBundleIdentifier(),
+            path,
+            (bytes) -> Image.decodeImageData(bytes, image -> complete(image, null), message -> complete(null, message), internalFormatHint),
+            (message) -> complete(null, 'Failed to load image "$path": $message')
+        );
+    }
+
+    static function add(key: String, image: Image) {
+        entries.push({ key: key, image: image });
+        // the newest entry is always kept
+        while (entries.length > 1 && get_byteLength() > budget) {
+            entries.shift();
+        }
+    }
+
+    static function hintKey(hint: Null<InternalFormatHint>): String {
+        if (hint == null) return '';
+        var mipmaps = hint.mipmaps != null ? '${hint.mipmaps.filter},${hint.mipmaps.srgb},${hint.mipmaps.premultipliedAlpha}' : null;
+        var fields: Array<Dynamic> = [hint.nChannels, hint.dataType, hint.flipY, hint.forceUnpremultiply, hint.premultiplyAlpha, hint.downscale, mipmaps];
+        return fields.join('|');
+    }
+
+    static function get_byteLength() {
+        var total = 0;
+        for (entry in entries) {
+            total += entry.image.pixelByteLength();
+        }
+        return total;
+    }
+
+    #else
+
+    static public function clear() { }
+
+    static inline function get_byteLength() {
+        return 0;
+    }
+
+    #end
+
+}
@@ -0,0 +1,66 @@
+package image;
+
+/**
+    Handle to an in-progress `Image.decodeImageFile()`
+
+    After `cancel()` neither the success nor the error callback is called
+**/
+@:allow(image.Image)
+class ImageDecodeTask {
+
+    public var cancelled(default, null): Bool = false;
+
+    #if js
+
+    final abort: () -> Void;
+
+    function new(abort: () -> Void) {
+        this.abort = abort;
+    }
+
+    public function cancel() {
+        if (cancelled) return;
+        cancelled = true;
+        abort();
+    }
+
+    #else
+
+    final mutex = new sys.thread.Mutex();
+    var reader: cpp.Star<image.native.NativeImage.NativeImageFileReader> = null;
+
+    function new() { }
+
+    /**
+        Stops the decode at its next file read; safe to call from any thread
+    **/
+    public function cancel() {
+        mutex.acquire();
+        cancelled = true;
+        if (reader != null) {
+            image.native.NativeImage.cancelFileReader(reader);
+        }
+        mutex.release();
+    }
+
+    /**
+        Returns false if the task was cancelled before the reader was attached
+    **/
+    function attachReader(reader: cpp.Star<image.native.NativeImage.NativeImageFileReader>): Bool {
+        mutex.acquire();
+        if (!cancelled) {
+            this.reader = reader;
+        }
+        mutex.release();
+        return !cancelled;
+    }
+
+    function detachReader() {
+        mutex.acquire();
+        reader = null;
+        mutex.release();
+    }
+
+    #end
+
+}
@@ -0,0 +1,69 @@
+package image;
+
+/**
+    Live memory held by all images, in bytes
+
+    Counters are 64-bit and reported as Float so totals above 2GB are exact.
+    Updates are lock-free atomics because they happen in the image GC finalizer, where taking a lock can deadlock with a thread holding it when the collector runs
+
+    On js, image memory is owned by the browser and these are always 0
+**/
+#if !js
+@:headerCode('#include <atomic>')
+@:cppFileCode('static std::atomic<long long> imageMemoryStatsBytes[4];')
+#end
+@:allow(image.Image)
+class ImageMemoryStats {
+
+    /**
+        Encoded image files retained for decoding, see `Image.releaseSourceFile()`
+    **/
+    static public var sourceFileBytes(get, never): Float;
+
+    /**
+        Pixel data decoded from source files
+    **/
+    static public var decodedPixelBytes(get, never): Float;
+
+    /**
+        Pixel data converted from decoded pixel data into other formats, see `Image.convertedPixelDataBudget`
+    **/
+    static public var convertedPixelBytes(get, never): Float;
+
+    /**
+        Mipmap levels created by `Image.generateMipmaps()`
+    **/
+    static public var mipmapBytes(get, never): Float;
+
+    static public var totalBytes(get, never): Float;
+
+    static function add(sourceFileDelta: Int, decodedPixelDelta: Int, convertedPixelDelta: Int, mipmapDelta: Int = 0) {
+        #if !js
+        untyped __cpp__('
+            if ({0} != 0) imageMemoryStatsBytes[0].fetch_add({0}, std::memory_order_relaxed);
+            if ({1} != 0) imageMemoryStatsBytes[1].fetch_add({1}, std::memory_order_relaxed);
+            if ({2} != 0) imageMemoryStatsBytes[2].fetch_add({2}, std::memory_order_relaxed);
+            if ({3} != 0) imageMemoryStatsBytes[3].fetch_add({3}, std::memory_order_relaxed)',
+            sourceFileDelta, decodedPixelDelta, convertedPixelDelta, mipmapDelta
+        );
+        #end
+    }
+
+    static inline function load(index: Int): Float {
+        #if !js
+        return untyped __cpp__('(double) imageMemoryStatsBytes[{0}].load(std::memory_order_relaxed)', index);
+        #else
+        return 0;
+        #end
+    }
+
+    static function get_sourceFileBytes() return load(0);
+    static function get_decodedPixelBytes() return load(1);
+    static function get_convertedPixelBytes() return load(2);
+    static function get_mipmapBytes() return load(3);
+
+    static function get_totalBytes() {
+        return sourceFileBytes + decodedPixelBytes + convertedPixelBytes + mipmapBytes;
+    }
+
+}
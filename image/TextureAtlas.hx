@@ -0,0 +1,176 @@
+package image;
+
+import image.AtlasPacker;
+import webgl.GLContext;
+import webgl.GLTexture;
+
+/**
+    Packs many images into shared texture pages so sprites drawn from the same page need no texture rebinds
+
+    Create with `build()` to pack at runtime or `fromLayout()` with a layout generated by `@:packAtlas` AssetPack metadata, then call `upload()`.
+    Each image is copied into its page with `texSubImage2DImageSource`, so the current `UNPACK_*` pixel store state applies.
+    Region UVs are measured from the first uploaded row; pages use `LINEAR` filtering and `CLAMP_TO_EDGE`, mipmaps are not generated
+**/
+class TextureAtlas {
+
+    public final pageWidth: Int;
+    public final pageHeight: Int;
+    public final pageCount: Int;
+
+    /**
+        One region per image, in the order the images were given
+    **/
+    public final regions: Array<AtlasRegion>;
+
+    /**
+        Page textures, empty until `upload()`
+    **/
+    public final pages = new Array<GLTexture>();
+
+    final images: Array<Image>;
+
+    function new(images: Array<Image>, pageWidth: Int, pageHeight: Int, rects: Array<AtlasRect>) {
+        this.images = images;
+        this.pageWidth = pageWidth;
+        this.pageHeight = pageHeight;
+        this.regions = [for (rect in rects) {
+            page: rect.page,
+            x: rect.x,
+            y: rect.y,
+            width: rect.width,
+            height: rect.height,
+            u0: rect.x / pageWidth,
+            v0: rect.y / pageHeight,
+            u1: (rect.x + rect.width) / pageWidth,
+            v1: (rect.y + rect.height) / pageHeight,
+        }];
+        var pageCount = 0;
+        for (rect in rects) {
+            if (rect.page >= pageCount) pageCount = rect.page + 1;
+        }
+        this.pageCount = pageCount;
+    }
+
+    /**
+        **Asynchronously** pack `images` into pages; on native targets packing runs on the decode worker pool.
+        Images must already be decoded and must not be resized before `upload()`
+    **/
+    static public function build(images: Array<Image>, ?successCallback: TextureAtlas -> Void, ?errorCallback: String -> Void, ?options: {
+        ?pageSize: Int, // width and height of each page, default 2048
+        ?padding: Int, // pixels between images to avoid bleeding when filtering, default 2
+    }) {
+        var pageSize = options != null && options.pageSize != null ? options.pageSize : 2048;
+        var padding = options != null && options.padding != null ? options.padding : 2;
+        var images = images.copy();
+        var sizes = [for (image in images) { width: imageWidth(image), height: imageHeight(image) }];
+
+        function pack() {
+            var atlas: Null<TextureAtlas> = null;
+            var error: Null<String> = null;
+            try {
+                atlas = new TextureAtlas(images, pageSize, pageSize, AtlasPacker.pack(sizes, pageSize, pageSize, padding));
+            } catch (e: Any) {
+                error = Std.string(e);
+            }
+
+            #if js
+            if (error != null) {
+                if (errorCallback != null) errorCallback(error);
+            } else if (successCallback != null) {
+                successCallback(atlas);
+            }
+            #else
+            if (error != null) {
+                if (errorCallback != null) {
+                    haxe.EntryPoint.runInMainThread(() -> errorCallback(error));
+                }
+            } else if (successCallback != null) {
+                haxe.EntryPoint.runInMainThread(() -> successCallback(atlas));
+            }
+            #end
+        }
+
+        #if js
+        pack();
+        #else
+        image.native.DecodePool.run(pack);
+        #end
+    }
+
+    /**
+        Create an atlas from a layout packed at compile-time with `@:packAtlas`, `images` must be in the order of `layout.regions`
+        @throws String if the images don't match the layout
+    **/
+    static public function fromLayout(layout: AtlasLayout, images: Array<Image>): TextureAtlas {
+        if (images.length != layout.regions.length) {
+            throw 'Atlas layout has ${layout.regions.length} regions but ${images.length} images were given';
+        }
+        for (i in 0...images.length) {
+            var region = layout.regions[i];
+            if (imageWidth(images[i]) != region.width || imageHeight(images[i]) != region.height) {
+                throw 'Image for "${region.path}" is ${imageWidth(images[i])}x${imageHeight(images[i])}, expected ${region.width}x${region.height}';
+            }
+        }
+        var rects: Array<AtlasRect> = [for (region in layout.regions) { page: region.page, x: region.x, y: region.y, width: region.width, height: region.height }];
+        return new TextureAtlas(images.copy(), layout.pageWidth, layout.pageHeight, rects);
+    }
+
+    /**
+        Create the page textures and copy every image into its page. Leaves the last page bound to `TEXTURE_2D`
+    **/
+    public function upload(gl: GLContext) {
+        for (page in 0...pageCount) {
+            var texture = gl.createTexture();
+            pages.push(texture);
+            gl.bindTexture(TEXTURE_2D, texture);
+            gl.texParameteri(TEXTURE_2D, TEXTURE_WRAP_S, CLAMP_TO_EDGE);
+            gl.texParameteri(TEXTURE_2D, TEXTURE_WRAP_T, CLAMP_TO_EDGE);
+            gl.texParameteri(TEXTURE_2D, TEXTURE_MIN_FILTER, LINEAR);
+            gl.texParameteri(TEXTURE_2D, TEXTURE_MAG_FILTER, LINEAR);
+            // WebGL clears new textures, native GL leaves them undefined so the padding is cleared explicitly
+            gl.texImage2D(TEXTURE_2D, 0, RGBA, pageWidth, pageHeight, 0, RGBA, UNSIGNED_BYTE, #if js null #else new typedarray.Uint8Array(pageWidth * pageHeight * 4) #end);
+
+            for (i in 0...regions.length) {
+                var region = regions[i];
+                if (region.page != page) continue;
+                gl.texSubImage2DImageSource(TEXTURE_2D, 0, region.x, region.y, RGBA, UNSIGNED_BYTE, images[i]);
+            }
+        }
+    }
+
+    static inline function imageWidth(image: Image): Int {
+        return #if js image.naturalWidth #else image.width #end;
+    }
+
+    static inline function imageHeight(image: Image): Int {
+        return #if js image.naturalHeight #else image.height #end;
+    }
+
+}
+
+typedef AtlasRegion = {
+    final page: Int;
+    /**
+        Position and size in pixels
+    **/
+    final x: Int;
+    final y: Int;
+    final width: Int;
+    final height: Int;
+    final u0: Float;
+    final v0: Float;
+    final u1: Float;
+    final v1: Float;
+}
+
+/**
+    Generated by `@:packAtlas` AssetPack metadata
+**/
+typedef AtlasLayout = {
+    final pageWidth: Int;
+    final pageHeight: Int;
+    /**
+        `path` is the image's path within the asset pack, as in the pack's `paths`
+    **/
+    final regions: Array<{ path: String, page: Int, x: Int, y: Int, width: Int, height: Int }>;
+}
@@ -0,0 +1,60 @@
+package image.native;
+
+#if basis_universal
+
+import cpp.*;
+
+/**
+	Externs for image/native/basis.h
+
+	Requires `-D basis_universal=<path>` pointing to a checkout of https://github.com/BinomialLLC/basis_universal, the transcoder and its zstd decoder are compiled into the hxcpp build
+**/
+@:include('./basis.h')
+@:sourceFile('./basis.cpp')
+@:buildXml("
+	<files id='haxe'>
+		<compilerflag value='-I${basis_universal}/transcoder' />
+		<file name='${basis_universal}/transcoder/basisu_transcoder.cpp' />
+		<file name='${basis_universal}/zstd/zstddeclib.c' />
+	</files>
+")
+extern class BasisTranscoder {
+
+	/**
+		Returns null if the data is not a Basis (ETC1S or UASTC) KTX2 file. `data` must remain valid until `close()`
+	**/
+	static inline function open(data: ConstStar<UInt8>, byteLength: Int32): Star<NativeBasisKtx2> {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Star<NativeBasisKtx2> = untyped __global__.BasisKtx2_open(data, byteLength);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+	@:native('BasisKtx2_close')
+	static function close(ktx2: Star<NativeBasisKtx2>): Void;
+
+	@:native('BasisKtx2_info')
+	static function info(ktx2: Star<NativeBasisKtx2>, width: Star<Int32>, height: Star<Int32>, levelCount: Star<Int32>, faceCount: Star<Int32>, isUastc: Star<Int32>, hasAlpha: Star<Int32>): Void;
+
+	/**
+		Returns -1 if the level doesn't exist
+	**/
+	@:native('BasisKtx2_levelByteLength')
+	static function levelByteLength(ktx2: Star<NativeBasisKtx2>, level: Int32, format: Int32, width: Star<Int32>, height: Star<Int32>): Int32;
+
+	/**
+		Returns 0 on failure
+	**/
+	static inline function transcodeLevel(ktx2: Star<NativeBasisKtx2>, level: Int32, face: Int32, format: Int32, output: Star<UInt8>, outputByteLength: Int32): Int32 {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Int32 = untyped __global__.BasisKtx2_transcodeLevel(ktx2, level, face, format, output, outputByteLength);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+}
+
+@:native('BasisKtx2')
+extern class NativeBasisKtx2 {}
+
+#end
@@ -0,0 +1,65 @@
+package image.native;
+
+import sys.thread.Deque;
+import sys.thread.Mutex;
+import sys.thread.Thread;
+
+/**
+	Bounded pool of worker threads for decode work
+
+	Jobs run in submission order on up to `maxWorkers` threads. Workers are created on demand and stay alive waiting for more jobs
+**/
+class DecodePool {
+
+	/**
+		Upper bound on worker threads; lowering this does not stop workers that are already running
+	**/
+	static public var maxWorkers: Int = 4;
+
+	static final jobs = new Deque<() -> Void>();
+	static final mutex = new Mutex();
+	static var workerCount = 0;
+	static var idleWorkerCount = 0;
+	static var queuedJobCount = 0;
+
+	/**
+		Queue `job` to run on a worker thread
+	**/
+	static public function run(job: () -> Void) {
+		mutex.acquire();
+		queuedJobCount++;
+		var startWorker = queuedJobCount > idleWorkerCount && workerCount < maxWorkers;
+		if (startWorker) {
+			workerCount++;
+		}
+		mutex.release();
+
+		jobs.add(job);
+
+		if (startWorker) {
+			Thread.create(workerLoop);
+		}
+	}
+
+	static function workerLoop() {
+		while (true) {
+			mutex.acquire();
+			idleWorkerCount++;
+			mutex.release();
+
+			var job = jobs.pop(true);
+
+			mutex.acquire();
+			idleWorkerCount--;
+			queuedJobCount--;
+			mutex.release();
+
+			try {
+				job();
+			} catch (e: Any) {
+				trace('Uncaught exception in DecodePool job: $e');
+			}
+		}
+	}
+
+}
@@ -0,0 +1,87 @@
+package image.native;
+
+import cpp.*;
+
+/**
+	Externs for image/native/native.h
+**/
+@:include('./native.h')
+@:sourceFile('./native.c')
+extern class NativeImage {
+
+	@:native('Image_flipVertically')
+	static function flipVertically(pixels: Star<cpp.Void>, width: Int32, height: Int32, bytesPerPixel: Int32): Void;
+
+	@:native('Image_isIphonePng')
+	static function isIphonePng(bytes: ConstStar<UInt8>, byteLength: Int32): Int32;
+
+	static inline function convertPixels(src: ConstStar<cpp.Void>, width: Int32, height: Int32, srcChannels: Int32, srcIsFloat: Bool, dstChannels: Int32, dstIsFloat: Bool, flipY: Bool, premultiplyAlpha: Bool): Star<cpp.Void> {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Star<cpp.Void> = untyped __global__.Image_convertPixels(src, width, height, srcChannels, srcIsFloat, dstChannels, dstIsFloat, flipY, premultiplyAlpha);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+	/**
+		Decode at 1/`downscale` of the file's resolution, JPEGs are scaled in the DCT domain
+	**/
+	static inline function loadFromMemory(bytes: ConstStar<UInt8>, byteLength: Int32, x: Star<Int32>, y: Star<Int32>, channelsInFile: Star<Int32>, desiredChannels: Int32, isFloat: Bool, downscale: Int32): Star<cpp.Void> {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Star<cpp.Void> = untyped __global__.Image_loadFromMemory(bytes, byteLength, x, y, channelsInFile, desiredChannels, isFloat, downscale);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+	static inline function resize(src: ConstStar<cpp.Void>, srcWidth: Int32, srcHeight: Int32, channels: Int32, isFloat: Bool, dstWidth: Int32, dstHeight: Int32, filter: Int32, srgb: Bool, premultipliedAlpha: Bool): Star<cpp.Void> {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Star<cpp.Void> = untyped __global__.Image_resize(src, srcWidth, srcHeight, channels, isFloat, dstWidth, dstHeight, filter, srgb, premultipliedAlpha);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+	/**
+		Read-only memory mapping of a file, returns null on failure
+	**/
+	@:native('Image_mapFile')
+	static function mapFile(path: ConstCharStar, byteLength: Star<Int32>): Star<cpp.Void>;
+
+	@:native('Image_unmapFile')
+	static function unmapFile(data: Star<cpp.Void>, byteLength: Int32): Void;
+
+	/**
+		Returns null if the file cannot be opened; close with `closeFileReader()`
+	**/
+	@:native('ImageFileReader_open')
+	static function openFileReader(path: ConstCharStar): Star<NativeImageFileReader>;
+
+	@:native('ImageFileReader_close')
+	static function closeFileReader(reader: Star<NativeImageFileReader>): Void;
+
+	/**
+		Thread-safe, the current or next decode with this reader fails
+	**/
+	@:native('ImageFileReader_cancel')
+	static function cancelFileReader(reader: Star<NativeImageFileReader>): Void;
+
+	static inline function fileReaderInfo(reader: Star<NativeImageFileReader>, x: Star<Int32>, y: Star<Int32>, comp: Star<Int32>, is16Bit: Star<Int32>, isHdr: Star<Int32>, isIphonePng: Star<Int32>): Int32 {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Int32 = untyped __global__.ImageFileReader_info(reader, x, y, comp, is16Bit, isHdr, isIphonePng);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+	static inline function loadFromFileReader(reader: Star<NativeImageFileReader>, x: Star<Int32>, y: Star<Int32>, channelsInFile: Star<Int32>, desiredChannels: Int32, isFloat: Bool, downscale: Int32): Star<cpp.Void> {
+		cpp.vm.Gc.enterGCFreeZone();
+		var ret: Star<cpp.Void> = untyped __global__.ImageFileReader_load(reader, x, y, channelsInFile, desiredChannels, isFloat, downscale);
+		cpp.vm.Gc.exitGCFreeZone();
+		return ret;
+	}
+
+}
+
+/**
+	Opaque `ImageFileReader` handle, streams a file into stb_image
+**/
+@:include('./native.h')
+@:native('ImageFileReader')
+extern class NativeImageFileReader {}
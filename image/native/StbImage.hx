@@ -83,6 +83,9 @@ extern class StbImage {
 
 	@:native('stbi_is_16_bit_from_callbacks')
 	static function stbi_is_16_bit_from_callbacks(callbacks: ConstStar<NativeStbiIoCallbacks>, user: Star<cpp.Void>): Int32;
+
+	@:native('stbi_is_hdr_from_memory')
+	static function stbi_is_hdr_from_memory(buffer: ConstStar<UInt8>, len: Int32): Int32;
 	
 	/**
 		flip the image vertically, so the first pixel in the output array is the bottom left
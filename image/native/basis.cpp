@@ -0,0 +1,73 @@
+#include "basis.h"
+
+#include <mutex>
+#include <new>
+#include "basisu_transcoder.h"
+
+struct BasisKtx2 {
+	basist::ktx2_transcoder transcoder;
+};
+
+static std::once_flag BasisKtx2_initFlag;
+
+BasisKtx2* BasisKtx2_open(const unsigned char* data, int byteLength) {
+	// builds the global transcoding tables, once per process
+	std::call_once(BasisKtx2_initFlag, basist::basisu_transcoder_init);
+
+	BasisKtx2* ktx2 = new (std::nothrow) BasisKtx2();
+	if (ktx2 == NULL) return NULL;
+
+	if (
+		!ktx2->transcoder.init(data, (uint32_t)byteLength) ||
+		!(ktx2->transcoder.is_etc1s() || ktx2->transcoder.is_uastc()) ||
+		ktx2->transcoder.get_layers() > 1 ||
+		!ktx2->transcoder.start_transcoding()
+	) {
+		delete ktx2;
+		return NULL;
+	}
+
+	return ktx2;
+}
+
+void BasisKtx2_close(BasisKtx2* ktx2) {
+	delete ktx2;
+}
+
+void BasisKtx2_info(BasisKtx2* ktx2, int* width, int* height, int* levelCount, int* faceCount, int* isUastc, int* hasAlpha) {
+	basist::ktx2_transcoder& transcoder = ktx2->transcoder;
+	*width = (int)transcoder.get_width();
+	*height = (int)transcoder.get_height();
+	*levelCount = (int)transcoder.get_levels();
+	*faceCount = (int)transcoder.get_faces();
+	*isUastc = transcoder.is_uastc() ? 1 : 0;
+	*hasAlpha = transcoder.get_has_alpha() ? 1 : 0;
+}
+
+int BasisKtx2_levelByteLength(BasisKtx2* ktx2, int level, int format, int* width, int* height) {
+	basist::ktx2_image_level_info info;
+	if (!ktx2->transcoder.get_image_level_info(info, (uint32_t)level, 0, 0)) {
+		return -1;
+	}
+
+	basist::transcoder_texture_format textureFormat = (basist::transcoder_texture_format)format;
+	uint32_t bytesPerBlockOrPixel = basist::basis_get_bytes_per_block_or_pixel(textureFormat);
+
+	*width = (int)info.m_orig_width;
+	*height = (int)info.m_orig_height;
+
+	if (basist::basis_transcoder_format_is_uncompressed(textureFormat)) {
+		return (int)(info.m_orig_width * info.m_orig_height * bytesPerBlockOrPixel);
+	} else {
+		return (int)(info.m_total_blocks * bytesPerBlockOrPixel);
+	}
+}
+
+int BasisKtx2_transcodeLevel(BasisKtx2* ktx2, int level, int face, int format, unsigned char* output, int outputByteLength) {
+	basist::transcoder_texture_format textureFormat = (basist::transcoder_texture_format)format;
+	uint32_t bytesPerBlockOrPixel = basist::basis_get_bytes_per_block_or_pixel(textureFormat);
+	// the output size is given in blocks, or pixels for uncompressed formats
+	uint32_t outputSize = (uint32_t)outputByteLength / bytesPerBlockOrPixel;
+
+	return ktx2->transcoder.transcode_image_level((uint32_t)level, 0, (uint32_t)face, output, outputSize, textureFormat) ? 1 : 0;
+}
@@ -0,0 +1,42 @@
+/**
+ * C interface to the Basis Universal KTX2 transcoder
+ * Only compiled with `-D basis_universal=<path to a basis_universal checkout>`, see image/native/BasisTranscoder.hx
+ */
+
+#ifndef IMAGE_NATIVE_BASIS_H
+#define IMAGE_NATIVE_BASIS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Transcoder state for one KTX2 file, the file data must remain valid until BasisKtx2_close
+ */
+typedef struct BasisKtx2 BasisKtx2;
+
+/**
+ * Returns NULL if the data is not a Basis (ETC1S or UASTC) KTX2 file
+ */
+BasisKtx2* BasisKtx2_open(const unsigned char* data, int byteLength);
+void BasisKtx2_close(BasisKtx2* ktx2);
+
+void BasisKtx2_info(BasisKtx2* ktx2, int* width, int* height, int* levelCount, int* faceCount, int* isUastc, int* hasAlpha);
+
+/**
+ * Byte length of a transcoded level, `format` is a basist::transcoder_texture_format
+ * Returns -1 if the level doesn't exist
+ */
+int  BasisKtx2_levelByteLength(BasisKtx2* ktx2, int level, int format, int* width, int* height);
+
+/**
+ * Transcode one level and face into `output`, which must hold BasisKtx2_levelByteLength bytes
+ * Returns 0 on failure
+ */
+int  BasisKtx2_transcodeLevel(BasisKtx2* ktx2, int level, int face, int format, unsigned char* output, int outputByteLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,4 +1,586 @@
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_NO_STDIO // disable filesystem io
 #define STBI_NO_THREAD_LOCALS // not supported with haxe-iOS compiler setup
-#include "./stb_image.h"
\ No newline at end of file
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define STBI_NEON // SSE2 is enabled automatically on x86 but NEON must be requested; speeds up JPEG IDCT, colour conversion and upsampling
+#endif
+#include "./stb_image.h"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "./native.h"
+
+void Image_flipVertically(void* pixels, int width, int height, int bytesPerPixel) {
+	stbi__vertical_flip(pixels, width, height, bytesPerPixel);
+}
+
+int Image_isIphonePng(const unsigned char* bytes, int byteLength) {
+	static const unsigned char pngSignature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+	// the CgBI chunk comes first, directly after the signature and chunk length
+	return byteLength >= 16 && memcmp(bytes, pngSignature, 8) == 0 && memcmp(bytes + 12, "CgBI", 4) == 0;
+}
+
+static float Image_luma(float r, float g, float b) {
+	// same weights as stbi__compute_y
+	return (r * 77 + g * 150 + b * 29) * (1.0f / 256.0f);
+}
+
+#define IMAGE_CONVERT_CHANNELS(T, ONE, LUMA) \
+	int i; \
+	if (srcChannels == dstChannels) { \
+		memcpy(d, s, sizeof(T) * n * srcChannels); \
+		return; \
+	} \
+	switch (srcChannels * 8 + dstChannels) { \
+		case 1*8+2: for (i = 0; i < n; i++, s += 1, d += 2) { d[0] = s[0]; d[1] = ONE; } break; \
+		case 1*8+3: for (i = 0; i < n; i++, s += 1, d += 3) { d[0] = d[1] = d[2] = s[0]; } break; \
+		case 1*8+4: for (i = 0; i < n; i++, s += 1, d += 4) { d[0] = d[1] = d[2] = s[0]; d[3] = ONE; } break; \
+		case 2*8+1: for (i = 0; i < n; i++, s += 2, d += 1) { d[0] = s[0]; } break; \
+		case 2*8+3: for (i = 0; i < n; i++, s += 2, d += 3) { d[0] = d[1] = d[2] = s[0]; } break; \
+		case 2*8+4: for (i = 0; i < n; i++, s += 2, d += 4) { d[0] = d[1] = d[2] = s[0]; d[3] = s[1]; } break; \
+		case 3*8+1: for (i = 0; i < n; i++, s += 3, d += 1) { d[0] = LUMA(s[0], s[1], s[2]); } break; \
+		case 3*8+2: for (i = 0; i < n; i++, s += 3, d += 2) { d[0] = LUMA(s[0], s[1], s[2]); d[1] = ONE; } break; \
+		case 3*8+4: for (i = 0; i < n; i++, s += 3, d += 4) { d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = ONE; } break; \
+		case 4*8+1: for (i = 0; i < n; i++, s += 4, d += 1) { d[0] = LUMA(s[0], s[1], s[2]); } break; \
+		case 4*8+2: for (i = 0; i < n; i++, s += 4, d += 2) { d[0] = LUMA(s[0], s[1], s[2]); d[1] = s[3]; } break; \
+		case 4*8+3: for (i = 0; i < n; i++, s += 4, d += 3) { d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; } break; \
+	}
+
+static void Image_convertChannelsUint8(const stbi_uc* s, stbi_uc* d, int n, int srcChannels, int dstChannels) {
+	IMAGE_CONVERT_CHANNELS(stbi_uc, 255, stbi__compute_y)
+}
+
+static void Image_convertChannelsFloat(const float* s, float* d, int n, int srcChannels, int dstChannels) {
+	IMAGE_CONVERT_CHANNELS(float, 1.0f, Image_luma)
+}
+
+#undef IMAGE_CONVERT_CHANNELS
+
+void* Image_convertPixels(const void* src, int width, int height, int srcChannels, int srcIsFloat, int dstChannels, int dstIsFloat, int flipY, int premultiplyAlpha) {
+	int srcBytesPerChannel = srcIsFloat ? sizeof(float) : 1;
+	int dstBytesPerChannel = dstIsFloat ? sizeof(float) : 1;
+	size_t srcStride = (size_t) width * srcChannels * srcBytesPerChannel;
+	size_t dstStride = (size_t) width * dstChannels * dstBytesPerChannel;
+	int rowLength = width * dstChannels;
+	// alpha is the last channel when there's an even number of channels, as in stb_image
+	int alphaIndex = (dstChannels & 1) ? -1 : dstChannels - 1;
+	float ldrToHdr[256];
+	void* row = NULL;
+	unsigned char* dst;
+	int i, x, y;
+
+	if (srcChannels < 1 || srcChannels > 4 || dstChannels < 1 || dstChannels > 4) return NULL;
+
+	dst = (unsigned char*) stbi__malloc_mad4(width, height, dstChannels, dstBytesPerChannel, 0);
+	if (dst == NULL) return NULL;
+
+	if (srcIsFloat != dstIsFloat) {
+		// channel conversion happens on 8-bit values (as stb_image does) so a row buffer holds the 8-bit intermediate
+		row = stbi__malloc_mad3(width, srcIsFloat ? srcChannels : dstChannels, 1, 0);
+		if (row == NULL) {
+			STBI_FREE(dst);
+			return NULL;
+		}
+	}
+
+	if (!srcIsFloat && dstIsFloat) {
+		for (i = 0; i < 256; i++) {
+			ldrToHdr[i] = (float) (pow(i / 255.0f, stbi__l2h_gamma) * stbi__l2h_scale);
+		}
+	}
+
+	for (y = 0; y < height; y++) {
+		const unsigned char* srcRow = (const unsigned char*) src + srcStride * (flipY ? height - 1 - y : y);
+		unsigned char* dstRow = dst + dstStride * y;
+
+		if (srcIsFloat == dstIsFloat) {
+			if (srcIsFloat) {
+				Image_convertChannelsFloat((const float*) srcRow, (float*) dstRow, width, srcChannels, dstChannels);
+			} else {
+				Image_convertChannelsUint8(srcRow, dstRow, width, srcChannels, dstChannels);
+			}
+		} else if (dstIsFloat) {
+			// matches stbi__ldr_to_hdr
+			const stbi_uc* s = (const stbi_uc*) row;
+			float* d = (float*) dstRow;
+			Image_convertChannelsUint8(srcRow, (stbi_uc*) row, width, srcChannels, dstChannels);
+			for (i = 0; i < rowLength; i++) {
+				d[i] = ldrToHdr[s[i]];
+			}
+			if (alphaIndex != -1) {
+				for (i = alphaIndex; i < rowLength; i += dstChannels) {
+					d[i] = s[i] / 255.0f;
+				}
+			}
+		} else {
+			// matches stbi__hdr_to_ldr
+			const float* s = (const float*) srcRow;
+			stbi_uc* d = (stbi_uc*) row;
+			int srcAlphaIndex = (srcChannels & 1) ? -1 : srcChannels - 1;
+			for (x = 0; x < width * srcChannels; x += srcChannels) {
+				for (i = 0; i < srcChannels; i++) {
+					float z = i == srcAlphaIndex
+						? s[x + i] * 255 + 0.5f
+						: (float) pow(s[x + i] * stbi__h2l_scale_i, stbi__h2l_gamma_i) * 255 + 0.5f;
+					if (z < 0) z = 0;
+					if (z > 255) z = 255;
+					d[x + i] = (stbi_uc) z;
+				}
+			}
+			Image_convertChannelsUint8(d, dstRow, width, srcChannels, dstChannels);
+		}
+
+		if (premultiplyAlpha && alphaIndex != -1) {
+			if (dstIsFloat) {
+				float* d = (float*) dstRow;
+				for (x = 0; x < rowLength; x += dstChannels) {
+					float a = d[x + alphaIndex];
+					for (i = 0; i < alphaIndex; i++) d[x + i] *= a;
+				}
+			} else {
+				stbi_uc* d = dstRow;
+				for (x = 0; x < rowLength; x += dstChannels) {
+					int a = d[x + alphaIndex];
+					for (i = 0; i < alphaIndex; i++) {
+						// rounded c * a / 255
+						int t = d[x + i] * a + 128;
+						d[x + i] = (stbi_uc) ((t + (t >> 8)) >> 8);
+					}
+				}
+			}
+		}
+	}
+
+	STBI_FREE(row);
+
+	return dst;
+}
+
+/**
+ * JPEGs are decoded at reduced size by stb_image's JPEG decoder (patched, see "webcore patch" in stb_image.h), which only inverse transforms the low frequency
+ * coefficients of each block. Other formats have no reduced-size decode and are box filtered after a full decode
+ */
+static void* Image_loadScaled(stbi__context* s, int* x, int* y, int* channelsInFile, int desiredChannels, int isFloat, int downscale) {
+	void* pixels;
+	s->jpeg_scale_shift = downscale == 8 ? 3 : downscale == 4 ? 2 : downscale == 2 ? 1 : 0;
+	pixels = isFloat
+		? (void*) stbi__loadf_main(s, x, y, channelsInFile, desiredChannels)
+		: (void*) stbi__load_and_postprocess_8bit(s, x, y, channelsInFile, desiredChannels);
+	// the JPEG decoder resets jpeg_scale_shift once it has applied it
+	if (pixels != NULL && s->jpeg_scale_shift != 0) {
+		void* fullPixels = pixels;
+		pixels = Image_downscale(fullPixels, *x, *y, desiredChannels ? desiredChannels : *channelsInFile, isFloat, downscale, x, y);
+		STBI_FREE(fullPixels);
+		if (pixels == NULL) stbi__err("outofmem", "Out of memory");
+	}
+	return pixels;
+}
+
+void* Image_loadFromMemory(const unsigned char* bytes, int byteLength, int* x, int* y, int* channelsInFile, int desiredChannels, int isFloat, int downscale) {
+	stbi__context s;
+	stbi__start_mem(&s, bytes, byteLength);
+	return Image_loadScaled(&s, x, y, channelsInFile, desiredChannels, isFloat, downscale);
+}
+
+struct ImageFileReader {
+	FILE* file;
+	volatile int cancelled;
+};
+
+static int ImageFileReader_read(void* user, char* data, int size) {
+	ImageFileReader* reader = (ImageFileReader*) user;
+	if (reader->cancelled) return 0;
+	return (int) fread(data, 1, size, reader->file);
+}
+
+static void ImageFileReader_skip(void* user, int n) {
+	ImageFileReader* reader = (ImageFileReader*) user;
+	fseek(reader->file, n, SEEK_CUR);
+}
+
+static int ImageFileReader_eof(void* user) {
+	ImageFileReader* reader = (ImageFileReader*) user;
+	return reader->cancelled || feof(reader->file);
+}
+
+static const stbi_io_callbacks ImageFileReader_callbacks = {
+	ImageFileReader_read,
+	ImageFileReader_skip,
+	ImageFileReader_eof,
+};
+
+static void ImageFileReader_rewind(ImageFileReader* reader) {
+	rewind(reader->file);
+}
+
+ImageFileReader* ImageFileReader_open(const char* path) {
+	ImageFileReader* reader;
+	FILE* file = fopen(path, "rb");
+	if (file == NULL) return NULL;
+	reader = (ImageFileReader*) STBI_MALLOC(sizeof(ImageFileReader));
+	if (reader == NULL) {
+		fclose(file);
+		return NULL;
+	}
+	reader->file = file;
+	reader->cancelled = 0;
+	return reader;
+}
+
+void ImageFileReader_close(ImageFileReader* reader) {
+	fclose(reader->file);
+	STBI_FREE(reader);
+}
+
+void ImageFileReader_cancel(ImageFileReader* reader) {
+	reader->cancelled = 1;
+}
+
+int ImageFileReader_isCancelled(ImageFileReader* reader) {
+	return reader->cancelled;
+}
+
+int ImageFileReader_info(ImageFileReader* reader, int* x, int* y, int* comp, int* is16Bit, int* isHdr, int* isIphonePng) {
+	unsigned char header[16];
+	int headerLength;
+	int result;
+
+	ImageFileReader_rewind(reader);
+	headerLength = ImageFileReader_read(reader, (char*) header, sizeof(header));
+	*isIphonePng = Image_isIphonePng(header, headerLength);
+
+	ImageFileReader_rewind(reader);
+	result = stbi_info_from_callbacks(&ImageFileReader_callbacks, reader, x, y, comp);
+	ImageFileReader_rewind(reader);
+	*is16Bit = stbi_is_16_bit_from_callbacks(&ImageFileReader_callbacks, reader);
+	ImageFileReader_rewind(reader);
+	*isHdr = stbi_is_hdr_from_callbacks(&ImageFileReader_callbacks, reader);
+
+	return result && !reader->cancelled;
+}
+
+void* ImageFileReader_load(ImageFileReader* reader, int* x, int* y, int* channelsInFile, int desiredChannels, int isFloat, int downscale) {
+	void* pixels;
+	stbi__context s;
+	ImageFileReader_rewind(reader);
+	stbi__start_callbacks(&s, (stbi_io_callbacks*) &ImageFileReader_callbacks, reader);
+	pixels = Image_loadScaled(&s, x, y, channelsInFile, desiredChannels, isFloat, downscale);
+	// a cancelled decode may succeed if it was cancelled after the last read
+	if (pixels != NULL && reader->cancelled) {
+		STBI_FREE(pixels);
+		pixels = NULL;
+	}
+	return pixels;
+}
+
+void* Image_downscale(const void* src, int width, int height, int channels, int isFloat, int factor, int* outWidth, int* outHeight) {
+	int dstWidth = (width + factor - 1) / factor;
+	int dstHeight = (height + factor - 1) / factor;
+	int x, y, k, sx, sy;
+	void* dst = isFloat
+		? stbi__malloc_mad4(dstWidth, dstHeight, channels, sizeof(float), 0)
+		: stbi__malloc_mad3(dstWidth, dstHeight, channels, 0);
+
+	if (dst == NULL) return NULL;
+
+	// each output pixel averages the (up to) factor x factor block of source pixels it covers
+	for (y = 0; y < dstHeight; y++) {
+		int y0 = y * factor;
+		int y1 = y0 + factor < height ? y0 + factor : height;
+		for (x = 0; x < dstWidth; x++) {
+			int x0 = x * factor;
+			int x1 = x0 + factor < width ? x0 + factor : width;
+			int count = (x1 - x0) * (y1 - y0);
+			for (k = 0; k < channels; k++) {
+				if (isFloat) {
+					float sum = 0;
+					for (sy = y0; sy < y1; sy++) {
+						const float* row = (const float*) src + ((size_t) sy * width) * channels;
+						for (sx = x0; sx < x1; sx++) sum += row[sx * channels + k];
+					}
+					((float*) dst)[((size_t) y * dstWidth + x) * channels + k] = sum / count;
+				} else {
+					unsigned int sum = 0;
+					for (sy = y0; sy < y1; sy++) {
+						const stbi_uc* row = (const stbi_uc*) src + ((size_t) sy * width) * channels;
+						for (sx = x0; sx < x1; sx++) sum += row[sx * channels + k];
+					}
+					((stbi_uc*) dst)[((size_t) y * dstWidth + x) * channels + k] = (stbi_uc) ((sum + count / 2) / count);
+				}
+			}
+		}
+	}
+
+	*outWidth = dstWidth;
+	*outHeight = dstHeight;
+	return dst;
+}
+
+#define IMAGE_PI 3.14159265358979323846f
+
+static float Image_sinc(float x) {
+	if (x == 0.0f) return 1.0f;
+	x *= IMAGE_PI;
+	return sinf(x) / x;
+}
+
+static float Image_besselI0(float x) {
+	// power series, converges quickly for the small arguments used by the kaiser window
+	float sum = 1.0f, term = 1.0f, halfX = x * 0.5f;
+	int k;
+	for (k = 1; k < 20; k++) {
+		term *= (halfX / k) * (halfX / k);
+		sum += term;
+	}
+	return sum;
+}
+
+static float Image_filter(int filter, float x) {
+	float t;
+	x = fabsf(x);
+	switch (filter) {
+		case IMAGE_RESIZE_FILTER_BOX: return x <= 0.5f ? 1.0f : 0.0f;
+		case IMAGE_RESIZE_FILTER_TRIANGLE: return x < 1.0f ? 1.0f - x : 0.0f;
+		case IMAGE_RESIZE_FILTER_LANCZOS3: return x < 3.0f ? Image_sinc(x) * Image_sinc(x / 3.0f) : 0.0f;
+		case IMAGE_RESIZE_FILTER_KAISER:
+			// width 3, alpha 4
+			if (x >= 3.0f) return 0.0f;
+			t = x / 3.0f;
+			return Image_sinc(x) * Image_besselI0(4.0f * sqrtf(1.0f - t * t)) / Image_besselI0(4.0f);
+	}
+	return 0.0f;
+}
+
+static float Image_filterSupport(int filter) {
+	switch (filter) {
+		case IMAGE_RESIZE_FILTER_BOX: return 0.5f;
+		case IMAGE_RESIZE_FILTER_TRIANGLE: return 1.0f;
+		default: return 3.0f;
+	}
+}
+
+/**
+ * Weights for resampling one dimension, each destination sample reads `count[i]` source samples from `start[i]`
+ */
+typedef struct {
+	int* start;
+	int* count;
+	float* weights;
+	int maxTaps;
+} ImageResampleWeights;
+
+static int Image_computeResampleWeights(ImageResampleWeights* w, int srcSize, int dstSize, int filter) {
+	float scale = (float) dstSize / srcSize;
+	// when downscaling the filter is stretched to cover every source sample
+	float filterScale = scale < 1.0f ? 1.0f / scale : 1.0f;
+	float radius = Image_filterSupport(filter) * filterScale;
+	int i, j;
+
+	w->maxTaps = (int) ceilf(radius * 2.0f) + 2;
+	w->start = (int*) STBI_MALLOC(sizeof(int) * dstSize);
+	w->count = (int*) STBI_MALLOC(sizeof(int) * dstSize);
+	w->weights = (float*) stbi__malloc_mad3(dstSize, w->maxTaps, sizeof(float), 0);
+	if (w->start == NULL || w->count == NULL || w->weights == NULL) return 0;
+
+	for (i = 0; i < dstSize; i++) {
+		float center = (i + 0.5f) / scale;
+		int left = (int) ceilf(center - radius - 0.5f);
+		int right = (int) floorf(center + radius - 0.5f);
+		float* weights = w->weights + (size_t) i * w->maxTaps;
+		float sum = 0.0f;
+
+		if (left < 0) left = 0;
+		if (right > srcSize - 1) right = srcSize - 1;
+		if (right - left + 1 > w->maxTaps) right = left + w->maxTaps - 1;
+
+		for (j = left; j <= right; j++) {
+			weights[j - left] = Image_filter(filter, ((j + 0.5f) - center) / filterScale);
+			sum += weights[j - left];
+		}
+
+		if (right < left || sum == 0.0f) {
+			// no source samples under the filter, use the nearest
+			left = (int) center;
+			if (left > srcSize - 1) left = srcSize - 1;
+			right = left;
+			weights[0] = sum = 1.0f;
+		}
+
+		for (j = 0; j <= right - left; j++) {
+			weights[j] /= sum;
+		}
+
+		w->start[i] = left;
+		w->count[i] = right - left + 1;
+	}
+
+	return 1;
+}
+
+static void Image_freeResampleWeights(ImageResampleWeights* w) {
+	STBI_FREE(w->start);
+	STBI_FREE(w->count);
+	STBI_FREE(w->weights);
+}
+
+static float Image_linearToSrgb(float v) {
+	if (v <= 0.0031308f) return v * 12.92f;
+	return 1.055f * powf(v, 1.0f / 2.4f) - 0.055f;
+}
+
+void* Image_resize(const void* src, int srcWidth, int srcHeight, int channels, int isFloat, int dstWidth, int dstHeight, int filter, int srgb, int premultipliedAlpha) {
+	int alphaIndex = (channels & 1) ? -1 : channels - 1;
+	int weightByAlpha = alphaIndex != -1 && !premultipliedAlpha;
+	int colorChannels = alphaIndex != -1 ? channels - 1 : channels;
+	size_t srcRowLength = (size_t) srcWidth * channels;
+	size_t dstRowLength = (size_t) dstWidth * channels;
+	float srgbToLinear[256];
+	ImageResampleWeights horizontal = { NULL, NULL, NULL, 0 };
+	ImageResampleWeights vertical = { NULL, NULL, NULL, 0 };
+	float* linear = NULL;
+	float* tmp = NULL;
+	float* row = NULL;
+	void* dst = NULL;
+	void* result = NULL;
+	int x, y, k, j;
+	size_t i;
+
+	if (channels < 1 || channels > 4 || srcWidth < 1 || srcHeight < 1 || dstWidth < 1 || dstHeight < 1) return NULL;
+
+	srgb = srgb && !isFloat;
+
+	dst = isFloat
+		? stbi__malloc_mad4(dstWidth, dstHeight, channels, sizeof(float), 0)
+		: stbi__malloc_mad3(dstWidth, dstHeight, channels, 0);
+	linear = (float*) stbi__malloc_mad4(srcWidth, srcHeight, channels, sizeof(float), 0);
+	tmp = (float*) stbi__malloc_mad4(dstWidth, srcHeight, channels, sizeof(float), 0);
+	row = (float*) stbi__malloc_mad3(dstWidth, channels, sizeof(float), 0);
+	if (dst == NULL || linear == NULL || tmp == NULL || row == NULL) goto done;
+	if (!Image_computeResampleWeights(&horizontal, srcWidth, dstWidth, filter)) goto done;
+	if (!Image_computeResampleWeights(&vertical, srcHeight, dstHeight, filter)) goto done;
+
+	for (k = 0; k < 256; k++) {
+		float v = k / 255.0f;
+		srgbToLinear[k] = srgb ? (v <= 0.04045f ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f)) : v;
+	}
+
+	// decode to linear float, weighting colour by alpha so transparent pixels don't bleed into their neighbours
+	for (i = 0; i < srcRowLength * srcHeight; i += channels) {
+		float a = 1.0f;
+		if (alphaIndex != -1) {
+			a = isFloat ? ((const float*) src)[i + alphaIndex] : ((const stbi_uc*) src)[i + alphaIndex] / 255.0f;
+			linear[i + alphaIndex] = a;
+		}
+		if (!weightByAlpha) a = 1.0f;
+		for (k = 0; k < colorChannels; k++) {
+			float v = isFloat ? ((const float*) src)[i + k] : srgbToLinear[((const stbi_uc*) src)[i + k]];
+			linear[i + k] = v * a;
+		}
+	}
+
+	// horizontal pass
+	for (y = 0; y < srcHeight; y++) {
+		const float* in = linear + srcRowLength * y;
+		float* out = tmp + dstRowLength * y;
+		for (x = 0; x < dstWidth; x++) {
+			const float* weights = horizontal.weights + (size_t) x * horizontal.maxTaps;
+			const float* s = in + (size_t) horizontal.start[x] * channels;
+			float sum[4] = { 0, 0, 0, 0 };
+			for (j = 0; j < horizontal.count[x]; j++, s += channels) {
+				for (k = 0; k < channels; k++) sum[k] += s[k] * weights[j];
+			}
+			for (k = 0; k < channels; k++) out[(size_t) x * channels + k] = sum[k];
+		}
+	}
+
+	// vertical pass then encode
+	for (y = 0; y < dstHeight; y++) {
+		const float* weights = vertical.weights + (size_t) y * vertical.maxTaps;
+		for (i = 0; i < dstRowLength; i++) row[i] = 0.0f;
+		for (j = 0; j < vertical.count[y]; j++) {
+			const float* in = tmp + dstRowLength * (vertical.start[y] + j);
+			float weight = weights[j];
+			for (i = 0; i < dstRowLength; i++) row[i] += in[i] * weight;
+		}
+
+		for (i = 0; i < dstRowLength; i += channels) {
+			float a = alphaIndex != -1 ? row[i + alphaIndex] : 1.0f;
+			float unweight = weightByAlpha && a > 0.0f ? 1.0f / a : 1.0f;
+			for (k = 0; k < channels; k++) {
+				float v = k == alphaIndex ? a : row[i + k] * unweight;
+				size_t index = dstRowLength * y + i + k;
+				if (isFloat) {
+					((float*) dst)[index] = v;
+				} else {
+					if (srgb && k != alphaIndex) v = Image_linearToSrgb(v < 0.0f ? 0.0f : v);
+					v = v * 255.0f + 0.5f;
+					((stbi_uc*) dst)[index] = (stbi_uc) (v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v));
+				}
+			}
+		}
+	}
+
+	result = dst;
+
+done:
+	if (result == NULL) STBI_FREE(dst);
+	Image_freeResampleWeights(&horizontal);
+	Image_freeResampleWeights(&vertical);
+	STBI_FREE(linear);
+	STBI_FREE(tmp);
+	STBI_FREE(row);
+	return result;
+}
+
+void* Image_mapFile(const char* path, int* byteLength) {
+	void* data = NULL;
+	#ifdef _WIN32
+	LARGE_INTEGER size;
+	HANDLE mapping;
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart <= INT_MAX) {
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping != NULL) {
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			// the view keeps the mapping alive
+			CloseHandle(mapping);
+			*byteLength = (int) size.QuadPart;
+		}
+	}
+	CloseHandle(file);
+	#else
+	struct stat fileStat;
+	int fd = open(path, O_RDONLY);
+	if (fd == -1) return NULL;
+	if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 && fileStat.st_size <= INT_MAX) {
+		data = mmap(NULL, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			data = NULL;
+		} else {
+			*byteLength = (int) fileStat.st_size;
+		}
+	}
+	// the mapping remains valid after the descriptor is closed
+	close(fd);
+	#endif
+	return data;
+}
+
+void Image_unmapFile(void* data, int byteLength) {
+	#ifdef _WIN32
+	(void) byteLength;
+	UnmapViewOfFile(data);
+	#else
+	munmap(data, (size_t) byteLength);
+	#endif
+}
@@ -0,0 +1,94 @@
+/**
+ * Pixel helpers used alongside stb_image.h
+ * stb_image's load options (flip, unpremultiply) are process-global because thread-locals are disabled for the iOS toolchain,
+ * so per-image options are applied by these functions after decoding instead
+ * 
+ * @author George Corney (haxiomic)
+ */
+
+#ifndef IMAGE_NATIVE_NATIVE_H
+#define IMAGE_NATIVE_NATIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Flip rows of tightly packed pixels in-place
+ */
+void Image_flipVertically(void* pixels, int width, int height, int bytesPerPixel);
+
+/**
+ * Returns non-zero if the bytes are an iPhone-optimized (CgBI) PNG, these are the only files affected by stbi_set_unpremultiply_on_load
+ */
+int  Image_isIphonePng(const unsigned char* bytes, int byteLength);
+
+/**
+ * Convert tightly packed pixels between channel counts and 8-bit / float channels, optionally flipping rows and premultiplying alpha
+ * Conversions match the results of decoding with stb_image directly into the destination format
+ * Returns a new buffer to be freed with stbi_image_free or NULL if allocation fails
+ */
+void* Image_convertPixels(const void* src, int width, int height, int srcChannels, int srcIsFloat, int dstChannels, int dstIsFloat, int flipY, int premultiplyAlpha);
+
+/**
+ * Equivalent to stbi_load_from_memory or stbi_loadf_from_memory (when isFloat is non-zero), decoding at 1/downscale of the file's resolution (1, 2, 4 or 8)
+ * JPEGs are scaled in the DCT domain, which is faster than a full size decode; other formats are decoded at full size then box filtered with Image_downscale
+ * x and y are set to the reduced size, sizes round up
+ */
+void* Image_loadFromMemory(const unsigned char* bytes, int byteLength, int* x, int* y, int* channelsInFile, int desiredChannels, int isFloat, int downscale);
+
+/**
+ * Box filter downscale by an integer factor, partial blocks at the right and bottom edges are averaged over the pixels they cover
+ * Returns a new buffer to be freed with stbi_image_free or NULL if allocation fails
+ */
+void* Image_downscale(const void* src, int width, int height, int channels, int isFloat, int factor, int* outWidth, int* outHeight);
+
+#define IMAGE_RESIZE_FILTER_BOX 0
+#define IMAGE_RESIZE_FILTER_TRIANGLE 1
+#define IMAGE_RESIZE_FILTER_LANCZOS3 2
+#define IMAGE_RESIZE_FILTER_KAISER 3
+
+/**
+ * Separable resample of tightly packed pixels, the result has the same format
+ * Filtering happens in linear float: 8-bit colour is decoded from sRGB when `srgb` is non-zero and colour is weighted by alpha unless `premultipliedAlpha` is non-zero
+ * Returns a new buffer to be freed with stbi_image_free or NULL on failure
+ */
+void* Image_resize(const void* src, int srcWidth, int srcHeight, int channels, int isFloat, int dstWidth, int dstHeight, int filter, int srgb, int premultipliedAlpha);
+
+/**
+ * Streams an image file into stb_image through stbi_io_callbacks so the encoded file is never fully loaded into memory
+ * A decode can be cancelled from another thread, the decode then fails at its next read
+ */
+typedef struct ImageFileReader ImageFileReader;
+
+/**
+ * Returns NULL if the file cannot be opened
+ */
+ImageFileReader* ImageFileReader_open(const char* path);
+void ImageFileReader_close(ImageFileReader* reader);
+void ImageFileReader_cancel(ImageFileReader* reader);
+int  ImageFileReader_isCancelled(ImageFileReader* reader);
+
+/**
+ * Equivalent to stbi_info, stbi_is_16_bit, stbi_is_hdr and Image_isIphonePng on the file contents
+ * Returns 0 on failure
+ */
+int  ImageFileReader_info(ImageFileReader* reader, int* x, int* y, int* comp, int* is16Bit, int* isHdr, int* isIphonePng);
+
+/**
+ * Equivalent to Image_loadFromMemory on the file contents
+ */
+void* ImageFileReader_load(ImageFileReader* reader, int* x, int* y, int* channelsInFile, int desiredChannels, int isFloat, int downscale);
+
+/**
+ * Map a file read-only into memory, returns NULL on failure
+ * Used for zero-copy loading of texture containers, unmap with Image_unmapFile
+ */
+void* Image_mapFile(const char* path, int* byteLength);
+void Image_unmapFile(void* data, int byteLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,10 @@
 /* stb_image - v2.25 - public domain image loader - http://nothings.org/stb
                                   no warranty implied; use at your own risk
 
+   webcore: this copy of v2.25 is patched to decode JPEGs at 1/2, 1/4 or 1/8 scale in the DCT domain
+   (stbi__context.jpeg_scale_shift), every change is between "webcore patch begin" and "webcore patch end"
+   comments so the patch can be reapplied when updating
+
    Do this:
       #define STB_IMAGE_IMPLEMENTATION
    before you include this file in *one* C or C++ file to create the implementation.
@@ -754,6 +758,10 @@ typedef struct
 
    stbi_uc *img_buffer, *img_buffer_end;
    stbi_uc *img_buffer_original, *img_buffer_original_end;
+
+   // webcore patch begin: log2 of the reduced-size JPEG decode (0 to 3), reset to 0 once the JPEG decoder has applied it
+   int jpeg_scale_shift;
+   // webcore patch end
 } stbi__context;
 
 
@@ -766,6 +774,9 @@ static void stbi__start_mem(stbi__context *s, stbi_uc const *buffer, int len)
    s->read_from_callbacks = 0;
    s->img_buffer = s->img_buffer_original = (stbi_uc *) buffer;
    s->img_buffer_end = s->img_buffer_original_end = (stbi_uc *) buffer+len;
+   // webcore patch begin
+   s->jpeg_scale_shift = 0;
+   // webcore patch end
 }
 
 // initialize a callback-based context
@@ -778,6 +789,9 @@ static void stbi__start_callbacks(stbi__context *s, stbi_io_callbacks *c, void *
    s->img_buffer_original = s->buffer_start;
    stbi__refill_buffer(s);
    s->img_buffer_original_end = s->img_buffer_end;
+   // webcore patch begin
+   s->jpeg_scale_shift = 0;
+   // webcore patch end
 }
 
 #ifndef STBI_NO_STDIO
@@ -1893,6 +1907,10 @@ typedef struct
    int scan_n, order[4];
    int restart_interval, todo;
 
+   // webcore patch begin: blocks are inverse transformed to (8 >> scale_shift) pixels square, component buffers are allocated at this reduced size
+   int scale_shift;
+   // webcore patch end
+
 // kernels
    void (*idct_block_kernel)(stbi_uc *out, int out_stride, short data[64]);
    void (*YCbCr_to_RGB_kernel)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
@@ -2816,6 +2834,71 @@ static stbi_uc stbi__get_marker(stbi__jpeg *j)
 // of the components is specified by order[]
 #define STBI__RESTART(x)     ((x) >= 0xd0 && (x) <= 0xd7)
 
+// webcore patch begin: reduced-size IDCT for decoding at 1/2, 1/4 or 1/8 scale in the DCT domain
+// only the top-left n x n coefficients are used, each output pixel samples the block's inverse
+// transform at the centre of the n x n pixel area it replaces (as libjpeg's scaled IDCTs do)
+// basis[x][u] = C(u)/2 * cos((2x+1) u pi / 2n), C(0) = 1/sqrt(2); for n = 4 the transform is split into even and odd halves
+// as stbi__idct_block does, in the same 12-bit fixed point with 2 extra bits kept between the passes
+#define STBI__IDCT_SCALED_4(s0,s1,s2,s3, o0,o1,o2,o3) \
+   { \
+      int e0 = ((s0) + (s2)) * stbi__f2f(0.353553391f); \
+      int e1 = ((s0) - (s2)) * stbi__f2f(0.353553391f); \
+      int t0 = (s1) * stbi__f2f(0.461939766f) + (s3) * stbi__f2f(0.191341716f); \
+      int t1 = (s1) * stbi__f2f(0.191341716f) - (s3) * stbi__f2f(0.461939766f); \
+      o0 = e0 + t0; o1 = e1 + t1; o2 = e1 - t1; o3 = e0 - t0; \
+   }
+
+static void stbi__idct_block_scaled(stbi_uc *out, int out_stride, short data[64], int n)
+{
+   int tmp[16], i, o0, o1, o2, o3;
+   if (n == 1) {
+      // DC only, the block average
+      out[0] = stbi__clamp(((data[0] + 4) >> 3) + 128);
+      return;
+   }
+   if (n == 2) {
+      // both passes scale by 1/(2 sqrt 2), together 1/8
+      int s = data[0] + data[1], d = data[0] - data[1];
+      int s1 = data[8] + data[9], d1 = data[8] - data[9];
+      out[0] = stbi__clamp(((s + s1 + 4) >> 3) + 128);
+      out[1] = stbi__clamp(((d + d1 + 4) >> 3) + 128);
+      out += out_stride;
+      out[0] = stbi__clamp(((s - s1 + 4) >> 3) + 128);
+      out[1] = stbi__clamp(((d - d1 + 4) >> 3) + 128);
+      return;
+   }
+   // columns
+   for (i=0; i < 4; ++i) {
+      STBI__IDCT_SCALED_4(data[i], data[8+i], data[16+i], data[24+i], o0,o1,o2,o3)
+      tmp[i]    = (o0 + 512) >> 10;
+      tmp[4+i]  = (o1 + 512) >> 10;
+      tmp[8+i]  = (o2 + 512) >> 10;
+      tmp[12+i] = (o3 + 512) >> 10;
+   }
+   // rows, with the level shift and rounding folded into one bias
+   for (i=0; i < 4; ++i, out += out_stride) {
+      const int bias = (128 << 14) + (1 << 13);
+      STBI__IDCT_SCALED_4(tmp[i*4], tmp[i*4+1], tmp[i*4+2], tmp[i*4+3], o0,o1,o2,o3)
+      out[0] = stbi__clamp((o0 + bias) >> 14);
+      out[1] = stbi__clamp((o1 + bias) >> 14);
+      out[2] = stbi__clamp((o2 + bias) >> 14);
+      out[3] = stbi__clamp((o3 + bias) >> 14);
+   }
+}
+
+// inverse transform block (bx, by) of component n into its (possibly reduced-size) component buffer
+static void stbi__jpeg_idct_block(stbi__jpeg *z, int n, int bx, int by, short data[64])
+{
+   int shift = z->scale_shift;
+   int stride = z->img_comp[n].w2 >> shift;
+   stbi_uc *out = z->img_comp[n].data + stride*((by*8) >> shift) + ((bx*8) >> shift);
+   if (shift == 0)
+      z->idct_block_kernel(out, stride, data);
+   else
+      stbi__idct_block_scaled(out, stride, data, 8 >> shift);
+}
+// webcore patch end
+
 // after a restart interval, stbi__jpeg_reset the entropy decoder and
 // the dc prediction
 static void stbi__jpeg_reset(stbi__jpeg *j)
@@ -2849,7 +2932,9 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
             for (i=0; i < w; ++i) {
                int ha = z->img_comp[n].ha;
                if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-               z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+               // webcore patch begin: was z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+               stbi__jpeg_idct_block(z, n, i, j, data);
+               // webcore patch end
                // every data block is an MCU, so countdown the restart interval
                if (--z->todo <= 0) {
                   if (z->code_bits < 24) stbi__grow_buffer_unsafe(z);
@@ -2873,11 +2958,16 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
                   // by the basic H and V specified for the component
                   for (y=0; y < z->img_comp[n].v; ++y) {
                      for (x=0; x < z->img_comp[n].h; ++x) {
-                        int x2 = (i*z->img_comp[n].h + x)*8;
-                        int y2 = (j*z->img_comp[n].v + y)*8;
+                        // webcore patch begin: x2 and y2 were pixel offsets (multiplied by 8), the block's IDCT call was
+                        // z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*y2+x2, z->img_comp[n].w2, data);
+                        int x2 = (i*z->img_comp[n].h + x);
+                        int y2 = (j*z->img_comp[n].v + y);
+                        // webcore patch end
                         int ha = z->img_comp[n].ha;
                         if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-                        z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*y2+x2, z->img_comp[n].w2, data);
+                        // webcore patch begin
+                        stbi__jpeg_idct_block(z, n, x2, y2, data);
+                        // webcore patch end
                      }
                   }
                }
@@ -2974,7 +3064,9 @@ static void stbi__jpeg_finish(stbi__jpeg *z)
             for (i=0; i < w; ++i) {
                short *data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
                stbi__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
-               z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+               // webcore patch begin: was z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+               stbi__jpeg_idct_block(z, n, i, j, data);
+               // webcore patch end
             }
          }
       }
@@ -3209,7 +3301,9 @@ static int stbi__process_frame_header(stbi__jpeg *z, int scan)
       z->img_comp[i].coeff = 0;
       z->img_comp[i].raw_coeff = 0;
       z->img_comp[i].linebuf = NULL;
-      z->img_comp[i].raw_data = stbi__malloc_mad2(z->img_comp[i].w2, z->img_comp[i].h2, 15);
+      // webcore patch begin: was stbi__malloc_mad2(z->img_comp[i].w2, z->img_comp[i].h2, 15)
+      z->img_comp[i].raw_data = stbi__malloc_mad2(z->img_comp[i].w2 >> z->scale_shift, z->img_comp[i].h2 >> z->scale_shift, 15);
+      // webcore patch end
       if (z->img_comp[i].raw_data == NULL)
          return stbi__free_jpeg_components(z, i+1, stbi__err("outofmem", "Out of memory"));
       // align blocks for idct using mmx/sse
@@ -3729,6 +3823,21 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
    // load a jpeg image from whichever source, but leave in YCbCr format
    if (!stbi__decode_jpeg_image(z)) { stbi__cleanup_jpeg(z); return NULL; }
 
+   // webcore patch begin: the components were decoded at reduced size, resample and color-convert at that size
+   if (z->scale_shift) {
+      int i, shift = z->scale_shift;
+      z->s->img_x = (z->s->img_x + (1 << shift) - 1) >> shift;
+      z->s->img_y = (z->s->img_y + (1 << shift) - 1) >> shift;
+      for (i=0; i < z->s->img_n; ++i) {
+         z->img_comp[i].x = (z->s->img_x * z->img_comp[i].h + z->img_h_max-1) / z->img_h_max;
+         z->img_comp[i].y = (z->s->img_y * z->img_comp[i].v + z->img_v_max-1) / z->img_v_max;
+         z->img_comp[i].w2 >>= shift;
+         z->img_comp[i].h2 >>= shift;
+      }
+      z->s->jpeg_scale_shift = 0;
+   }
+   // webcore patch end
+
    // determine actual number of components to generate
    n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
 
@@ -3883,6 +3992,9 @@ static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int re
    stbi__jpeg* j = (stbi__jpeg*) stbi__malloc(sizeof(stbi__jpeg));
    STBI_NOTUSED(ri);
    j->s = s;
+   // webcore patch begin
+   j->scale_shift = s->jpeg_scale_shift;
+   // webcore patch end
    stbi__setup_jpeg(j);
    result = load_jpeg_image(j, x,y,comp,req_comp);
    STBI_FREE(j);
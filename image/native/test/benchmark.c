@@ -0,0 +1,745 @@
+/**
+ * Decode, conversion and resize benchmarks for the native image layer
+ *
+ * Each benchmark calls the functions in image/native/native.c the way the Haxe classes do:
+ *   BM_DecodePool        200 JPEG and PNG decodes spread over 1, 2, 4 and 8 workers of a pool like DecodePool
+ *   BM_Reformat*         deriving another pixel layout from the cached decode with Image_convertPixels vs decoding the file again
+ *   BM_LoadPeakMemory    peak memory while loading an 8192x8192 PNG from a buffer holding the whole file, a streamed file or a mapped file
+ *   BM_JpegDownscale     JPEG decoded at 1/2, 1/4 and 1/8 size in the DCT domain vs a full size decode box filtered down
+ *   BM_MipChain          full mipmap chain of a 2048x2048 RGBA image per Image_resize filter, each level filtered from the one above
+ *
+ * The corpus is _example/assets/image/red-panda.jpg (or the JPEG passed with --jpeg=<file>) and an RGBA PNG of the same pixels, encoded with
+ * zlib when the benchmarks start
+ *
+ * Output follows Google Benchmark's console format so results can be compared across commits:
+ *   ./benchmark                 table on stdout
+ *   ./benchmark --json > a.json results as JSON
+ *   ./benchmark --filter=Decode only benchmarks whose name contains the filter
+ *   ./benchmark --min-time=2    run each benchmark for at least 2 seconds
+ *   ./benchmark --jpeg=<file>   use another JPEG as the corpus
+ *
+ * Limitation: compiled Haxe code can't be linked into this harness, so DecodePool's worker pool and Image.getData's choice between converting
+ * cached pixels and decoding the file again are re-implemented here in C by hand (native.c is the real code). Results measure the native work
+ * those classes schedule, and each re-implementation must be kept in step with its class by hand when the class changes
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zlib.h>
+
+#define STBI_NO_STDIO
+#include "../stb_image.h"
+#include "../native.h"
+
+#define MAX_COUNTERS 4
+#define DEFAULT_JPEG_PATH "../../../_example/assets/image/red-panda.jpg"
+#define PNG_IDAT_SIZE (1 << 20)
+
+#define bench_countof(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef enum {
+	COUNTER_PER_ITERATION,
+	// per cpu second, all threads included
+	COUNTER_RATE,
+	// per wall clock second, for work spread over threads
+	COUNTER_WALL_RATE,
+} CounterKind;
+
+typedef struct {
+	const char* name;
+	double value;
+	CounterKind kind;
+} Counter;
+
+typedef struct {
+	const char* name;
+	int n;
+	const char* variant;
+	int option;
+	void* (*setup)(int n, int option);
+	void (*iteration)(void* state);
+	void (*teardown)(void* state);
+} Benchmark;
+
+static Counter counters[MAX_COUNTERS];
+static int counterCount = 0;
+
+// counters are registered by setup and reset for each benchmark
+static double* addCounter(const char* name, CounterKind kind) {
+	counters[counterCount].name = name;
+	counters[counterCount].value = 0;
+	counters[counterCount].kind = kind;
+	return &counters[counterCount++].value;
+}
+
+static double Counter_report(const Counter* counter, unsigned long long iterations, double wallElapsed, double cpuElapsed) {
+	switch (counter->kind) {
+		case COUNTER_RATE: return counter->value / cpuElapsed;
+		case COUNTER_WALL_RATE: return counter->value / wallElapsed;
+		default: return counter->value / (double) iterations;
+	}
+}
+
+static double nowSeconds(clockid_t clock) {
+	struct timespec t;
+	clock_gettime(clock, &t);
+	return (double) t.tv_sec + (double) t.tv_nsec * 1e-9;
+}
+
+/**
+ * Corpus
+ */
+
+typedef struct {
+	unsigned char* bytes;
+	int byteLength;
+} EncodedImage;
+
+static const char* jpegPath = DEFAULT_JPEG_PATH;
+static EncodedImage corpusJpeg;
+static EncodedImage corpusPng;
+
+static unsigned char* readFile(const char* path, int* byteLength) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL) return NULL;
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	unsigned char* bytes = (unsigned char*) malloc(length);
+	if (bytes != NULL && fread(bytes, 1, length, file) != (size_t) length) {
+		free(bytes);
+		bytes = NULL;
+	}
+	fclose(file);
+	*byteLength = (int) length;
+	return bytes;
+}
+
+// fills one row of 8-bit pixels
+typedef void (*PngRowCallback)(void* user, int y, unsigned char* row);
+
+static void Png_putUint32(unsigned char* p, unsigned int v) {
+	p[0] = (unsigned char) (v >> 24);
+	p[1] = (unsigned char) (v >> 16);
+	p[2] = (unsigned char) (v >> 8);
+	p[3] = (unsigned char) v;
+}
+
+static void Png_writeChunk(FILE* file, const char* type, const unsigned char* data, unsigned int length) {
+	unsigned char header[8];
+	unsigned char footer[4];
+	Png_putUint32(header, length);
+	memcpy(header + 4, type, 4);
+	uLong crc = crc32(0, header + 4, 4);
+	if (length > 0) crc = crc32(crc, data, length);
+	Png_putUint32(footer, (unsigned int) crc);
+	fwrite(header, 1, sizeof(header), file);
+	if (length > 0) fwrite(data, 1, length, file);
+	fwrite(footer, 1, sizeof(footer), file);
+}
+
+/**
+ * Writes an 8-bit RGB or RGBA PNG without row filters, rows are produced by `row` one at a time so large images are never held whole
+ * Returns 0 on failure
+ */
+static int writePng(FILE* file, int width, int height, int channels, int level, PngRowCallback row, void* user) {
+	static const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+	unsigned char ihdr[13];
+	Png_putUint32(ihdr, width);
+	Png_putUint32(ihdr + 4, height);
+	ihdr[8] = 8;
+	ihdr[9] = channels == 4 ? 6 : 2;
+	ihdr[10] = ihdr[11] = ihdr[12] = 0;
+	fwrite(signature, 1, sizeof(signature), file);
+	Png_writeChunk(file, "IHDR", ihdr, sizeof(ihdr));
+
+	size_t rowSize = 1 + (size_t) width * channels;
+	unsigned char* rowBuffer = (unsigned char*) malloc(rowSize);
+	unsigned char* out = (unsigned char*) malloc(PNG_IDAT_SIZE);
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (rowBuffer == NULL || out == NULL || deflateInit(&stream, level) != Z_OK) {
+		free(rowBuffer);
+		free(out);
+		return 0;
+	}
+
+	for (int y = 0; y <= height; y++) {
+		int flush = Z_NO_FLUSH;
+		if (y < height) {
+			// filter type 0, none
+			rowBuffer[0] = 0;
+			row(user, y, rowBuffer + 1);
+			stream.next_in = rowBuffer;
+			stream.avail_in = (uInt) rowSize;
+		} else {
+			flush = Z_FINISH;
+		}
+		do {
+			stream.next_out = out;
+			stream.avail_out = PNG_IDAT_SIZE;
+			deflate(&stream, flush);
+			unsigned int produced = PNG_IDAT_SIZE - stream.avail_out;
+			if (produced > 0) Png_writeChunk(file, "IDAT", out, produced);
+		} while (stream.avail_out == 0);
+	}
+
+	Png_writeChunk(file, "IEND", NULL, 0);
+	deflateEnd(&stream);
+	free(rowBuffer);
+	free(out);
+	return ferror(file) == 0;
+}
+
+typedef struct {
+	const unsigned char* pixels;
+	int width;
+	int height;
+} CorpusPixels;
+
+// the JPEG's colour with alpha fading out to the right, so the PNG has an alpha channel worth keeping
+static void corpusPngRow(void* user, int y, unsigned char* row) {
+	CorpusPixels* corpus = (CorpusPixels*) user;
+	const unsigned char* src = corpus->pixels + (size_t) y * corpus->width * 3;
+	for (int x = 0; x < corpus->width; x++, src += 3, row += 4) {
+		row[0] = src[0];
+		row[1] = src[1];
+		row[2] = src[2];
+		row[3] = (unsigned char) (255 - x * 128 / corpus->width);
+	}
+}
+
+static int loadCorpus() {
+	corpusJpeg.bytes = readFile(jpegPath, &corpusJpeg.byteLength);
+	if (corpusJpeg.bytes == NULL) {
+		fprintf(stderr, "Failed to read %s\n", jpegPath);
+		return 0;
+	}
+
+	CorpusPixels corpus;
+	int channelsInFile;
+	corpus.pixels = (unsigned char*) Image_loadFromMemory(corpusJpeg.bytes, corpusJpeg.byteLength, &corpus.width, &corpus.height, &channelsInFile, 3, 0, 1);
+	if (corpus.pixels == NULL) {
+		fprintf(stderr, "Failed to decode %s\n", jpegPath);
+		return 0;
+	}
+
+	char* pngBytes = NULL;
+	size_t pngByteLength = 0;
+	FILE* file = open_memstream(&pngBytes, &pngByteLength);
+	int written = file != NULL && writePng(file, corpus.width, corpus.height, 4, Z_DEFAULT_COMPRESSION, corpusPngRow, &corpus);
+	if (file != NULL) fclose(file);
+	stbi_image_free((void*) corpus.pixels);
+	if (!written) {
+		fprintf(stderr, "Failed to encode the corpus PNG\n");
+		return 0;
+	}
+	corpusPng.bytes = (unsigned char*) pngBytes;
+	corpusPng.byteLength = (int) pngByteLength;
+	return 1;
+}
+
+/**
+ * BM_DecodePool
+ * Workers take jobs from a shared queue in submission order as DecodePool's do, each job decodes one corpus image to RGBA as Image.decodeImageData does
+ */
+
+#define DECODE_POOL_MAX_WORKERS 8
+
+typedef struct {
+	int n;
+	pthread_mutex_t mutex;
+	pthread_cond_t jobsAvailable;
+	pthread_cond_t jobsFinished;
+	pthread_t workers[DECODE_POOL_MAX_WORKERS];
+	int workerCount;
+	// jobs not yet taken by a worker
+	int queuedJobs;
+	int nextJob;
+	int unfinishedJobs;
+	int quit;
+	double* decoded;
+} DecodePool;
+
+static void decodeCorpusImage(int index) {
+	const EncodedImage* image = (index & 1) ? &corpusPng : &corpusJpeg;
+	int width, height, channelsInFile;
+	void* pixels = Image_loadFromMemory(image->bytes, image->byteLength, &width, &height, &channelsInFile, 4, 0, 1);
+	stbi_image_free(pixels);
+}
+
+static void* DecodePool_workerLoop(void* user) {
+	DecodePool* pool = (DecodePool*) user;
+	pthread_mutex_lock(&pool->mutex);
+	while (1) {
+		while (pool->queuedJobs == 0 && !pool->quit) pthread_cond_wait(&pool->jobsAvailable, &pool->mutex);
+		if (pool->quit) break;
+		int job = pool->nextJob++;
+		pool->queuedJobs--;
+		pthread_mutex_unlock(&pool->mutex);
+
+		decodeCorpusImage(job);
+
+		pthread_mutex_lock(&pool->mutex);
+		if (--pool->unfinishedJobs == 0) pthread_cond_signal(&pool->jobsFinished);
+	}
+	pthread_mutex_unlock(&pool->mutex);
+	return NULL;
+}
+
+static void* DecodePool_setup(int n, int workers) {
+	DecodePool* pool = (DecodePool*) calloc(1, sizeof(DecodePool));
+	pool->n = n;
+	pthread_mutex_init(&pool->mutex, NULL);
+	pthread_cond_init(&pool->jobsAvailable, NULL);
+	pthread_cond_init(&pool->jobsFinished, NULL);
+	// DecodePool starts workers on demand and keeps them, the warm up iteration would have started all of them
+	pool->workerCount = workers;
+	for (int i = 0; i < workers; i++) pthread_create(&pool->workers[i], NULL, DecodePool_workerLoop, pool);
+	pool->decoded = addCounter("images_per_second", COUNTER_WALL_RATE);
+	return pool;
+}
+
+static void DecodePool_iteration(void* state) {
+	DecodePool* pool = (DecodePool*) state;
+	pthread_mutex_lock(&pool->mutex);
+	pool->nextJob = 0;
+	pool->queuedJobs = pool->n;
+	pool->unfinishedJobs = pool->n;
+	pthread_cond_broadcast(&pool->jobsAvailable);
+	while (pool->unfinishedJobs > 0) pthread_cond_wait(&pool->jobsFinished, &pool->mutex);
+	pthread_mutex_unlock(&pool->mutex);
+	*pool->decoded += pool->n;
+}
+
+static void DecodePool_teardown(void* state) {
+	DecodePool* pool = (DecodePool*) state;
+	pthread_mutex_lock(&pool->mutex);
+	pool->quit = 1;
+	pthread_cond_broadcast(&pool->jobsAvailable);
+	pthread_mutex_unlock(&pool->mutex);
+	for (int i = 0; i < pool->workerCount; i++) pthread_join(pool->workers[i], NULL);
+	pthread_cond_destroy(&pool->jobsFinished);
+	pthread_cond_destroy(&pool->jobsAvailable);
+	pthread_mutex_destroy(&pool->mutex);
+	free(pool);
+}
+
+/**
+ * BM_Reformat*
+ * The image holds the RGBA 8-bit pixels it decoded for its first upload and another layout is requested. Image.getData converts the cached
+ * pixels, before user-032 it decoded the file again, flipping and premultiplying after the decode
+ */
+
+typedef enum {
+	REFORMAT_RGB8,
+	REFORMAT_FLOAT,
+	REFORMAT_FLIP_PREMULTIPLY,
+} ReformatConversion;
+
+#define REFORMAT_PNG 0x10
+#define REFORMAT_REDECODE 0x20
+
+typedef struct {
+	const EncodedImage* source;
+	int redecode;
+	int channels;
+	int isFloat;
+	int flipY;
+	int premultiplyAlpha;
+	void* cached;
+	int width;
+	int height;
+	double* bytes;
+} Reformat;
+
+static void* Reformat_setup(int n, int option) {
+	Reformat* reformat = (Reformat*) calloc(1, sizeof(Reformat));
+	reformat->source = (option & REFORMAT_PNG) ? &corpusPng : &corpusJpeg;
+	reformat->redecode = (option & REFORMAT_REDECODE) != 0;
+	switch ((ReformatConversion) (option & 0xf)) {
+		case REFORMAT_RGB8: reformat->channels = 3; break;
+		case REFORMAT_FLOAT: reformat->channels = 4; reformat->isFloat = 1; break;
+		case REFORMAT_FLIP_PREMULTIPLY: reformat->channels = 4; reformat->flipY = 1; reformat->premultiplyAlpha = 1; break;
+	}
+	int channelsInFile;
+	reformat->cached = Image_loadFromMemory(reformat->source->bytes, reformat->source->byteLength, &reformat->width, &reformat->height, &channelsInFile, 4, 0, 1);
+	reformat->bytes = addCounter("bytes_per_second", COUNTER_RATE);
+	return reformat;
+}
+
+static void Reformat_iteration(void* state) {
+	Reformat* reformat = (Reformat*) state;
+	int bytesPerPixel = reformat->channels * (reformat->isFloat ? sizeof(float) : 1);
+	void* pixels;
+	if (reformat->redecode) {
+		int width, height, channelsInFile;
+		pixels = Image_loadFromMemory(reformat->source->bytes, reformat->source->byteLength, &width, &height, &channelsInFile, reformat->channels, reformat->isFloat, 1);
+		if (reformat->flipY) Image_flipVertically(pixels, width, height, bytesPerPixel);
+		if (reformat->premultiplyAlpha) {
+			void* premultiplied = Image_convertPixels(pixels, width, height, reformat->channels, reformat->isFloat, reformat->channels, reformat->isFloat, 0, 1);
+			stbi_image_free(pixels);
+			pixels = premultiplied;
+		}
+	} else {
+		pixels = Image_convertPixels(reformat->cached, reformat->width, reformat->height, 4, 0, reformat->channels, reformat->isFloat, reformat->flipY, reformat->premultiplyAlpha);
+	}
+	stbi_image_free(pixels);
+	*reformat->bytes += (double) reformat->width * reformat->height * bytesPerPixel;
+}
+
+static void Reformat_teardown(void* state) {
+	Reformat* reformat = (Reformat*) state;
+	stbi_image_free(reformat->cached);
+	free(reformat);
+}
+
+/**
+ * BM_LoadPeakMemory
+ * Peak resident memory while loading an 8192x8192 RGBA PNG, above what was resident before the load. The decoded pixels alone are 256MB
+ *   buffer  the whole file read into memory first, as Image.decodeImageData does with an ArrayBuffer
+ *   stream  read through ImageFileReader as stb_image asks for it
+ *   mapped  Image_mapFile, pages of the file are resident once stb_image has read them
+ * Peak memory is read from /proc/self/status after resetting it through /proc/self/clear_refs, so it's only reported on Linux
+ */
+
+#define PEAK_PNG_SIZE 8192
+#define PEAK_PNG_PATH "build/peak_8192.png"
+
+typedef enum {
+	LOAD_BUFFER,
+	LOAD_STREAM,
+	LOAD_MAPPED,
+} LoadMode;
+
+typedef struct {
+	LoadMode mode;
+	double* peakMb;
+	double* fileMb;
+	int fileByteLength;
+} LoadPeakMemory;
+
+// a gradient with noise in the low bits, compresses about as well as a photo
+static void peakPngRow(void* user, int y, unsigned char* row) {
+	unsigned int noise = (unsigned int) y * 2654435761u;
+	for (int x = 0; x < PEAK_PNG_SIZE; x++, row += 4) {
+		noise = noise * 1664525u + 1013904223u;
+		row[0] = (unsigned char) ((x >> 5) + ((noise >> 24) & 15));
+		row[1] = (unsigned char) ((y >> 5) + ((noise >> 28) & 15));
+		row[2] = (unsigned char) ((x + y) >> 6);
+		row[3] = 255;
+	}
+}
+
+// returns the value of a kB field of /proc/self/status, 0 if it can't be read
+static double readStatusKb(const char* field) {
+	FILE* file = fopen("/proc/self/status", "r");
+	if (file == NULL) return 0;
+	char line[256];
+	size_t fieldLength = strlen(field);
+	double kb = 0;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (strncmp(line, field, fieldLength) == 0) {
+			kb = atof(line + fieldLength);
+			break;
+		}
+	}
+	fclose(file);
+	return kb;
+}
+
+static void resetPeakMemory() {
+	FILE* file = fopen("/proc/self/clear_refs", "w");
+	if (file == NULL) return;
+	fputs("5", file);
+	fclose(file);
+}
+
+static void* LoadPeakMemory_setup(int n, int mode) {
+	LoadPeakMemory* load = (LoadPeakMemory*) calloc(1, sizeof(LoadPeakMemory));
+	load->mode = (LoadMode) mode;
+	FILE* file = fopen(PEAK_PNG_PATH, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "Writing %dx%d PNG to %s\n", PEAK_PNG_SIZE, PEAK_PNG_SIZE, PEAK_PNG_PATH);
+		file = fopen(PEAK_PNG_PATH, "wb");
+		if (file == NULL || !writePng(file, PEAK_PNG_SIZE, PEAK_PNG_SIZE, 4, Z_BEST_SPEED, peakPngRow, NULL)) {
+			fprintf(stderr, "Failed to write %s\n", PEAK_PNG_PATH);
+			exit(1);
+		}
+		fclose(file);
+		file = fopen(PEAK_PNG_PATH, "rb");
+	}
+	fseek(file, 0, SEEK_END);
+	load->fileByteLength = (int) ftell(file);
+	fclose(file);
+	load->peakMb = addCounter("peak_mb", COUNTER_PER_ITERATION);
+	load->fileMb = addCounter("file_mb", COUNTER_PER_ITERATION);
+	return load;
+}
+
+static void LoadPeakMemory_iteration(void* state) {
+	LoadPeakMemory* load = (LoadPeakMemory*) state;
+	resetPeakMemory();
+	double residentKb = readStatusKb("VmRSS:");
+
+	int width, height, channelsInFile, byteLength;
+	void* pixels = NULL;
+	switch (load->mode) {
+		case LOAD_BUFFER: {
+			unsigned char* bytes = readFile(PEAK_PNG_PATH, &byteLength);
+			pixels = Image_loadFromMemory(bytes, byteLength, &width, &height, &channelsInFile, 4, 0, 1);
+			free(bytes);
+		} break;
+		case LOAD_STREAM: {
+			ImageFileReader* reader = ImageFileReader_open(PEAK_PNG_PATH);
+			pixels = ImageFileReader_load(reader, &width, &height, &channelsInFile, 4, 0, 1);
+			ImageFileReader_close(reader);
+		} break;
+		case LOAD_MAPPED: {
+			void* bytes = Image_mapFile(PEAK_PNG_PATH, &byteLength);
+			pixels = Image_loadFromMemory((const unsigned char*) bytes, byteLength, &width, &height, &channelsInFile, 4, 0, 1);
+			Image_unmapFile(bytes, byteLength);
+		} break;
+	}
+	if (pixels == NULL) {
+		fprintf(stderr, "Failed to load %s: %s\n", PEAK_PNG_PATH, stbi_failure_reason());
+		exit(1);
+	}
+
+	*load->peakMb += (readStatusKb("VmHWM:") - residentKb) / 1024.0;
+	*load->fileMb += load->fileByteLength / (1024.0 * 1024.0);
+	stbi_image_free(pixels);
+}
+
+static void LoadPeakMemory_teardown(void* state) {
+	free(state);
+}
+
+/**
+ * BM_JpegDownscale
+ * The corpus JPEG decoded to RGBA at 1/n size
+ *   dct       Image_loadFromMemory's downscale, the JPEG is scaled in the DCT domain
+ *   full_box  a full size decode box filtered with Image_downscale, as every other format is
+ */
+
+#define DOWNSCALE_FULL_BOX 1
+
+typedef struct {
+	int factor;
+	int fullBox;
+	double* decoded;
+} JpegDownscale;
+
+static void* JpegDownscale_setup(int n, int option) {
+	JpegDownscale* downscale = (JpegDownscale*) calloc(1, sizeof(JpegDownscale));
+	downscale->factor = n;
+	downscale->fullBox = option == DOWNSCALE_FULL_BOX;
+	downscale->decoded = addCounter("images_per_second", COUNTER_RATE);
+	return downscale;
+}
+
+static void JpegDownscale_iteration(void* state) {
+	JpegDownscale* downscale = (JpegDownscale*) state;
+	int width, height, channelsInFile;
+	void* pixels;
+	if (downscale->fullBox) {
+		void* full = Image_loadFromMemory(corpusJpeg.bytes, corpusJpeg.byteLength, &width, &height, &channelsInFile, 4, 0, 1);
+		pixels = Image_downscale(full, width, height, 4, 0, downscale->factor, &width, &height);
+		stbi_image_free(full);
+	} else {
+		pixels = Image_loadFromMemory(corpusJpeg.bytes, corpusJpeg.byteLength, &width, &height, &channelsInFile, 4, 0, downscale->factor);
+	}
+	stbi_image_free(pixels);
+	(*downscale->decoded)++;
+}
+
+static void JpegDownscale_teardown(void* state) {
+	free(state);
+}
+
+/**
+ * BM_MipChain
+ * Every level down to 1x1 of an RGBA 8-bit image with an alpha gradient, each filtered from the level above as Image.generateMipmaps does.
+ * Colour is sRGB and weighted by alpha (the defaults) except for the `_linear` variant
+ */
+
+#define MIP_CHAIN_LINEAR 0x10
+
+typedef struct {
+	int size;
+	int filter;
+	int srgb;
+	unsigned char* pixels;
+	double* bytes;
+} MipChain;
+
+static void* MipChain_setup(int n, int option) {
+	MipChain* chain = (MipChain*) calloc(1, sizeof(MipChain));
+	chain->size = n;
+	chain->filter = option & 0xf;
+	chain->srgb = (option & MIP_CHAIN_LINEAR) == 0;
+	chain->pixels = (unsigned char*) malloc((size_t) n * n * 4);
+	for (int y = 0; y < n; y++) {
+		unsigned char* row = chain->pixels + (size_t) y * n * 4;
+		for (int x = 0; x < n; x++, row += 4) {
+			row[0] = (unsigned char) (x ^ y);
+			row[1] = (unsigned char) (x * 255 / n);
+			row[2] = (unsigned char) (y * 255 / n);
+			row[3] = (unsigned char) (((x >> 4) ^ (y >> 4)) & 1 ? 255 : x * 255 / n);
+		}
+	}
+	chain->bytes = addCounter("bytes_per_second", COUNTER_RATE);
+	return chain;
+}
+
+static void MipChain_iteration(void* state) {
+	MipChain* chain = (MipChain*) state;
+	void* level = chain->pixels;
+	int width = chain->size;
+	int height = chain->size;
+	while (width > 1 || height > 1) {
+		int nextWidth = width > 1 ? width >> 1 : 1;
+		int nextHeight = height > 1 ? height >> 1 : 1;
+		void* next = Image_resize(level, width, height, 4, 0, nextWidth, nextHeight, chain->filter, chain->srgb, 0);
+		if (level != chain->pixels) stbi_image_free(level);
+		level = next;
+		width = nextWidth;
+		height = nextHeight;
+	}
+	stbi_image_free(level);
+	*chain->bytes += (double) chain->size * chain->size * 4;
+}
+
+static void MipChain_teardown(void* state) {
+	MipChain* chain = (MipChain*) state;
+	free(chain->pixels);
+	free(chain);
+}
+
+static void runBenchmark(const Benchmark* benchmark, double minTime, int json, int last) {
+	counterCount = 0;
+	void* state = benchmark->setup(benchmark->n, benchmark->option);
+
+	// warm up caches, allocations and worker threads
+	benchmark->iteration(state);
+	for (int i = 0; i < counterCount; i++) counters[i].value = 0;
+
+	unsigned long long iterations = 0;
+	double wallStart = nowSeconds(CLOCK_MONOTONIC);
+	double cpuStart = nowSeconds(CLOCK_PROCESS_CPUTIME_ID);
+	double wallElapsed;
+	do {
+		benchmark->iteration(state);
+		iterations++;
+		wallElapsed = nowSeconds(CLOCK_MONOTONIC) - wallStart;
+	} while (wallElapsed < minTime);
+	double cpuElapsed = nowSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart;
+
+	benchmark->teardown(state);
+
+	double wallNs = wallElapsed * 1e9 / (double) iterations;
+	double cpuNs = cpuElapsed * 1e9 / (double) iterations;
+
+	char name[96];
+	snprintf(name, sizeof(name), "%s/%d/%s", benchmark->name, benchmark->n, benchmark->variant);
+	if (json) {
+		printf("    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.0f, \"cpu_time\": %.0f, \"time_unit\": \"ns\"", name, iterations, wallNs, cpuNs);
+		for (int i = 0; i < counterCount; i++) {
+			printf(", \"%s\": %.1f", counters[i].name, Counter_report(&counters[i], iterations, wallElapsed, cpuElapsed));
+		}
+		printf("}%s\n", last ? "" : ",");
+	} else {
+		printf("%-44s %12.0f ns %12.0f ns %10llu", name, wallNs, cpuNs, iterations);
+		for (int i = 0; i < counterCount; i++) {
+			double value = Counter_report(&counters[i], iterations, wallElapsed, cpuElapsed);
+			if (counters[i].kind == COUNTER_PER_ITERATION) {
+				printf(" %s=%.1f", counters[i].name, value);
+			} else if (value >= 1e6) {
+				printf(" %s=%.4gM", counters[i].name, value * 1e-6);
+			} else {
+				printf(" %s=%.4g", counters[i].name, value);
+			}
+		}
+		printf("\n");
+	}
+	fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+	int json = 0;
+	double minTime = 0.5;
+	const char* filter = NULL;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) json = 1;
+		if (strncmp(argv[i], "--min-time=", 11) == 0) minTime = atof(argv[i] + 11);
+		if (strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+		if (strncmp(argv[i], "--jpeg=", 7) == 0) jpegPath = argv[i] + 7;
+	}
+
+	const Benchmark benchmarks[] = {
+		{ "BM_DecodePool", 200, "workers:1", 1, DecodePool_setup, DecodePool_iteration, DecodePool_teardown },
+		{ "BM_DecodePool", 200, "workers:2", 2, DecodePool_setup, DecodePool_iteration, DecodePool_teardown },
+		{ "BM_DecodePool", 200, "workers:4", 4, DecodePool_setup, DecodePool_iteration, DecodePool_teardown },
+		{ "BM_DecodePool", 200, "workers:8", 8, DecodePool_setup, DecodePool_iteration, DecodePool_teardown },
+		{ "BM_ReformatRgb8", 1, "jpeg_convert", REFORMAT_RGB8, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatRgb8", 1, "jpeg_redecode", REFORMAT_RGB8 | REFORMAT_REDECODE, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatRgb8", 1, "png_convert", REFORMAT_RGB8 | REFORMAT_PNG, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatRgb8", 1, "png_redecode", REFORMAT_RGB8 | REFORMAT_PNG | REFORMAT_REDECODE, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFloat", 1, "jpeg_convert", REFORMAT_FLOAT, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFloat", 1, "jpeg_redecode", REFORMAT_FLOAT | REFORMAT_REDECODE, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFloat", 1, "png_convert", REFORMAT_FLOAT | REFORMAT_PNG, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFloat", 1, "png_redecode", REFORMAT_FLOAT | REFORMAT_PNG | REFORMAT_REDECODE, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFlipPremultiply", 1, "jpeg_convert", REFORMAT_FLIP_PREMULTIPLY, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFlipPremultiply", 1, "jpeg_redecode", REFORMAT_FLIP_PREMULTIPLY | REFORMAT_REDECODE, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFlipPremultiply", 1, "png_convert", REFORMAT_FLIP_PREMULTIPLY | REFORMAT_PNG, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_ReformatFlipPremultiply", 1, "png_redecode", REFORMAT_FLIP_PREMULTIPLY | REFORMAT_PNG | REFORMAT_REDECODE, Reformat_setup, Reformat_iteration, Reformat_teardown },
+		{ "BM_LoadPeakMemory", PEAK_PNG_SIZE, "buffer", LOAD_BUFFER, LoadPeakMemory_setup, LoadPeakMemory_iteration, LoadPeakMemory_teardown },
+		{ "BM_LoadPeakMemory", PEAK_PNG_SIZE, "stream", LOAD_STREAM, LoadPeakMemory_setup, LoadPeakMemory_iteration, LoadPeakMemory_teardown },
+		{ "BM_LoadPeakMemory", PEAK_PNG_SIZE, "mapped", LOAD_MAPPED, LoadPeakMemory_setup, LoadPeakMemory_iteration, LoadPeakMemory_teardown },
+		{ "BM_JpegDownscale", 1, "full", 0, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_JpegDownscale", 2, "dct", 0, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_JpegDownscale", 2, "full_box", DOWNSCALE_FULL_BOX, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_JpegDownscale", 4, "dct", 0, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_JpegDownscale", 4, "full_box", DOWNSCALE_FULL_BOX, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_JpegDownscale", 8, "dct", 0, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_JpegDownscale", 8, "full_box", DOWNSCALE_FULL_BOX, JpegDownscale_setup, JpegDownscale_iteration, JpegDownscale_teardown },
+		{ "BM_MipChain", 2048, "box", IMAGE_RESIZE_FILTER_BOX, MipChain_setup, MipChain_iteration, MipChain_teardown },
+		{ "BM_MipChain", 2048, "box_linear", IMAGE_RESIZE_FILTER_BOX | MIP_CHAIN_LINEAR, MipChain_setup, MipChain_iteration, MipChain_teardown },
+		{ "BM_MipChain", 2048, "triangle", IMAGE_RESIZE_FILTER_TRIANGLE, MipChain_setup, MipChain_iteration, MipChain_teardown },
+		{ "BM_MipChain", 2048, "lanczos3", IMAGE_RESIZE_FILTER_LANCZOS3, MipChain_setup, MipChain_iteration, MipChain_teardown },
+		{ "BM_MipChain", 2048, "kaiser", IMAGE_RESIZE_FILTER_KAISER, MipChain_setup, MipChain_iteration, MipChain_teardown },
+	};
+
+	// select benchmarks first so the last JSON entry has no trailing comma
+	const Benchmark* selected[bench_countof(benchmarks)];
+	size_t selectedCount = 0;
+	for (size_t i = 0; i < bench_countof(benchmarks); i++) {
+		if (filter != NULL && strstr(benchmarks[i].name, filter) == NULL) continue;
+		selected[selectedCount++] = &benchmarks[i];
+	}
+
+	if (!loadCorpus()) return 1;
+
+	if (json) {
+		printf("{\n  \"context\": {\"jpeg\": \"%s\", \"jpeg_bytes\": %d, \"png_bytes\": %d},\n  \"benchmarks\": [\n", jpegPath, corpusJpeg.byteLength, corpusPng.byteLength);
+	} else {
+		printf("%-44s %15s %15s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+		printf("----------------------------------------------------------------------------------------------------\n");
+	}
+
+	for (size_t i = 0; i < selectedCount; i++) {
+		runBenchmark(selected[i], minTime, json, i == selectedCount - 1);
+	}
+
+	if (json) {
+		printf("  ]\n}\n");
+	}
+
+	free(corpusJpeg.bytes);
+	free(corpusPng.bytes);
+	return 0;
+}
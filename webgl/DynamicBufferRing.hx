@@ -0,0 +1,139 @@
+package webgl;
+
+import webgl.GLContext;
+import typedarray.ArrayBuffer;
+import typedarray.Float32Array;
+import typedarray.Uint8Array;
+
+/**
+	Streams geometry that is rebuilt every frame without the driver stalling on buffers the GPU is still reading
+
+	Vertex data is written straight into `floats` at the offset returned by `allocate()` and sent with `upload()`, which only copies the bytes written since the last upload.
+	Allocations fill one of `bufferCount` large buffers in turn; when a buffer is full the next one is orphaned with `bufferDataOfSize()` so the driver can hand back fresh storage instead of waiting.
+	Nothing is allocated per frame on native or on WebGL2; WebGL1 has no range upload so there each `upload()` creates a `subarray()`
+
+	Write every allocation of a batch first and call `upload()` once before drawing it. Each `upload()` is a `bufferSubData()` call, and one per draw costs more than the `bufferData()` per draw this replaces.
+	When `allocate()` moves to the next buffer, earlier allocations stay in the previous one, so keep `buffer` with each allocation or make `bufferByteLength` large enough for a frame
+
+	```haxe
+	for (sprite in sprites) {
+		sprite.offset = ring.allocate(sprite.vertexCount * VERTEX_BYTES);
+		sprite.buffer = ring.buffer;
+		var i = sprite.offset >> 2;
+		for (vertex in sprite.vertices) {
+			ring.floats[i++] = vertex.x;
+			ring.floats[i++] = vertex.y;
+		}
+	}
+	ring.upload();
+	for (sprite in sprites) {
+		gl.bindBuffer(ARRAY_BUFFER, sprite.buffer);
+		gl.vertexAttribPointer(0, 2, FLOAT, false, VERTEX_BYTES, sprite.offset);
+		gl.drawArrays(TRIANGLES, 0, sprite.vertexCount);
+	}
+	```
+**/
+class DynamicBufferRing {
+
+	public final target: BufferTarget;
+	public final buffers: Array<GLBuffer>;
+
+	/**
+		Buffer that allocations are currently made from, changes when `allocate()` wraps
+	**/
+	public var buffer(get, never): GLBuffer;
+
+	/**
+		Size of each buffer in bytes
+	**/
+	public final bufferByteLength: Int;
+
+	/**
+		Staging memory shared by all buffers, an allocation at byte `offset` is written from `floats[offset >> 2]`.
+		Create other views of `bytes.buffer` once to write other types
+	**/
+	public final floats: Float32Array;
+	public final bytes: Uint8Array;
+
+	final gl: GLContext;
+	final usage: BufferUsage;
+	#if js
+	final gl2: Null<GL2Context>;
+	#end
+
+	var bufferIndex = 0;
+	var cursor = 0;
+	var uploaded = 0;
+
+	public function new(gl: GLContext, target: BufferTarget = ARRAY_BUFFER, bufferByteLength: Int = 1024 * 1024, bufferCount: Int = 3, usage: BufferUsage = STREAM_DRAW) {
+		this.gl = gl;
+		this.target = target;
+		this.usage = usage;
+		this.bufferByteLength = align4(bufferByteLength);
+		#if js
+		this.gl2 = GL2Context.fromContext(gl);
+		#end
+
+		var staging = new ArrayBuffer(this.bufferByteLength);
+		floats = new Float32Array(staging);
+		bytes = new Uint8Array(staging);
+
+		buffers = [for (i in 0...bufferCount) {
+			var buffer = gl.createBuffer();
+			gl.bindBuffer(target, buffer);
+			gl.bufferDataOfSize(target, this.bufferByteLength, usage);
+			buffer;
+		}];
+	}
+
+	/**
+		Reserve `byteLength` bytes and return their byte offset in `buffer`. Offsets are 4 byte aligned.
+		Pending data is uploaded first if the allocation moves to the next buffer
+		@throws String if `byteLength` is larger than `bufferByteLength`
+	**/
+	public function allocate(byteLength: Int): Int {
+		if (byteLength > bufferByteLength) {
+			throw 'Allocation of $byteLength bytes is larger than the $bufferByteLength byte buffers of this DynamicBufferRing';
+		}
+		if (cursor + byteLength > bufferByteLength) {
+			upload();
+			bufferIndex = (bufferIndex + 1) % buffers.length;
+			cursor = 0;
+			uploaded = 0;
+			// orphan the buffer, the driver may still be reading its previous contents
+			gl.bindBuffer(target, buffers[bufferIndex]);
+			gl.bufferDataOfSize(target, bufferByteLength, usage);
+		}
+		var offset = cursor;
+		cursor = align4(cursor + byteLength);
+		return offset;
+	}
+
+	/**
+		Copy data written since the last upload into `buffer` and leave `buffer` bound to `target`.
+		Call once per batch of allocations rather than after each one
+	**/
+	public function upload() {
+		gl.bindBuffer(target, buffer);
+		if (cursor == uploaded) return;
+		#if js
+		if (gl2 != null) {
+			gl2.bufferSubData(target, uploaded, bytes, uploaded, cursor - uploaded);
+		} else {
+			gl.bufferSubData(target, uploaded, bytes.subarray(uploaded, cursor));
+		}
+		#else
+		(gl: webgl.native.GLContext).bufferSubDataRange(target, uploaded, bytes, uploaded, cursor - uploaded);
+		#end
+		uploaded = cursor;
+	}
+
+	inline function get_buffer() {
+		return buffers[bufferIndex];
+	}
+
+	static inline function align4(value: Int) {
+		return (value + 3) & ~3;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,357 @@
+package webgl;
+
+import webgl.GLContext;
+
+private typedef InternalGL2Context =
+	#if js
+		js.html.webgl.WebGL2RenderingContext;
+	#elseif cpp
+		webgl.native.GL2Context;
+	#else
+		Dynamic;
+	#end
+
+/**
+	WebGL2 methods for a `GLContext` that supports them, use `fromContext()` to check
+	
+	On native this is available when the host context is OpenGL ES 3.0 or desktop GL 3.3 and later.
+	On js the canvas must be created with a `webgl2` context, compile with `-D webgl2` to have `HaxeAppCanvas` request one
+**/
+@:forward
+abstract GL2Context(GLContext) to GLContext {
+
+	inline function new(gl: GLContext) this = gl;
+
+	/**
+		Returns null if `gl` doesn't support WebGL2
+	**/
+	static public function fromContext(gl: GLContext): Null<GL2Context> {
+		return Std.is(gl, InternalGL2Context) ? new GL2Context(gl) : null;
+	}
+
+	var gl2(get, never): InternalGL2Context;
+	inline function get_gl2() return cast this;
+
+	/* Buffer objects */
+
+	public inline function copyBufferSubData(readTarget:BufferTarget, writeTarget:BufferTarget, readOffset:GLintptr, writeOffset:GLintptr, size:GLsizeiptr)
+		gl2.copyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+
+	/**
+		`srcOffset` and `length` are in elements of `srcData`, a `length` of 0 copies to the end of `srcData`
+	**/
+	public inline function bufferSubData(target:BufferTarget, dstByteOffset:GLintptr, srcData:GLArrayBufferView, srcOffset:GLuint = 0, length:GLuint = 0)
+		#if js
+		gl2.bufferSubData(target, dstByteOffset, srcData, srcOffset, length);
+		#else
+		gl2.bufferSubDataRange(target, dstByteOffset, srcData, srcOffset, length);
+		#end
+
+	public inline function getBufferSubData(target:BufferTarget, srcByteOffset:GLintptr, dstBuffer:GLArrayBufferView)
+		gl2.getBufferSubData(target, srcByteOffset, dstBuffer);
+
+	public inline function bindBufferBase(target:BufferTarget, index:GLuint, ?buffer:GLBuffer)
+		gl2.bindBufferBase(target, index, buffer);
+
+	public inline function bindBufferRange(target:BufferTarget, index:GLuint, buffer:Null<GLBuffer>, offset:GLintptr, size:GLsizeiptr)
+		gl2.bindBufferRange(target, index, buffer, offset, size);
+
+	/* Vertex array objects */
+
+	public inline function createVertexArray():Null<GLVertexArrayObject>
+		return gl2.createVertexArray();
+
+	public inline function deleteVertexArray(?vertexArray:GLVertexArrayObject)
+		gl2.deleteVertexArray(vertexArray);
+
+	public inline function isVertexArray(?vertexArray:GLVertexArrayObject):Bool
+		return gl2.isVertexArray(vertexArray);
+
+	public inline function bindVertexArray(?vertexArray:GLVertexArrayObject)
+		gl2.bindVertexArray(vertexArray);
+
+	/* Drawing */
+
+	public inline function drawArraysInstanced(mode:DrawMode, first:GLint, count:GLsizei, instanceCount:GLsizei)
+		gl2.drawArraysInstanced(mode, first, count, instanceCount);
+
+	public inline function drawElementsInstanced(mode:DrawMode, count:GLsizei, type:DataType, offset:GLintptr, instanceCount:GLsizei)
+		gl2.drawElementsInstanced(mode, count, type, offset, instanceCount);
+
+	public inline function vertexAttribDivisor(index:GLuint, divisor:GLuint)
+		gl2.vertexAttribDivisor(index, divisor);
+
+	public inline function drawRangeElements(mode:DrawMode, start:GLuint, end:GLuint, count:GLsizei, type:DataType, offset:GLintptr)
+		gl2.drawRangeElements(mode, start, end, count, type, offset);
+
+	/* Multiple render targets */
+
+	public inline function drawBuffers(buffers:Array<GLenum>)
+		gl2.drawBuffers(cast buffers);
+
+	public inline function readBuffer(src:GLenum)
+		gl2.readBuffer(src);
+
+	public inline function clearBufferfv(buffer:GLenum, drawbuffer:GLint, values:GLFloat32Array)
+		gl2.clearBufferfv(buffer, drawbuffer, values);
+
+	public inline function clearBufferiv(buffer:GLenum, drawbuffer:GLint, values:GLInt32Array)
+		gl2.clearBufferiv(buffer, drawbuffer, values);
+
+	public inline function clearBufferuiv(buffer:GLenum, drawbuffer:GLint, values:GLUint32Array)
+		gl2.clearBufferuiv(buffer, drawbuffer, values);
+
+	public inline function clearBufferfi(buffer:GLenum, drawbuffer:GLint, depth:GLfloat, stencil:GLint)
+		gl2.clearBufferfi(buffer, drawbuffer, depth, stencil);
+
+	/* Framebuffers and renderbuffers */
+
+	public inline function blitFramebuffer(srcX0:GLint, srcY0:GLint, srcX1:GLint, srcY1:GLint, dstX0:GLint, dstY0:GLint, dstX1:GLint, dstY1:GLint, mask:ClearBufferMask, filter:GLenum)
+		gl2.blitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+
+	public inline function framebufferTextureLayer(target:FramebufferTarget, attachment:FramebufferAttachement, texture:Null<GLTexture>, level:GLint, layer:GLint)
+		gl2.framebufferTextureLayer(target, attachment, texture, level, layer);
+
+	public inline function renderbufferStorageMultisample(target:RenderbufferTarget, samples:GLsizei, internalformat:GLenum, width:GLsizei, height:GLsizei)
+		gl2.renderbufferStorageMultisample(target, samples, internalformat, width, height);
+
+	/* Textures */
+
+	public inline function texStorage2D(target:TextureTarget, levels:GLsizei, internalformat:GLenum, width:GLsizei, height:GLsizei)
+		gl2.texStorage2D(target, levels, internalformat, width, height);
+
+	public inline function texStorage3D(target:TextureTarget, levels:GLsizei, internalformat:GLenum, width:GLsizei, height:GLsizei, depth:GLsizei)
+		gl2.texStorage3D(target, levels, internalformat, width, height, depth);
+
+	public inline function texImage3D(target:TextureTarget, level:GLint, internalformat:GLenum, width:GLsizei, height:GLsizei, depth:GLsizei, border:GLint, format:PixelFormat, type:PixelDataType, pixels:Null<GLArrayBufferView>)
+		gl2.texImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+
+	public inline function texSubImage3D(target:TextureTarget, level:GLint, xoffset:GLint, yoffset:GLint, zoffset:GLint, width:GLsizei, height:GLsizei, depth:GLsizei, format:PixelFormat, type:PixelDataType, pixels:GLArrayBufferView)
+		gl2.texSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+
+	/* Pixel buffer objects */
+
+	/**
+		`readPixels()` into the buffer bound to `PIXEL_PACK_BUFFER`, at byte `offset`
+	**/
+	public inline function readPixelsToBuffer(x:GLint, y:GLint, width:GLsizei, height:GLsizei, format:PixelFormat, type:PixelDataType, offset:GLintptr)
+		#if js
+		gl2.readPixels(x, y, width, height, format, type, offset);
+		#else
+		gl2.readPixelsToBuffer(x, y, width, height, format, type, offset);
+		#end
+
+	/**
+		`texSubImage2D()` from the buffer bound to `PIXEL_UNPACK_BUFFER`, at byte `offset`
+	**/
+	public inline function texSubImage2DFromBuffer(target:TextureTarget, level:GLint, xoffset:GLint, yoffset:GLint, width:GLsizei, height:GLsizei, format:PixelFormat, type:PixelDataType, offset:GLintptr)
+		#if js
+		gl2.texSubImage2D(target, level, xoffset, yoffset, width, height, format, type, offset);
+		#else
+		gl2.texSubImage2DFromBuffer(target, level, xoffset, yoffset, width, height, format, type, offset);
+		#end
+
+	/* Integer vertex attributes */
+
+	public inline function vertexAttribIPointer(index:GLuint, size:GLint, type:DataType, stride:GLsizei, offset:GLintptr)
+		gl2.vertexAttribIPointer(index, size, type, stride, offset);
+
+	public inline function vertexAttribI4i(index:GLuint, x:GLint, y:GLint, z:GLint, w:GLint)
+		gl2.vertexAttribI4i(index, x, y, z, w);
+
+	public inline function vertexAttribI4ui(index:GLuint, x:GLuint, y:GLuint, z:GLuint, w:GLuint)
+		gl2.vertexAttribI4ui(index, x, y, z, w);
+
+	/* Uniforms */
+
+	public inline function uniform1ui(location:GLUniformLocation, v0:GLuint)
+		gl2.uniform1ui(location, v0);
+
+	public inline function uniform2ui(location:GLUniformLocation, v0:GLuint, v1:GLuint)
+		gl2.uniform2ui(location, v0, v1);
+
+	public inline function uniform3ui(location:GLUniformLocation, v0:GLuint, v1:GLuint, v2:GLuint)
+		gl2.uniform3ui(location, v0, v1, v2);
+
+	public inline function uniform4ui(location:GLUniformLocation, v0:GLuint, v1:GLuint, v2:GLuint, v3:GLuint)
+		gl2.uniform4ui(location, v0, v1, v2, v3);
+
+	public inline function uniform1uiv(location:GLUniformLocation, data:GLUint32Array)
+		gl2.uniform1uiv(location, data);
+
+	public inline function uniform2uiv(location:GLUniformLocation, data:GLUint32Array)
+		gl2.uniform2uiv(location, data);
+
+	public inline function uniform3uiv(location:GLUniformLocation, data:GLUint32Array)
+		gl2.uniform3uiv(location, data);
+
+	public inline function uniform4uiv(location:GLUniformLocation, data:GLUint32Array)
+		gl2.uniform4uiv(location, data);
+
+	public inline function uniformMatrix2x3fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array)
+		gl2.uniformMatrix2x3fv(location, transpose, data);
+
+	public inline function uniformMatrix3x2fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array)
+		gl2.uniformMatrix3x2fv(location, transpose, data);
+
+	public inline function uniformMatrix2x4fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array)
+		gl2.uniformMatrix2x4fv(location, transpose, data);
+
+	public inline function uniformMatrix4x2fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array)
+		gl2.uniformMatrix4x2fv(location, transpose, data);
+
+	public inline function uniformMatrix3x4fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array)
+		gl2.uniformMatrix3x4fv(location, transpose, data);
+
+	public inline function uniformMatrix4x3fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array)
+		gl2.uniformMatrix4x3fv(location, transpose, data);
+
+	/* Uniform buffer objects */
+
+	public inline function getUniformBlockIndex(program:GLProgram, uniformBlockName:String):GLuint
+		return gl2.getUniformBlockIndex(program, uniformBlockName);
+
+	public inline function getActiveUniformBlockParameter(program:GLProgram, uniformBlockIndex:GLuint, pname:GLenum):Any
+		return gl2.getActiveUniformBlockParameter(program, uniformBlockIndex, pname);
+
+	public inline function uniformBlockBinding(program:GLProgram, uniformBlockIndex:GLuint, uniformBlockBinding:GLuint)
+		gl2.uniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+
+	/* Sampler objects */
+
+	public inline function createSampler():Null<GLSampler>
+		return gl2.createSampler();
+
+	public inline function deleteSampler(?sampler:GLSampler)
+		gl2.deleteSampler(sampler);
+
+	public inline function isSampler(?sampler:GLSampler):Bool
+		return gl2.isSampler(sampler);
+
+	public inline function bindSampler(unit:GLuint, ?sampler:GLSampler)
+		gl2.bindSampler(unit, sampler);
+
+	public inline function samplerParameteri(sampler:GLSampler, pname:GLenum, param:GLint)
+		gl2.samplerParameteri(sampler, pname, param);
+
+	public inline function samplerParameterf(sampler:GLSampler, pname:GLenum, param:GLfloat)
+		gl2.samplerParameterf(sampler, pname, param);
+
+	/* Sync objects */
+
+	public inline function fenceSync(condition:GLenum, flags:GLbitfield):Null<GLSync>
+		return gl2.fenceSync(condition, flags);
+
+	/**
+		`timeout` is in nanoseconds
+	**/
+	public inline function clientWaitSync(sync:GLSync, flags:GLbitfield, timeout:Int):GLenum
+		return gl2.clientWaitSync(sync, flags, timeout);
+
+	public inline function deleteSync(?sync:GLSync)
+		gl2.deleteSync(sync);
+
+	// constants
+
+	static public inline final READ_BUFFER: GLenum = 0x0C02;
+	static public inline final PIXEL_PACK_BUFFER: GLenum = 0x88EB;
+	static public inline final PIXEL_UNPACK_BUFFER: GLenum = 0x88EC;
+	static public inline final COPY_READ_BUFFER: GLenum = 0x8F36;
+	static public inline final COPY_WRITE_BUFFER: GLenum = 0x8F37;
+	static public inline final UNIFORM_BUFFER: GLenum = 0x8A11;
+	static public inline final UNIFORM_BUFFER_OFFSET_ALIGNMENT: GLenum = 0x8A34;
+	static public inline final MAX_UNIFORM_BUFFER_BINDINGS: GLenum = 0x8A2F;
+	static public inline final MAX_UNIFORM_BLOCK_SIZE: GLenum = 0x8A30;
+	static public inline final UNIFORM_BLOCK_DATA_SIZE: GLenum = 0x8A40;
+	static public inline final UNIFORM_BLOCK_ACTIVE_UNIFORMS: GLenum = 0x8A42;
+	static public inline final UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES: GLenum = 0x8A43;
+	static public inline final UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER: GLenum = 0x8A44;
+	static public inline final UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER: GLenum = 0x8A46;
+	static public inline final INVALID_INDEX: GLuint = 0xFFFFFFFF;
+	static public inline final STREAM_READ: GLenum = 0x88E1;
+	static public inline final STREAM_COPY: GLenum = 0x88E2;
+	static public inline final STATIC_READ: GLenum = 0x88E5;
+	static public inline final STATIC_COPY: GLenum = 0x88E6;
+	static public inline final DYNAMIC_READ: GLenum = 0x88E9;
+	static public inline final DYNAMIC_COPY: GLenum = 0x88EA;
+
+	static public inline final READ_FRAMEBUFFER: GLenum = 0x8CA8;
+	static public inline final DRAW_FRAMEBUFFER: GLenum = 0x8CA9;
+	static public inline final MAX_DRAW_BUFFERS: GLenum = 0x8824;
+	static public inline final MAX_COLOR_ATTACHMENTS: GLenum = 0x8CDF;
+	static public inline final MAX_SAMPLES: GLenum = 0x8D57;
+	static public inline final COLOR: GLenum = 0x1800;
+	static public inline final DEPTH: GLenum = 0x1801;
+	static public inline final STENCIL: GLenum = 0x1802;
+	static public inline final COLOR_ATTACHMENT1: GLenum = 0x8CE1;
+	static public inline final COLOR_ATTACHMENT2: GLenum = 0x8CE2;
+	static public inline final COLOR_ATTACHMENT3: GLenum = 0x8CE3;
+	static public inline final COLOR_ATTACHMENT4: GLenum = 0x8CE4;
+	static public inline final COLOR_ATTACHMENT5: GLenum = 0x8CE5;
+	static public inline final COLOR_ATTACHMENT6: GLenum = 0x8CE6;
+	static public inline final COLOR_ATTACHMENT7: GLenum = 0x8CE7;
+	static public inline final DEPTH_STENCIL_ATTACHMENT: GLenum = 0x821A;
+
+	static public inline final TEXTURE_3D: GLenum = 0x806F;
+	static public inline final TEXTURE_2D_ARRAY: GLenum = 0x8C1A;
+	static public inline final TEXTURE_WRAP_R: GLenum = 0x8072;
+	static public inline final TEXTURE_MIN_LOD: GLenum = 0x813A;
+	static public inline final TEXTURE_MAX_LOD: GLenum = 0x813B;
+	static public inline final TEXTURE_BASE_LEVEL: GLenum = 0x813C;
+	static public inline final TEXTURE_MAX_LEVEL: GLenum = 0x813D;
+	static public inline final TEXTURE_COMPARE_MODE: GLenum = 0x884C;
+	static public inline final TEXTURE_COMPARE_FUNC: GLenum = 0x884D;
+	static public inline final COMPARE_REF_TO_TEXTURE: GLenum = 0x884E;
+	static public inline final UNPACK_ROW_LENGTH: GLenum = 0x0CF2;
+	static public inline final UNPACK_SKIP_ROWS: GLenum = 0x0CF3;
+	static public inline final UNPACK_SKIP_PIXELS: GLenum = 0x0CF4;
+	static public inline final PACK_ROW_LENGTH: GLenum = 0x0D02;
+	static public inline final PACK_SKIP_ROWS: GLenum = 0x0D03;
+	static public inline final PACK_SKIP_PIXELS: GLenum = 0x0D04;
+
+	static public inline final RED: GLenum = 0x1903;
+	static public inline final RG: GLenum = 0x8227;
+	static public inline final RED_INTEGER: GLenum = 0x8D94;
+	static public inline final RG_INTEGER: GLenum = 0x8228;
+	static public inline final RGB_INTEGER: GLenum = 0x8D98;
+	static public inline final RGBA_INTEGER: GLenum = 0x8D99;
+	static public inline final HALF_FLOAT: GLenum = 0x140B;
+	static public inline final UNSIGNED_INT_24_8: GLenum = 0x84FA;
+	static public inline final R8: GLenum = 0x8229;
+	static public inline final RG8: GLenum = 0x822B;
+	static public inline final RGB8: GLenum = 0x8051;
+	static public inline final RGBA8: GLenum = 0x8058;
+	static public inline final SRGB8: GLenum = 0x8C41;
+	static public inline final SRGB8_ALPHA8: GLenum = 0x8C43;
+	static public inline final R16F: GLenum = 0x822D;
+	static public inline final RG16F: GLenum = 0x822F;
+	static public inline final RGBA16F: GLenum = 0x881A;
+	static public inline final R32F: GLenum = 0x822E;
+	static public inline final RG32F: GLenum = 0x8230;
+	static public inline final RGBA32F: GLenum = 0x8814;
+	static public inline final R11F_G11F_B10F: GLenum = 0x8C3A;
+	static public inline final R32UI: GLenum = 0x8236;
+	static public inline final RGBA8UI: GLenum = 0x8D7C;
+	static public inline final RGBA32UI: GLenum = 0x8D70;
+	static public inline final DEPTH_COMPONENT24: GLenum = 0x81A6;
+	static public inline final DEPTH_COMPONENT32F: GLenum = 0x8CAC;
+	static public inline final DEPTH24_STENCIL8: GLenum = 0x88F0;
+	static public inline final DEPTH32F_STENCIL8: GLenum = 0x8CAD;
+
+	static public inline final UNSIGNED_INT_VEC2: GLenum = 0x8DC6;
+	static public inline final UNSIGNED_INT_VEC3: GLenum = 0x8DC7;
+	static public inline final UNSIGNED_INT_VEC4: GLenum = 0x8DC8;
+	static public inline final SAMPLER_3D: GLenum = 0x8B5F;
+	static public inline final SAMPLER_2D_ARRAY: GLenum = 0x8DC1;
+	static public inline final VERTEX_ARRAY_BINDING: GLenum = 0x85B5;
+	static public inline final VERTEX_ATTRIB_ARRAY_DIVISOR: GLenum = 0x88FE;
+	static public inline final VERTEX_ATTRIB_ARRAY_INTEGER: GLenum = 0x88FD;
+
+	static public inline final SYNC_GPU_COMMANDS_COMPLETE: GLenum = 0x9117;
+	static public inline final SYNC_FLUSH_COMMANDS_BIT: GLbitfield = 0x00000001;
+	static public inline final ALREADY_SIGNALED: GLenum = 0x911A;
+	static public inline final TIMEOUT_EXPIRED: GLenum = 0x911B;
+	static public inline final CONDITION_SATISFIED: GLenum = 0x911C;
+	static public inline final WAIT_FAILED: GLenum = 0x911D;
+
+}
\ No newline at end of file
@@ -93,6 +93,14 @@ private typedef InternalConstGLContext =
 )
 abstract GLContext(InternalGLContext) from InternalGLContext to InternalGLContext {
 
+	/**
+		Uploads textures over several frames, see `TextureUploadQueue`
+	**/
+	public var uploadQueue(get, never): TextureUploadQueue;
+
+	inline function get_uploadQueue()
+		return TextureUploadQueue.forContext(this);
+
 	public inline function getContextAttributes():Null<GLContextAttributes>
 		return cast this.getContextAttributes(); // cast because HTML externs may not have all possible properties
 
@@ -293,6 +301,30 @@ abstract GLContext(InternalGLContext) from InternalGLContext to InternalGLContex
 	public inline function getParameter<T>(pname:Parameter<T>):Null<T>
 	    return this.getParameter(pname);
 
+	/**
+		Like `getParameter()` but writes into `result`, on native no array is allocated
+	**/
+	public inline function getParameterInt32Array(pname:Parameter<GLInt32Array>, result:GLInt32Array):GLInt32Array {
+		#if js
+		result.set(this.getParameter(pname));
+		return result;
+		#else
+		return this.getParameterInt32Array(pname, result);
+		#end
+	}
+
+	/**
+		Like `getParameter()` but writes into `result`, on native no array is allocated
+	**/
+	public inline function getParameterFloat32Array(pname:Parameter<GLFloat32Array>, result:GLFloat32Array):GLFloat32Array {
+		#if js
+		result.set(this.getParameter(pname));
+		return result;
+		#else
+		return this.getParameterFloat32Array(pname, result);
+		#end
+	}
+
 	public inline function getError():ErrorCode
 	    return this.getError();
 
@@ -0,0 +1,7 @@
+package webgl;
+
+#if js
+typedef GLSampler = js.html.webgl.Sampler;
+#else
+typedef GLSampler = webgl.native.GLSampler;
+#end
\ No newline at end of file
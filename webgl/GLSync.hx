@@ -0,0 +1,7 @@
+package webgl;
+
+#if js
+typedef GLSync = js.html.webgl.Sync;
+#else
+typedef GLSync = webgl.native.GLSync;
+#end
\ No newline at end of file
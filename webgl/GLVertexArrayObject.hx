@@ -0,0 +1,7 @@
+package webgl;
+
+#if js
+typedef GLVertexArrayObject = js.html.webgl.VertexArrayObject;
+#else
+typedef GLVertexArrayObject = webgl.native.GLVertexArrayObject;
+#end
\ No newline at end of file
@@ -0,0 +1,203 @@
+package webgl;
+
+#if macro
+import haxe.macro.Context;
+import haxe.macro.Expr;
+#end
+
+/**
+	Generates std140 uniform block layout helpers from a class of `var` fields declared in the same order as the GLSL block
+
+	```haxe
+	@:build(webgl.Std140.build())
+	class ObjectUniforms {
+		var model: Mat4;
+		var tint: Vec4;
+		var alpha: Float;
+		@:arrayLength(4) var weights: Float;
+	}
+	```
+
+	Fields are replaced with `BYTE_LENGTH`, an `<field>Offset` byte offset per field and `set<Field>(ring, blockOffset, ...)` setters that write into a `UniformRing`.
+	Array fields take an `index` after `blockOffset` and matrices are given as column-major `Float32Array`s. Nested structs are not supported
+**/
+class Std140 {
+
+	#if macro
+	static function build() {
+		var fields = Context.getBuildFields();
+		var result = new Array<Field>();
+		var offset = 0;
+
+		for (field in fields) {
+			var type = switch field.kind {
+				case FVar(type, null) if (type != null && field.access.indexOf(AStatic) == -1): type;
+				default:
+					result.push(field);
+					continue;
+			}
+
+			var member = getMember(type);
+			if (member == null) {
+				Context.error('Unsupported std140 field type, expected Float, Int, UInt, Bool, VecN, IVecN, UVecN, BVecN or MatN', field.pos);
+				continue;
+			}
+
+			var arrayLength = getArrayLength(field);
+			var isMatrix = member.columns > 1;
+			var size = isMatrix ? member.columns * 16 : member.components * 4;
+			// array elements and matrix columns are padded to vec4
+			var stride = isMatrix ? size : align(size, 16);
+			var alignment = arrayLength != null || isMatrix || member.components > 2 ? 16 : member.components * 4;
+
+			offset = align(offset, alignment);
+			var fieldOffset = offset;
+			offset += arrayLength != null ? stride * arrayLength : size;
+
+			result.push({
+				name: field.name + 'Offset',
+				doc: 'Byte offset of `${field.name}` within the block',
+				access: [APublic, AStatic, AInline, AFinal],
+				kind: FVar(macro :Int, macro $v{fieldOffset}),
+				pos: field.pos,
+			});
+
+			var args: Array<FunctionArg> = [
+				{ name: 'ring', type: macro :webgl.UniformRing },
+				{ name: 'blockOffset', type: macro :Int },
+			];
+			var indexExpr = if (arrayLength != null) {
+				args.push({ name: 'index', type: macro :Int });
+				macro (blockOffset + $v{fieldOffset} + index * $v{stride}) >> 2;
+			} else {
+				macro (blockOffset + $v{fieldOffset}) >> 2;
+			}
+
+			var body = [macro var i = $indexExpr];
+			if (isMatrix) {
+				var rows = member.components;
+				args.push({ name: 'value', type: macro :typedarray.Float32Array });
+				body.push(macro for (column in 0...$v{member.columns}) {
+					for (row in 0...$v{rows}) {
+						ring.floats[i + column * 4 + row] = value[column * $v{rows} + row];
+					}
+				});
+			} else {
+				var names = member.components == 1 ? ['value'] : ['x', 'y', 'z', 'w'].slice(0, member.components);
+				var argType = switch member.scalar {
+					case ScalarFloat: macro :Float;
+					case ScalarBool: macro :Bool;
+					case ScalarInt: macro :Int;
+				}
+				for (k in 0...names.length) {
+					args.push({ name: names[k], type: argType });
+					var value = macro $i{names[k]};
+					body.push(switch member.scalar {
+						case ScalarFloat: macro ring.floats[i + $v{k}] = $value;
+						case ScalarBool: macro ring.ints[i + $v{k}] = $value ? 1 : 0;
+						case ScalarInt: macro ring.ints[i + $v{k}] = $value;
+					});
+				}
+			}
+
+			result.push({
+				name: 'set' + field.name.charAt(0).toUpperCase() + field.name.substr(1),
+				doc: field.doc,
+				access: [APublic, AStatic, AInline],
+				kind: FFun({
+					args: args,
+					ret: macro :Void,
+					expr: macro $b{body},
+				}),
+				pos: field.pos,
+			});
+		}
+
+		result.push({
+			name: 'BYTE_LENGTH',
+			doc: 'Size of the block in bytes, use when allocating blocks and binding ranges',
+			access: [APublic, AStatic, AInline, AFinal],
+			kind: FVar(macro :Int, macro $v{align(offset, 16)}),
+			pos: Context.currentPos(),
+		});
+
+		return result;
+	}
+
+	static function getMember(type: ComplexType): Null<Std140Member> {
+		var name = switch type {
+			case TPath(path) if (path.params == null || path.params.length == 0): path.sub != null ? path.sub : path.name;
+			default: return null;
+		}
+		return switch name {
+			case 'Float': { scalar: ScalarFloat, components: 1, columns: 1 };
+			case 'Int', 'UInt': { scalar: ScalarInt, components: 1, columns: 1 };
+			case 'Bool': { scalar: ScalarBool, components: 1, columns: 1 };
+			case 'Vec2': { scalar: ScalarFloat, components: 2, columns: 1 };
+			case 'Vec3': { scalar: ScalarFloat, components: 3, columns: 1 };
+			case 'Vec4': { scalar: ScalarFloat, components: 4, columns: 1 };
+			case 'IVec2', 'UVec2': { scalar: ScalarInt, components: 2, columns: 1 };
+			case 'IVec3', 'UVec3': { scalar: ScalarInt, components: 3, columns: 1 };
+			case 'IVec4', 'UVec4': { scalar: ScalarInt, components: 4, columns: 1 };
+			case 'BVec2': { scalar: ScalarBool, components: 2, columns: 1 };
+			case 'BVec3': { scalar: ScalarBool, components: 3, columns: 1 };
+			case 'BVec4': { scalar: ScalarBool, components: 4, columns: 1 };
+			case 'Mat2': { scalar: ScalarFloat, components: 2, columns: 2 };
+			case 'Mat3': { scalar: ScalarFloat, components: 3, columns: 3 };
+			case 'Mat4': { scalar: ScalarFloat, components: 4, columns: 4 };
+			default: null;
+		}
+	}
+
+	static function getArrayLength(field: Field): Null<Int> {
+		if (field.meta == null) return null;
+		for (meta in field.meta) {
+			if (meta.name != ':arrayLength') continue;
+			return switch meta.params {
+				case [{ expr: EConst(CInt(length)) }]: Std.parseInt(length);
+				default:
+					Context.error('@:arrayLength expects an integer length', meta.pos);
+					null;
+			}
+		}
+		return null;
+	}
+
+	static inline function align(value: Int, alignment: Int) {
+		return Std.int((value + alignment - 1) / alignment) * alignment;
+	}
+	#end
+
+}
+
+#if macro
+private enum Std140Scalar {
+	ScalarFloat;
+	ScalarInt;
+	ScalarBool;
+}
+
+private typedef Std140Member = {
+	scalar: Std140Scalar,
+	components: Int,
+	columns: Int,
+}
+#end
+
+// GLSL types for std140 fields, only their names are used
+
+abstract Vec2(Dynamic) {}
+abstract Vec3(Dynamic) {}
+abstract Vec4(Dynamic) {}
+abstract IVec2(Dynamic) {}
+abstract IVec3(Dynamic) {}
+abstract IVec4(Dynamic) {}
+abstract UVec2(Dynamic) {}
+abstract UVec3(Dynamic) {}
+abstract UVec4(Dynamic) {}
+abstract BVec2(Dynamic) {}
+abstract BVec3(Dynamic) {}
+abstract BVec4(Dynamic) {}
+abstract Mat2(Dynamic) {}
+abstract Mat3(Dynamic) {}
+abstract Mat4(Dynamic) {}
\ No newline at end of file
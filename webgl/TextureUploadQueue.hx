@@ -0,0 +1,413 @@
+package webgl;
+
+import webgl.GLContext;
+import typedarray.ArrayBufferView;
+import typedarray.Float32Array;
+import typedarray.Uint16Array;
+import typedarray.Uint8Array;
+
+/**
+	Uploads textures over several frames so a batch of large textures doesn't stall a single frame
+
+	Each upload is split into slices of rows sent with `texSubImage2D()` (through a `PIXEL_UNPACK_BUFFER` on WebGL2 and OpenGL ES 3.0).
+	At the start of every frame slices are sent until `budgetMs` is spent; a texture's storage is allocated when its first slice is sent and its contents are undefined until its `onComplete` is called.
+	On js, images and other DOM sources cannot be split so they are uploaded in one call. On native an `Image` is decoded, if it isn't already, when its first slice is sent.
+	Uploads leave the texture they last wrote bound
+
+	Pixel data is always read as tightly packed rows: `UNPACK_ROW_LENGTH`, `UNPACK_SKIP_ROWS` and `UNPACK_SKIP_PIXELS` are reset while slices are sent and restored after.
+	On js `UNPACK_FLIP_Y_WEBGL` and `UNPACK_PREMULTIPLY_ALPHA_WEBGL` apply to the whole upload as they would to a single `texImage2D()`;
+	while either is set slices are sent from client memory because WebGL2 rejects them for uploads from a `PIXEL_UNPACK_BUFFER`
+
+	```haxe
+	gl.uploadQueue.uploadImage(texture, TEXTURE_2D, 0, RGBA, RGBA, UNSIGNED_BYTE, image, () -> {
+		gl.bindTexture(TEXTURE_2D, texture);
+		gl.generateMipmap(TEXTURE_2D);
+	});
+	gl.uploadQueue.onProgress = (uploadedBytes, totalBytes) -> trace('${Math.round(uploadedBytes / totalBytes * 100)}%');
+	```
+**/
+#if !js
+@:access(webgl.native.GLContext)
+#end
+class TextureUploadQueue {
+
+	/**
+		Milliseconds each frame may spend uploading, at least one slice is sent each frame while uploads are pending
+	**/
+	public var budgetMs: Float = 4;
+
+	/**
+		Approximate size of each slice, uploads are split on row boundaries
+	**/
+	public var sliceByteLength: Int = 256 * 1024;
+
+	/**
+		Called after each frame's slices with the bytes uploaded and queued since the queue was last empty
+	**/
+	public var onProgress: Null<(uploadedBytes: Int, totalBytes: Int) -> Void> = null;
+
+	public var uploadedBytes(default, null): Int = 0;
+	public var totalBytes(default, null): Int = 0;
+
+	/**
+		Number of uploads not yet complete
+	**/
+	public var length(get, never): Int;
+
+	final gl: GLContext;
+	final gl2: Null<GL2Context>;
+	final uploads = new Array<TextureUpload>();
+	// slices are copied through one unpack buffer on WebGL2, see sendSlice()
+	var unpackBuffer: Null<GLBuffer> = null;
+	var unpackBufferByteLength = 0;
+	// js unpack state read at the start of process(), see sendSlice()
+	var flipY = false;
+	var premultiplyAlpha = false;
+
+	// queues with pending uploads
+	static final active = new Array<TextureUploadQueue>();
+
+	/**
+		Queue for `gl`, created when first used. Also available as `gl.uploadQueue`
+	**/
+	static public function forContext(gl: GLContext): TextureUploadQueue {
+		#if js
+		// WebGL contexts are browser objects, the queue is stored as an extra field
+		var queue: Null<TextureUploadQueue> = untyped gl.haxeTextureUploadQueue;
+		if (queue == null) {
+			queue = new TextureUploadQueue(gl);
+			untyped gl.haxeTextureUploadQueue = queue;
+		}
+		return queue;
+		#else
+		var context: webgl.native.GLContext = gl;
+		var queue = context.uploadQueue;
+		if (queue == null) {
+			queue = new TextureUploadQueue(gl);
+			context.uploadQueue = queue;
+		}
+		return queue;
+		#end
+	}
+
+	/**
+		Send slices of every queue within their budgets, called by the app at the start of each frame before `onDrawFrame()`
+	**/
+	@:keep
+	@:noCompletion
+	static public function processAll() {
+		var i = 0;
+		while (i < active.length) {
+			var queue = active[i];
+			queue.process();
+			// a queue leaves `active` when it empties
+			if (i < active.length && active[i] == queue) i++;
+		}
+	}
+
+	function new(gl: GLContext) {
+		this.gl = gl;
+		this.gl2 = GL2Context.fromContext(gl);
+	}
+
+	/**
+		Queue `texImage2D()` of `pixels`, which must hold `height` tightly packed rows.
+		`pixels` must not be modified until `onComplete` is called
+		@throws String if `pixels` is too short or the format and type are unsupported
+	**/
+	public function uploadPixels(texture: GLTexture, target: TextureTarget, level: GLint, internalformat: PixelFormat, width: GLsizei, height: GLsizei, format: PixelFormat, type: PixelDataType, pixels: ArrayBufferView, ?onComplete: () -> Void) {
+		var upload = new TextureUpload(texture, target, level, internalformat, width, height, format, type, onComplete);
+		if (pixels.byteLength < upload.byteLength) {
+			throw 'Pixel data has ${pixels.byteLength} bytes but a ${width}x${height} texture needs ${upload.byteLength}';
+		}
+		upload.pixels = pixels;
+		add(upload);
+	}
+
+	/**
+		Queue `texImage2D()` of an image, on native `format` must be `ALPHA`, `LUMINANCE`, `LUMINANCE_ALPHA`, `RGB` or `RGBA` and `type` `UNSIGNED_BYTE` or `FLOAT`
+		@throws String if the format and type are unsupported
+	**/
+	public function uploadImage(texture: GLTexture, target: TextureTarget, level: GLint, internalformat: PixelFormat, format: PixelFormat, type: PixelDataType, source: TexImageSource, ?onComplete: () -> Void) {
+		#if !js
+		if (format == DEPTH_COMPONENT || (type != UNSIGNED_BYTE && type != FLOAT)) {
+			throw 'Unsupported image upload format ${StringTools.hex(format)} with type ${StringTools.hex(type)}';
+		}
+		#end
+		var upload = new TextureUpload(texture, target, level, internalformat, source.width, source.height, format, type, onComplete);
+		upload.source = source;
+		add(upload);
+	}
+
+	/**
+		Remove pending uploads to `texture`, call before deleting a texture that may still be queued
+	**/
+	public function cancel(texture: GLTexture) {
+		var i = 0;
+		while (i < uploads.length) {
+			var upload = uploads[i];
+			if (upload.texture == texture) {
+				uploads.splice(i, 1);
+				totalBytes -= upload.byteLength;
+				uploadedBytes -= upload.row * upload.rowByteLength;
+			} else {
+				i++;
+			}
+		}
+		if (uploads.length == 0) {
+			finish();
+		}
+	}
+
+	/**
+		Send slices until `budgetMs` is spent, called by `processAll()`
+	**/
+	public function process() {
+		if (uploads.length == 0) return;
+
+		if (gl.isContextLost()) {
+			// textures of a lost context cannot be uploaded to
+			uploads.resize(0);
+			finish();
+			return;
+		}
+
+		var deadline = haxe.Timer.stamp() + budgetMs / 1000;
+
+		#if js
+		// there's no shadow of the browser's pixel store state, it's queried once per frame while uploads are pending
+		var unpackAlignment: Int = gl.getParameter(Parameter.UNPACK_ALIGNMENT);
+		flipY = gl.getParameter(Parameter.UNPACK_FLIP_Y_WEBGL);
+		premultiplyAlpha = gl.getParameter(Parameter.UNPACK_PREMULTIPLY_ALPHA_WEBGL);
+		var rowLength = 0;
+		var skipRows = 0;
+		var skipPixels = 0;
+		if (gl2 != null) {
+			rowLength = gl.getParameter((GL2Context.UNPACK_ROW_LENGTH: Parameter<Int>));
+			skipRows = gl.getParameter((GL2Context.UNPACK_SKIP_ROWS: Parameter<Int>));
+			skipPixels = gl.getParameter((GL2Context.UNPACK_SKIP_PIXELS: Parameter<Int>));
+		}
+		#else
+		// the native context shadows pixel store state, UNPACK_FLIP_Y_WEBGL and UNPACK_PREMULTIPLY_ALPHA_WEBGL don't exist there
+		var context: webgl.native.GLContext = gl;
+		context.setContext();
+		context.validatePixelStore();
+		var unpackAlignment = context.unpackAlignment;
+		var rowLength = context.unpackRowLength;
+		var skipRows = context.unpackSkipRows;
+		var skipPixels = context.unpackSkipPixels;
+		#end
+
+		var resetUnpack = rowLength != 0 || skipRows != 0 || skipPixels != 0;
+		if (resetUnpack) {
+			setUnpackParameter(GL2Context.UNPACK_ROW_LENGTH, 0);
+			setUnpackParameter(GL2Context.UNPACK_SKIP_ROWS, 0);
+			setUnpackParameter(GL2Context.UNPACK_SKIP_PIXELS, 0);
+		}
+
+		do {
+			var upload = uploads[0];
+			// rows are tightly packed, unpack alignment only needs to drop to 1 when a row doesn't end on an alignment boundary
+			var realign = upload.rowByteLength % unpackAlignment != 0;
+			if (realign) gl.pixelStorei(PixelStoreParameter.UNPACK_ALIGNMENT, 1);
+			var complete = sendSlice(upload);
+			if (realign) gl.pixelStorei(PixelStoreParameter.UNPACK_ALIGNMENT, unpackAlignment);
+
+			if (complete) {
+				uploads.shift();
+				#if !js
+				if (upload.source != null) {
+					var imageSource: image.Image = upload.source;
+					if (imageSource.releasePixelDataAfterUpload) {
+						imageSource.releasePixelData();
+					}
+				}
+				#end
+				if (upload.onComplete != null) {
+					upload.onComplete();
+				}
+			}
+		} while (uploads.length > 0 && haxe.Timer.stamp() < deadline);
+
+		if (resetUnpack) {
+			setUnpackParameter(GL2Context.UNPACK_ROW_LENGTH, rowLength);
+			setUnpackParameter(GL2Context.UNPACK_SKIP_ROWS, skipRows);
+			setUnpackParameter(GL2Context.UNPACK_SKIP_PIXELS, skipPixels);
+		}
+
+		if (onProgress != null) {
+			onProgress(uploadedBytes, totalBytes);
+		}
+
+		if (uploads.length == 0) {
+			finish();
+		}
+	}
+
+	function add(upload: TextureUpload) {
+		// uploads queued by onComplete callbacks are added before the queue is finished
+		if (active.indexOf(this) == -1) {
+			active.push(this);
+		}
+		uploads.push(upload);
+		totalBytes += upload.byteLength;
+	}
+
+	function finish() {
+		active.remove(this);
+		uploadedBytes = 0;
+		totalBytes = 0;
+	}
+
+	/**
+		Returns true when `upload` is complete
+	**/
+	function sendSlice(upload: TextureUpload): Bool {
+		gl.bindTexture(upload.target == TEXTURE_2D ? TEXTURE_2D : TEXTURE_CUBE_MAP, upload.texture);
+
+		var pixels = upload.pixels;
+		var source = upload.source;
+
+		#if js
+		if (source != null) {
+			gl.texImage2DImageSource(upload.target, upload.level, upload.internalformat, upload.format, upload.type, source);
+			upload.row = upload.height;
+			uploadedBytes += upload.byteLength;
+			return true;
+		}
+		#else
+		if (source != null) {
+			// converted pixel data is cached by the image, so fetching it again for each slice is cheap and stays valid if the image releases it meanwhile
+			var imageSource: image.Image = source;
+			var dataType = upload.type == FLOAT ? image.Image.PixelDataType.FLOAT : image.Image.PixelDataType.UNSIGNED_BYTE;
+			var data = @:privateAccess imageSource.getData(TextureUpload.getChannelCount(upload.format), dataType, false, false);
+			var bytes = upload.bytes;
+			if (data != null && (bytes == null || bytes.buffer != data)) {
+				bytes = upload.bytes = new Uint8Array(data, 0, data.byteLength);
+			}
+			pixels = data != null ? bytes : null;
+		}
+		#end
+
+		if (upload.row == 0) {
+			gl.texImage2D(upload.target, upload.level, upload.internalformat, upload.width, upload.height, 0, upload.format, upload.type, null);
+		}
+
+		if (pixels == null) {
+			// as texImage2D() with no pixel data, the texture is left uninitialized
+			uploadedBytes += upload.byteLength;
+			return true;
+		}
+
+		var rows = Std.int(Math.min(upload.height - upload.row, Math.max(1, Std.int(sliceByteLength / upload.rowByteLength))));
+		var byteOffset = pixels.byteOffset + upload.row * upload.rowByteLength;
+		var byteLength = rows * upload.rowByteLength;
+		// the browser writes a flipped slice upside down within its rows, so with flipping the first slice goes to the last rows of the texture
+		var yoffset = flipY ? upload.height - upload.row - rows : upload.row;
+
+		if (gl2 != null && !flipY && !premultiplyAlpha) {
+			// one unpack buffer is reused for every slice. It is orphaned before each copy so the copy never waits for the GPU to finish reading the previous slice.
+			// The copy from client memory is synchronous, like texSubImage2D() from client memory
+			if (unpackBuffer == null) {
+				unpackBuffer = gl.createBuffer();
+			}
+			gl.bindBuffer(GL2Context.PIXEL_UNPACK_BUFFER, unpackBuffer);
+			unpackBufferByteLength = Std.int(Math.max(unpackBufferByteLength, Math.max(sliceByteLength, byteLength)));
+			gl.bufferDataOfSize(GL2Context.PIXEL_UNPACK_BUFFER, unpackBufferByteLength, STREAM_DRAW);
+			var bytes = upload.bytes;
+			if (bytes == null) {
+				bytes = upload.bytes = new Uint8Array(pixels.buffer, 0, pixels.byteOffset + upload.byteLength);
+			}
+			gl2.bufferSubData(GL2Context.PIXEL_UNPACK_BUFFER, 0, bytes, byteOffset, byteLength);
+			gl2.texSubImage2DFromBuffer(upload.target, upload.level, 0, yoffset, upload.width, rows, upload.format, upload.type, 0);
+			gl.bindBuffer(GL2Context.PIXEL_UNPACK_BUFFER);
+		} else {
+			gl.texSubImage2D(upload.target, upload.level, 0, yoffset, upload.width, rows, upload.format, upload.type, sliceView(pixels, upload.type, byteOffset, byteLength));
+		}
+
+		upload.row += rows;
+		uploadedBytes += byteLength;
+		return upload.row >= upload.height;
+	}
+
+	inline function get_length() {
+		return uploads.length;
+	}
+
+	inline function setUnpackParameter(pname: GLenum, value: Int) {
+		gl.pixelStorei((pname: PixelStoreParameter<GLint>), value);
+	}
+
+	static function sliceView(pixels: ArrayBufferView, type: PixelDataType, byteOffset: Int, byteLength: Int): ArrayBufferView {
+		#if js
+		// WebGL requires the array type to match `type`
+		return switch type {
+			case UNSIGNED_BYTE: new Uint8Array(pixels.buffer, byteOffset, byteLength);
+			case FLOAT: new Float32Array(pixels.buffer, byteOffset, byteLength >> 2);
+			default: new Uint16Array(pixels.buffer, byteOffset, byteLength >> 1);
+		}
+		#else
+		return new Uint8Array(pixels.buffer, byteOffset, byteLength);
+		#end
+	}
+
+}
+
+private class TextureUpload {
+
+	public final texture: GLTexture;
+	public final target: TextureTarget;
+	public final level: GLint;
+	public final internalformat: PixelFormat;
+	public final width: Int;
+	public final height: Int;
+	public final format: PixelFormat;
+	public final type: PixelDataType;
+	public final onComplete: Null<() -> Void>;
+
+	public final rowByteLength: Int;
+	public final byteLength: Int;
+
+	public var pixels: Null<ArrayBufferView> = null;
+	public var source: Null<TexImageSource> = null;
+	// bytes of `pixels.buffer`, or on native of the image's pixel data, created once rather than for each slice
+	public var bytes: Null<Uint8Array> = null;
+
+	// rows sent so far
+	public var row = 0;
+
+	public function new(texture: GLTexture, target: TextureTarget, level: GLint, internalformat: PixelFormat, width: Int, height: Int, format: PixelFormat, type: PixelDataType, onComplete: Null<() -> Void>) {
+		this.texture = texture;
+		this.target = target;
+		this.level = level;
+		this.internalformat = internalformat;
+		this.width = width;
+		this.height = height;
+		this.format = format;
+		this.type = type;
+		this.onComplete = onComplete;
+		this.rowByteLength = width * getBytesPerPixel(format, type);
+		this.byteLength = rowByteLength * height;
+	}
+
+	static public function getChannelCount(format: PixelFormat) {
+		return switch format {
+			case RGB: 3;
+			case RGBA: 4;
+			case LUMINANCE_ALPHA: 2;
+			case ALPHA, LUMINANCE, DEPTH_COMPONENT: 1;
+			default: throw 'Unsupported PixelFormat ${StringTools.hex(format)}';
+		}
+	}
+
+	static function getBytesPerPixel(format: PixelFormat, type: PixelDataType) {
+		return switch type {
+			case UNSIGNED_BYTE: getChannelCount(format);
+			case FLOAT: getChannelCount(format) * 4;
+			case HALF_FLOAT_OES: getChannelCount(format) * 2;
+			case UNSIGNED_SHORT_4_4_4_4, UNSIGNED_SHORT_5_5_5_1, UNSIGNED_SHORT_5_6_5: 2;
+			default: throw 'Unsupported PixelDataType ${StringTools.hex(type)}';
+		}
+	}
+
+}
\ No newline at end of file
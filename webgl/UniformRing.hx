@@ -0,0 +1,112 @@
+package webgl;
+
+import webgl.GLContext;
+import typedarray.ArrayBuffer;
+import typedarray.Float32Array;
+import typedarray.Int32Array;
+import typedarray.Uint8Array;
+
+/**
+	Packs per-draw uniform blocks into one `UNIFORM_BUFFER` so drawing an object costs a `bindBufferRange()` rather than a `uniform*()` call per uniform
+
+	Each frame allocates blocks with `allocate()` and writes them with the setters generated by `Std140`, uploads them with `upload()` in a single `bufferSubData()` and then binds each block before its draw with `bind()`.
+	The buffer is split into `frameCount` regions used in turn by `nextFrame()`, so blocks are never overwritten while earlier frames may still be reading them
+
+	```haxe
+	var offset = ring.allocate(ObjectUniforms.BYTE_LENGTH);
+	ObjectUniforms.setModel(ring, offset, modelMatrix);
+	...
+	ring.upload();
+	ring.bind(0, offset, ObjectUniforms.BYTE_LENGTH);
+	gl.drawArrays(TRIANGLES, 0, count);
+	...
+	ring.nextFrame();
+	```
+**/
+class UniformRing {
+
+	public final buffer: GLBuffer;
+
+	/**
+		Views of the staging memory, written by `Std140` setters
+	**/
+	public final floats: Float32Array;
+	public final ints: Int32Array;
+
+	/**
+		Bytes available to each frame
+	**/
+	public final frameByteLength: Int;
+	public final frameCount: Int;
+
+	final gl: GL2Context;
+	final bytes: Uint8Array;
+	final alignment: Int;
+
+	var frame = 0;
+	var cursor = 0;
+	var uploaded = 0;
+
+	public function new(gl: GL2Context, frameByteLength: Int = 64 * 1024, frameCount: Int = 3) {
+		this.gl = gl;
+		this.frameCount = frameCount;
+
+		// bindBufferRange() offsets must be multiples of UNIFORM_BUFFER_OFFSET_ALIGNMENT
+		var alignment: Null<GLint> = gl.getParameter((GL2Context.UNIFORM_BUFFER_OFFSET_ALIGNMENT: Parameter<GLint>));
+		this.alignment = alignment != null && alignment > 0 ? alignment : 256;
+		this.frameByteLength = align(frameByteLength, this.alignment);
+
+		var staging = new ArrayBuffer(this.frameByteLength * frameCount);
+		floats = new Float32Array(staging);
+		ints = new Int32Array(staging);
+		bytes = new Uint8Array(staging);
+
+		buffer = gl.createBuffer();
+		gl.bindBuffer(GL2Context.UNIFORM_BUFFER, buffer);
+		gl.bufferDataOfSize(GL2Context.UNIFORM_BUFFER, staging.byteLength, DYNAMIC_DRAW);
+	}
+
+	/**
+		Reserve `byteLength` bytes in the current frame and return their byte offset
+		@throws String if the frame has no room left, increase `frameByteLength`
+	**/
+	public function allocate(byteLength: Int): Int {
+		var offset = align(cursor, alignment);
+		if (offset + byteLength > (frame + 1) * frameByteLength) {
+			throw 'UniformRing frame is full, $frameByteLength bytes per frame cannot fit another $byteLength byte block';
+		}
+		cursor = offset + byteLength;
+		return offset;
+	}
+
+	/**
+		Copy blocks allocated since the last upload to the GPU, binds `buffer` to `UNIFORM_BUFFER`
+	**/
+	public function upload() {
+		if (cursor == uploaded) return;
+		gl.bindBuffer(GL2Context.UNIFORM_BUFFER, buffer);
+		gl.bufferSubData(GL2Context.UNIFORM_BUFFER, uploaded, bytes, uploaded, cursor - uploaded);
+		uploaded = cursor;
+	}
+
+	/**
+		Bind a block returned by `allocate()` to a uniform buffer binding point, see `uniformBlockBinding()`
+	**/
+	public inline function bind(index: GLuint, byteOffset: Int, byteLength: Int) {
+		gl.bindBufferRange(GL2Context.UNIFORM_BUFFER, index, buffer, byteOffset, byteLength);
+	}
+
+	/**
+		Start allocating from the next frame's region, blocks from the oldest frame are overwritten
+	**/
+	public function nextFrame() {
+		frame = (frame + 1) % frameCount;
+		cursor = frame * frameByteLength;
+		uploaded = cursor;
+	}
+
+	static inline function align(value: Int, alignment: Int) {
+		return Std.int((value + alignment - 1) / alignment) * alignment;
+	}
+
+}
\ No newline at end of file
@@ -3,5 +3,55 @@ package webgl.extension;
 #if js
 typedef ANGLEInstancedArrays = js.html.webgl.extension.ANGLEInstancedArrays;
 #else
-typedef ANGLEInstancedArrays = Any;
+import cpp.*;
+import webgl.GLContext;
+import webgl.native.GLExtensionFunctions;
+
+@:allow(webgl.native.GLContext)
+@:access(webgl.native.GLContext)
+class ANGLEInstancedArrays {
+	public final VERTEX_ATTRIB_ARRAY_DIVISOR_ANGLE = 0x88FE;
+
+	final context: webgl.native.GLContext;
+	final glDrawArraysInstanced: Star<cpp.Void>;
+	final glDrawElementsInstanced: Star<cpp.Void>;
+	final glVertexAttribDivisor: Star<cpp.Void>;
+
+	function new(context: webgl.native.GLContext, suffix: String) {
+		this.context = context;
+		this.glDrawArraysInstanced = GLExtensionFunctions.getProc('glDrawArraysInstanced' + suffix);
+		this.glDrawElementsInstanced = GLExtensionFunctions.getProc('glDrawElementsInstanced' + suffix);
+		this.glVertexAttribDivisor = GLExtensionFunctions.getProc('glVertexAttribDivisor' + suffix);
+	}
+
+	/**
+		Returns null if the driver doesn't support instanced drawing, the context must be current
+	**/
+	static function create(context: webgl.native.GLContext, glExtensions: Array<String>, glMajorVersion: Int): Null<ANGLEInstancedArrays> {
+		var suffixes = new Array<String>();
+		for (extension in ['ANGLE', 'EXT', 'NV', 'ARB']) {
+			if (glExtensions.indexOf(extension + '_instanced_arrays') != -1) suffixes.push(extension);
+		}
+		// core in GLES 3 and GL 3.3
+		if (glMajorVersion >= 3) suffixes.push('');
+		var suffix = GLExtensionFunctions.findSuffix(['glDrawArraysInstanced', 'glDrawElementsInstanced', 'glVertexAttribDivisor'], suffixes);
+		return suffix != null ? new ANGLEInstancedArrays(context, suffix) : null;
+	}
+
+	public inline function drawArraysInstancedANGLE(mode: DrawMode, first: GLint, count: GLsizei, primcount: GLsizei) {
+		context.setContext();
+		GLExtensionFunctions.drawArraysInstanced(glDrawArraysInstanced, mode, first, count, primcount);
+	}
+
+	public inline function drawElementsInstancedANGLE(mode: DrawMode, count: GLsizei, type: DataType, offset: GLintptr, primcount: GLsizei) {
+		context.setContext();
+		var offsetAsPointer: ConstStar<cpp.Void> = untyped __cpp__('reinterpret_cast<void*>({0})', offset);
+		GLExtensionFunctions.drawElementsInstanced(glDrawElementsInstanced, mode, count, type, offsetAsPointer, primcount);
+	}
+
+	public inline function vertexAttribDivisorANGLE(index: GLuint, divisor: GLuint) {
+		context.setContext();
+		GLExtensionFunctions.vertexAttribDivisor(glVertexAttribDivisor, index, divisor);
+	}
+}
 #end
\ No newline at end of file
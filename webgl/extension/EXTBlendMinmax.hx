@@ -3,5 +3,14 @@ package webgl.extension;
 #if js
 typedef EXTBlendMinmax = js.html.webgl.extension.EXTBlendMinmax;
 #else
-typedef EXTBlendMinmax = Dynamic;
+/**
+	Core in desktop GL and GLES 3
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTBlendMinmax {
+	public final MIN_EXT = 0x8007;
+	public final MAX_EXT = 0x8008;
+
+	function new() {}
+}
 #end
\ No newline at end of file
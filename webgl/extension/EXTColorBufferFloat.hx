@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef EXTColorBufferFloat = js.html.webgl.extension.EXTColorBufferFloat;
 #else
-typedef EXTColorBufferFloat = Dynamic;
+/**
+	Float color attachments, no constants of its own
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTColorBufferFloat {
+	function new() {}
+}
 #end
\ No newline at end of file
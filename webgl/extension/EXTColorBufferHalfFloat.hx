@@ -3,5 +3,16 @@ package webgl.extension;
 #if js
 typedef EXTColorBufferHalfFloat = js.html.webgl.extension.EXTColorBufferHalfFloat;
 #else
-typedef EXTColorBufferHalfFloat = Dynamic;
+/**
+	Half float color attachments
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTColorBufferHalfFloat {
+	public final RGBA16F_EXT = 0x881A;
+	public final RGB16F_EXT = 0x881B;
+	public final FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE_EXT = 0x8211;
+	public final UNSIGNED_NORMALIZED_EXT = 0x8C17;
+
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,134 @@ package webgl.extension;
 #if js
 typedef EXTDisjointTimerQuery = js.html.webgl.extension.EXTDisjointTimerQuery;
 #else
-typedef EXTDisjointTimerQuery = Dynamic;
-#end
+import cpp.*;
+import webgl.GLContext;
+import webgl.native.GLExtensionFunctions;
+import webgl.native.GLTimerQuery;
+
+@:allow(webgl.native.GLContext)
+@:allow(webgl.native.GLExtensionRegistry)
+@:allow(webgl.native.GLTimerQuery)
+@:access(webgl.native.GLContext)
+@:access(webgl.native.GLObject)
+class EXTDisjointTimerQuery {
+	public final QUERY_COUNTER_BITS_EXT = 0x8864;
+	public final CURRENT_QUERY_EXT = 0x8865;
+	public final QUERY_RESULT_EXT = 0x8866;
+	public final QUERY_RESULT_AVAILABLE_EXT = 0x8867;
+	public final TIME_ELAPSED_EXT = 0x88BF;
+	public final TIMESTAMP_EXT = 0x8E28;
+	public final GPU_DISJOINT_EXT = 0x8FBB;
+
+	final context: webgl.native.GLContext;
+	final glGenQueries: Star<cpp.Void>;
+	final glDeleteQueries: Star<cpp.Void>;
+	final glIsQuery: Star<cpp.Void>;
+	final glBeginQuery: Star<cpp.Void>;
+	final glEndQuery: Star<cpp.Void>;
+	final glQueryCounter: Star<cpp.Void>;
+	final glGetQueryiv: Star<cpp.Void>;
+	final glGetQueryObjectuiv: Star<cpp.Void>;
+	final glGetQueryObjectui64v: Star<cpp.Void>;
+	// optional, null if the driver doesn't provide it
+	final glGetInteger64v: Star<cpp.Void>;
+
+	// the query between beginQueryEXT() and endQueryEXT(), returned for CURRENT_QUERY_EXT
+	var currentQuery: Null<GLTimerQuery> = null;
+
+	function new(context: webgl.native.GLContext, suffix: String) {
+		this.context = context;
+		this.glGenQueries = GLExtensionFunctions.getProc('glGenQueries' + suffix);
+		this.glDeleteQueries = GLExtensionFunctions.getProc('glDeleteQueries' + suffix);
+		this.glIsQuery = GLExtensionFunctions.getProc('glIsQuery' + suffix);
+		this.glBeginQuery = GLExtensionFunctions.getProc('glBeginQuery' + suffix);
+		this.glEndQuery = GLExtensionFunctions.getProc('glEndQuery' + suffix);
+		this.glQueryCounter = GLExtensionFunctions.getProc('glQueryCounter' + suffix);
+		this.glGetQueryiv = GLExtensionFunctions.getProc('glGetQueryiv' + suffix);
+		this.glGetQueryObjectuiv = GLExtensionFunctions.getProc('glGetQueryObjectuiv' + suffix);
+		this.glGetQueryObjectui64v = GLExtensionFunctions.getProc('glGetQueryObjectui64v' + suffix);
+		this.glGetInteger64v = GLExtensionFunctions.getProc('glGetInteger64v' + suffix);
+	}
+
+	/**
+		Returns null if the driver doesn't support timer queries, the context must be current
+	**/
+	static function create(context: webgl.native.GLContext, glExtensions: Array<String>): Null<EXTDisjointTimerQuery> {
+		var suffixes = new Array<String>();
+		if (glExtensions.indexOf('EXT_disjoint_timer_query') != -1) suffixes.push('EXT');
+		// desktop GL 3.3
+		if (glExtensions.indexOf('ARB_timer_query') != -1) suffixes.push('');
+		var suffix = GLExtensionFunctions.findSuffix(['glGenQueries', 'glDeleteQueries', 'glIsQuery', 'glBeginQuery', 'glEndQuery', 'glQueryCounter', 'glGetQueryiv', 'glGetQueryObjectuiv', 'glGetQueryObjectui64v'], suffixes);
+		return suffix != null ? new EXTDisjointTimerQuery(context, suffix) : null;
+	}
+
+	public function createQueryEXT(): Null<GLTimerQuery> {
+		context.setContext();
+		var ref: GLuint = 0;
+		GLExtensionFunctions.genQueries(glGenQueries, 1, Native.addressOf(ref));
+		return ref != 0 ? new GLTimerQuery(context, ref, this) : null;
+	}
+
+	public function deleteQueryEXT(?query: GLTimerQuery) {
+		context.setContext();
+		if (query != null) {
+			if (query == currentQuery) currentQuery = null;
+			if (query.handle != 0) GLExtensionFunctions.deleteQueries(glDeleteQueries, 1, Native.addressOf(query.handle));
+			query.handle = 0;
+		}
+	}
+
+	public function isQueryEXT(?query: GLTimerQuery): Bool {
+		context.setContext();
+		return query != null && GLExtensionFunctions.isQuery(glIsQuery, query.handle);
+	}
+
+	public function beginQueryEXT(target: GLenum, query: GLTimerQuery) {
+		context.setContext();
+		GLExtensionFunctions.beginQuery(glBeginQuery, target, query.handle);
+		currentQuery = query;
+	}
+
+	public function endQueryEXT(target: GLenum) {
+		context.setContext();
+		GLExtensionFunctions.endQuery(glEndQuery, target);
+		currentQuery = null;
+	}
+
+	public function queryCounterEXT(query: GLTimerQuery, target: GLenum) {
+		context.setContext();
+		GLExtensionFunctions.queryCounter(glQueryCounter, query.handle, target);
+	}
+
+	/**
+		`CURRENT_QUERY_EXT` returns the active query or null, `QUERY_COUNTER_BITS_EXT` returns an Int
+	**/
+	public function getQueryEXT(target: GLenum, pname: GLenum): Any {
+		context.setContext();
+		if (pname == CURRENT_QUERY_EXT) return currentQuery;
+		return GLExtensionFunctions.getQueryiv(glGetQueryiv, target, pname);
+	}
+
+	/**
+		`QUERY_RESULT_EXT` returns the elapsed time or timestamp in nanoseconds as a Float, `QUERY_RESULT_AVAILABLE_EXT` returns a Bool
+	**/
+	public function getQueryObjectEXT(query: GLTimerQuery, pname: GLenum): Any {
+		context.setContext();
+		if (pname == QUERY_RESULT_EXT) {
+			var result: UInt64 = GLExtensionFunctions.getQueryObjectui64v(glGetQueryObjectui64v, query.handle, pname);
+			var resultFloat: Float = untyped __cpp__('(double){0}', result);
+			return resultFloat;
+		}
+		return GLExtensionFunctions.getQueryObjectuiv(glGetQueryObjectuiv, query.handle, pname) != 0;
+	}
+
+	/**
+		`getParameter(TIMESTAMP_EXT)`, the GPU time in nanoseconds or 0 if the driver can't report it
+	**/
+	function getTimestamp(): Float {
+		if (glGetInteger64v == null) return 0;
+		var timestamp: Int64 = GLExtensionFunctions.getInteger64v(glGetInteger64v, TIMESTAMP_EXT);
+		return untyped __cpp__('(double){0}', timestamp);
+	}
+}
+#end
\ No newline at end of file
@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef EXTFragDepth = js.html.webgl.extension.EXTFragDepth;
 #else
-typedef EXTFragDepth = Dynamic;
+/**
+	Enables `gl_FragDepthEXT` in shaders, no constants or functions
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTFragDepth {
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef EXTShaderTextureLod = js.html.webgl.extension.EXTShaderTextureLod;
 #else
-typedef EXTShaderTextureLod = Dynamic;
+/**
+	Enables the `texture*LodEXT` shader functions, no constants or functions
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTShaderTextureLod {
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,16 @@ package webgl.extension;
 #if js
 typedef EXTSrgb = js.html.webgl.extension.EXTSrgb;
 #else
-typedef EXTSrgb = Dynamic;
+/**
+	sRGB textures and renderbuffers
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTSrgb {
+	public final SRGB_EXT = 0x8C40;
+	public final SRGB_ALPHA_EXT = 0x8C42;
+	public final SRGB8_ALPHA8_EXT = 0x8C43;
+	public final FRAMEBUFFER_ATTACHMENT_COLOR_ENCODING_EXT = 0x8210;
+
+	function new() {}
+}
 #end
\ No newline at end of file
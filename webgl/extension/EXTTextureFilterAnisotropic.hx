@@ -3,5 +3,14 @@ package webgl.extension;
 #if js
 typedef EXTTextureFilterAnisotropic = js.html.webgl.extension.EXTTextureFilterAnisotropic;
 #else
-typedef EXTTextureFilterAnisotropic = Dynamic;
+/**
+	`getParameter(MAX_TEXTURE_MAX_ANISOTROPY_EXT)` returns a float, set per texture with `texParameterf(target, TEXTURE_MAX_ANISOTROPY_EXT, value)`
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class EXTTextureFilterAnisotropic {
+	public final TEXTURE_MAX_ANISOTROPY_EXT = 0x84FE;
+	public final MAX_TEXTURE_MAX_ANISOTROPY_EXT = 0x84FF;
+
+	function new() {}
+}
 #end
\ No newline at end of file
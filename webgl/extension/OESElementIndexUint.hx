@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef OESElementIndexUint = js.html.webgl.extension.OESElementIndexUint;
 #else
-typedef OESElementIndexUint = Dynamic;
+/**
+	Allows `UNSIGNED_INT` indices in `drawElements()`, no constants or functions
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class OESElementIndexUint {
+	function new() {}
+}
 #end
\ No newline at end of file
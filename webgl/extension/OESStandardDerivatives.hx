@@ -3,5 +3,13 @@ package webgl.extension;
 #if js
 typedef OESStandardDerivatives = js.html.webgl.extension.OESStandardDerivatives;
 #else
-typedef OESStandardDerivatives = Dynamic;
+/**
+	Enables `dFdx`, `dFdy` and `fwidth` in shaders
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class OESStandardDerivatives {
+	public final FRAGMENT_SHADER_DERIVATIVE_HINT_OES = 0x8B8B;
+
+	function new() {}
+}
 #end
\ No newline at end of file
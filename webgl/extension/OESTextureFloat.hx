@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef OESTextureFloat = js.html.webgl.extension.OESTextureFloat;
 #else
-typedef OESTextureFloat = Dynamic;
+/**
+	Allows `FLOAT` texture data, no constants or functions
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class OESTextureFloat {
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef OESTextureFloatLinear = js.html.webgl.extension.OESTextureFloatLinear;
 #else
-typedef OESTextureFloatLinear = Dynamic;
+/**
+	Allows linear filtering of float textures, no constants or functions
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class OESTextureFloatLinear {
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,13 @@ package webgl.extension;
 #if js
 typedef OESTextureHalfFloat = js.html.webgl.extension.OESTextureHalfFloat;
 #else
-typedef OESTextureHalfFloat = Dynamic;
+/**
+	Half float texture data
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class OESTextureHalfFloat {
+	public final HALF_FLOAT_OES = 0x8D61;
+
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef OESTextureHalfFloatLinear = js.html.webgl.extension.OESTextureHalfFloatLinear;
 #else
-typedef OESTextureHalfFloatLinear = Dynamic;
+/**
+	Allows linear filtering of half float textures, no constants or functions
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class OESTextureHalfFloatLinear {
+	function new() {}
+}
 #end
\ No newline at end of file
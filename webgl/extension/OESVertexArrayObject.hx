@@ -1,7 +1,76 @@
 package webgl.extension;
 
 #if js
-typedef OESVertexArrayObject = js.html.webgl.extension.EXTTextureFilterAnisotropic;
+typedef OESVertexArrayObject = js.html.webgl.extension.OESVertexArrayObject;
 #else
-typedef OESVertexArrayObject = Dynamic;
+import cpp.*;
+import webgl.GLContext;
+import webgl.native.GLExtensionFunctions;
+import webgl.native.GLVertexArrayObject;
+
+@:allow(webgl.native.GLContext)
+@:access(webgl.native.GLContext)
+@:access(webgl.native.GLObject)
+class OESVertexArrayObject {
+	public final VERTEX_ARRAY_BINDING_OES = 0x85B5;
+
+	final context: webgl.native.GLContext;
+	final glGenVertexArrays: Star<cpp.Void>;
+	final glDeleteVertexArrays: Star<cpp.Void>;
+	final glBindVertexArray: Star<cpp.Void>;
+	final glIsVertexArray: Star<cpp.Void>;
+
+	function new(context: webgl.native.GLContext, suffix: String) {
+		this.context = context;
+		this.glGenVertexArrays = GLExtensionFunctions.getProc('glGenVertexArrays' + suffix);
+		this.glDeleteVertexArrays = GLExtensionFunctions.getProc('glDeleteVertexArrays' + suffix);
+		this.glBindVertexArray = GLExtensionFunctions.getProc('glBindVertexArray' + suffix);
+		this.glIsVertexArray = GLExtensionFunctions.getProc('glIsVertexArray' + suffix);
+	}
+
+	/**
+		Returns null if the driver doesn't support vertex array objects, the context must be current
+	**/
+	static function create(context: webgl.native.GLContext, glExtensions: Array<String>, glMajorVersion: Int): Null<OESVertexArrayObject> {
+		var suffixes = new Array<String>();
+		if (glExtensions.indexOf('OES_vertex_array_object') != -1) suffixes.push('OES');
+		// core in GLES 3 and GL 3
+		if (glMajorVersion >= 3 || glExtensions.indexOf('ARB_vertex_array_object') != -1) suffixes.push('');
+		if (glExtensions.indexOf('APPLE_vertex_array_object') != -1) suffixes.push('APPLE');
+		var suffix = GLExtensionFunctions.findSuffix(['glGenVertexArrays', 'glDeleteVertexArrays', 'glBindVertexArray', 'glIsVertexArray'], suffixes);
+		return suffix != null ? new OESVertexArrayObject(context, suffix) : null;
+	}
+
+	public function createVertexArrayOES(): Null<GLVertexArrayObject> {
+		context.setContext();
+		var ref: GLuint = 0;
+		GLExtensionFunctions.genVertexArrays(glGenVertexArrays, 1, Native.addressOf(ref));
+		return ref != 0 ? new GLVertexArrayObject(context, ref, this) : null;
+	}
+
+	public function deleteVertexArrayOES(?arrayObject: GLVertexArrayObject) {
+		context.setContext();
+		if (arrayObject != null) {
+			#if gl_state_cache
+			context.stateCache.onDeleteVertexArray(arrayObject.handle);
+			#end
+			if (arrayObject.handle != 0) GLExtensionFunctions.deleteVertexArrays(glDeleteVertexArrays, 1, Native.addressOf(arrayObject.handle));
+			arrayObject.handle = 0;
+		}
+	}
+
+	public function isVertexArrayOES(?arrayObject: GLVertexArrayObject): Bool {
+		context.setContext();
+		return arrayObject != null && GLExtensionFunctions.isVertexArray(glIsVertexArray, arrayObject.handle);
+	}
+
+	public function bindVertexArrayOES(?arrayObject: GLVertexArrayObject) {
+		context.setContext();
+		var ref = arrayObject != null ? arrayObject.handle : 0;
+		#if gl_state_cache
+		if (context.stateCache.skipBindVertexArray(ref)) return;
+		#end
+		GLExtensionFunctions.bindVertexArray(glBindVertexArray, ref);
+	}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,15 @@ package webgl.extension;
 #if js
 typedef WEBGLColorBufferFloat = js.html.webgl.extension.WEBGLColorBufferFloat;
 #else
-typedef WEBGLColorBufferFloat = Any;
+/**
+	Float color attachments for WebGL1 contexts
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class WEBGLColorBufferFloat {
+	public final RGBA32F_EXT = 0x8814;
+	public final FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE_EXT = 0x8211;
+	public final UNSIGNED_NORMALIZED_EXT = 0x8C17;
+
+	function new() {}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,46 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTextureAstc = js.html.webgl.extension.WEBGLCompressedTextureAstc;
 #else
-typedef WEBGLCompressedTextureAstc = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTextureAstc extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_RGBA_ASTC_4x4_KHR = 0x93B0;
+	public final COMPRESSED_RGBA_ASTC_5x4_KHR = 0x93B1;
+	public final COMPRESSED_RGBA_ASTC_5x5_KHR = 0x93B2;
+	public final COMPRESSED_RGBA_ASTC_6x5_KHR = 0x93B3;
+	public final COMPRESSED_RGBA_ASTC_6x6_KHR = 0x93B4;
+	public final COMPRESSED_RGBA_ASTC_8x5_KHR = 0x93B5;
+	public final COMPRESSED_RGBA_ASTC_8x6_KHR = 0x93B6;
+	public final COMPRESSED_RGBA_ASTC_8x8_KHR = 0x93B7;
+	public final COMPRESSED_RGBA_ASTC_10x5_KHR = 0x93B8;
+	public final COMPRESSED_RGBA_ASTC_10x6_KHR = 0x93B9;
+	public final COMPRESSED_RGBA_ASTC_10x8_KHR = 0x93BA;
+	public final COMPRESSED_RGBA_ASTC_10x10_KHR = 0x93BB;
+	public final COMPRESSED_RGBA_ASTC_12x10_KHR = 0x93BC;
+	public final COMPRESSED_RGBA_ASTC_12x12_KHR = 0x93BD;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR = 0x93D0;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR = 0x93D1;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR = 0x93D2;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR = 0x93D3;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR = 0x93D4;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR = 0x93D5;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR = 0x93D6;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR = 0x93D7;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR = 0x93D8;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR = 0x93D9;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR = 0x93DA;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR = 0x93DB;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR = 0x93DC;
+	public final COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR = 0x93DD;
+
+	final hdr: Bool;
+
+	function new(formats: Array<Int>, hdr: Bool) {
+		super(formats);
+		this.hdr = hdr;
+	}
+
+	public function getSupportedProfiles(): Array<String> {
+		return hdr ? ['ldr', 'hdr'] : ['ldr'];
+	}
+}
 #end
\ No newline at end of file
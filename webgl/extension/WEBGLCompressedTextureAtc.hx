@@ -3,5 +3,10 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTextureAtc = js.html.webgl.extension.WEBGLCompressedTextureAtc;
 #else
-typedef WEBGLCompressedTextureAtc = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTextureAtc extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_RGB_ATC_WEBGL = 0x8C92;
+	public final COMPRESSED_RGBA_ATC_EXPLICIT_ALPHA_WEBGL = 0x8C93;
+	public final COMPRESSED_RGBA_ATC_INTERPOLATED_ALPHA_WEBGL = 0x87EE;
+}
 #end
\ No newline at end of file
@@ -3,5 +3,17 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTextureEtc = js.html.webgl.extension.WEBGLCompressedTextureEtc;
 #else
-typedef WEBGLCompressedTextureEtc = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTextureEtc extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_R11_EAC = 0x9270;
+	public final COMPRESSED_SIGNED_R11_EAC = 0x9271;
+	public final COMPRESSED_RG11_EAC = 0x9272;
+	public final COMPRESSED_SIGNED_RG11_EAC = 0x9273;
+	public final COMPRESSED_RGB8_ETC2 = 0x9274;
+	public final COMPRESSED_SRGB8_ETC2 = 0x9275;
+	public final COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9276;
+	public final COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 = 0x9277;
+	public final COMPRESSED_RGBA8_ETC2_EAC = 0x9278;
+	public final COMPRESSED_SRGB8_ALPHA8_ETC2_EAC = 0x9279;
+}
 #end
\ No newline at end of file
@@ -3,5 +3,8 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTextureEtc1 = js.html.webgl.extension.WEBGLCompressedTextureEtc1;
 #else
-typedef WEBGLCompressedTextureEtc1 = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTextureEtc1 extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_RGB_ETC1_WEBGL = 0x8D64;
+}
 #end
\ No newline at end of file
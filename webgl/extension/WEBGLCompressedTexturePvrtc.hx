@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTexturePvrtc = js.html.webgl.extension.WEBGLCompressedTexturePvrtc;
 #else
-typedef WEBGLCompressedTexturePvrtc = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTexturePvrtc extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_RGB_PVRTC_4BPPV1_IMG = 0x8C00;
+	public final COMPRESSED_RGB_PVRTC_2BPPV1_IMG = 0x8C01;
+	public final COMPRESSED_RGBA_PVRTC_4BPPV1_IMG = 0x8C02;
+	public final COMPRESSED_RGBA_PVRTC_2BPPV1_IMG = 0x8C03;
+}
 #end
\ No newline at end of file
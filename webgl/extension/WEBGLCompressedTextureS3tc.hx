@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTextureS3tc = js.html.webgl.extension.WEBGLCompressedTextureS3tc;
 #else
-typedef WEBGLCompressedTextureS3tc = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTextureS3tc extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_RGB_S3TC_DXT1_EXT = 0x83F0;
+	public final COMPRESSED_RGBA_S3TC_DXT1_EXT = 0x83F1;
+	public final COMPRESSED_RGBA_S3TC_DXT3_EXT = 0x83F2;
+	public final COMPRESSED_RGBA_S3TC_DXT5_EXT = 0x83F3;
+}
 #end
\ No newline at end of file
@@ -3,5 +3,11 @@ package webgl.extension;
 #if js
 typedef WEBGLCompressedTextureS3tcSrgb = js.html.webgl.extension.WEBGLCompressedTextureS3tcSrgb;
 #else
-typedef WEBGLCompressedTextureS3tcSrgb = Any;
+@:allow(webgl.native.CompressedTextureExtension)
+class WEBGLCompressedTextureS3tcSrgb extends webgl.native.CompressedTextureExtension {
+	public final COMPRESSED_SRGB_S3TC_DXT1_EXT = 0x8C4C;
+	public final COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT = 0x8C4D;
+	public final COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT = 0x8C4E;
+	public final COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT = 0x8C4F;
+}
 #end
\ No newline at end of file
@@ -3,5 +3,14 @@ package webgl.extension;
 #if js
 typedef WEBGLDebugRendererInfo = js.html.webgl.extension.WEBGLDebugRendererInfo;
 #else
-typedef WEBGLDebugRendererInfo = Any;
+/**
+	`getParameter()` with these returns the driver's `VENDOR` and `RENDERER` strings
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class WEBGLDebugRendererInfo {
+	public final UNMASKED_VENDOR_WEBGL = 0x9245;
+	public final UNMASKED_RENDERER_WEBGL = 0x9246;
+
+	function new() {}
+}
 #end
\ No newline at end of file
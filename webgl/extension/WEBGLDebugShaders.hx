@@ -3,5 +3,19 @@ package webgl.extension;
 #if js
 typedef WEBGLDebugShaders = js.html.webgl.extension.WEBGLDebugShaders;
 #else
-typedef WEBGLDebugShaders = Any;
+@:allow(webgl.native.GLExtensionRegistry)
+class WEBGLDebugShaders {
+	final context: webgl.native.GLContext;
+
+	function new(context: webgl.native.GLContext) {
+		this.context = context;
+	}
+
+	/**
+		Shader source is passed to the driver unmodified, so this is the source given to `shaderSource()`
+	**/
+	public inline function getTranslatedShaderSource(shader: webgl.GLShader): String {
+		return context.getShaderSource(shader);
+	}
+}
 #end
\ No newline at end of file
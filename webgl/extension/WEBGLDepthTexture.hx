@@ -3,5 +3,13 @@ package webgl.extension;
 #if js
 typedef WEBGLDepthTexture = js.html.webgl.extension.WEBGLDepthTexture;
 #else
-typedef WEBGLDepthTexture = Any;
+/**
+	Depth and depth-stencil textures
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+class WEBGLDepthTexture {
+	public final UNSIGNED_INT_24_8_WEBGL = 0x84FA;
+
+	function new() {}
+}
 #end
\ No newline at end of file
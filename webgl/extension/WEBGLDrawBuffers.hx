@@ -3,5 +3,76 @@ package webgl.extension;
 #if js
 typedef WEBGLDrawBuffers = js.html.webgl.extension.WEBGLDrawBuffers;
 #else
-typedef WEBGLDrawBuffers = Any;
+import cpp.*;
+import webgl.GLContext;
+import typedarray.Uint32Array;
+import webgl.native.GLExtensionFunctions;
+
+@:allow(webgl.native.GLExtensionRegistry)
+class WEBGLDrawBuffers {
+	public final COLOR_ATTACHMENT0_WEBGL = 0x8CE0;
+	public final COLOR_ATTACHMENT1_WEBGL = 0x8CE1;
+	public final COLOR_ATTACHMENT2_WEBGL = 0x8CE2;
+	public final COLOR_ATTACHMENT3_WEBGL = 0x8CE3;
+	public final COLOR_ATTACHMENT4_WEBGL = 0x8CE4;
+	public final COLOR_ATTACHMENT5_WEBGL = 0x8CE5;
+	public final COLOR_ATTACHMENT6_WEBGL = 0x8CE6;
+	public final COLOR_ATTACHMENT7_WEBGL = 0x8CE7;
+	public final COLOR_ATTACHMENT8_WEBGL = 0x8CE8;
+	public final COLOR_ATTACHMENT9_WEBGL = 0x8CE9;
+	public final COLOR_ATTACHMENT10_WEBGL = 0x8CEA;
+	public final COLOR_ATTACHMENT11_WEBGL = 0x8CEB;
+	public final COLOR_ATTACHMENT12_WEBGL = 0x8CEC;
+	public final COLOR_ATTACHMENT13_WEBGL = 0x8CED;
+	public final COLOR_ATTACHMENT14_WEBGL = 0x8CEE;
+	public final COLOR_ATTACHMENT15_WEBGL = 0x8CEF;
+	public final DRAW_BUFFER0_WEBGL = 0x8825;
+	public final DRAW_BUFFER1_WEBGL = 0x8826;
+	public final DRAW_BUFFER2_WEBGL = 0x8827;
+	public final DRAW_BUFFER3_WEBGL = 0x8828;
+	public final DRAW_BUFFER4_WEBGL = 0x8829;
+	public final DRAW_BUFFER5_WEBGL = 0x882A;
+	public final DRAW_BUFFER6_WEBGL = 0x882B;
+	public final DRAW_BUFFER7_WEBGL = 0x882C;
+	public final DRAW_BUFFER8_WEBGL = 0x882D;
+	public final DRAW_BUFFER9_WEBGL = 0x882E;
+	public final DRAW_BUFFER10_WEBGL = 0x882F;
+	public final DRAW_BUFFER11_WEBGL = 0x8830;
+	public final DRAW_BUFFER12_WEBGL = 0x8831;
+	public final DRAW_BUFFER13_WEBGL = 0x8832;
+	public final DRAW_BUFFER14_WEBGL = 0x8833;
+	public final DRAW_BUFFER15_WEBGL = 0x8834;
+	public final MAX_COLOR_ATTACHMENTS_WEBGL = 0x8CDF;
+	public final MAX_DRAW_BUFFERS_WEBGL = 0x8824;
+
+	final context: webgl.native.GLContext;
+	final glDrawBuffers: Star<cpp.Void>;
+	final buffers = new Uint32Array(16);
+
+	function new(context: webgl.native.GLContext, suffix: String) {
+		this.context = context;
+		this.glDrawBuffers = GLExtensionFunctions.getProc('glDrawBuffers' + suffix);
+	}
+
+	/**
+		Returns null if the driver doesn't support multiple render targets, the context must be current
+	**/
+	static function create(context: webgl.native.GLContext, glExtensions: Array<String>, glMajorVersion: Int): Null<WEBGLDrawBuffers> {
+		var suffixes = new Array<String>();
+		for (extension in ['EXT', 'NV', 'ARB']) {
+			if (glExtensions.indexOf(extension + '_draw_buffers') != -1) suffixes.push(extension);
+		}
+		// core in GLES 3 and GL 2
+		if (glMajorVersion >= 2) suffixes.push('');
+		var suffix = GLExtensionFunctions.findSuffix(['glDrawBuffers'], suffixes);
+		return suffix != null ? new WEBGLDrawBuffers(context, suffix) : null;
+	}
+
+	public function drawBuffersWEBGL(buffers: Array<GLenum>) {
+		context.setContext();
+		var n = buffers.length < 16 ? buffers.length : 16;
+		for (i in 0...n) this.buffers[i] = buffers[i];
+		GLExtensionFunctions.drawBuffers(glDrawBuffers, n, this.buffers.toCPointer());
+	}
+}
 #end
\ No newline at end of file
@@ -3,5 +3,25 @@ package webgl.extension;
 #if js
 typedef WEBGLLoseContext = js.html.webgl.extension.WEBGLLoseContext;
 #else
-typedef WEBGLLoseContext = Any;
+/**
+	Native contexts are owned by the host app, which reports loss and restoration through `onGraphicsContextLost()` and `onGraphicsContextReady()`.
+	`loseContext()` only marks the context as lost so `isContextLost()` returns true, the native context is untouched; `restoreContext()` clears it
+**/
+@:allow(webgl.native.GLExtensionRegistry)
+@:access(webgl.native.GLContext)
+class WEBGLLoseContext {
+	final context: webgl.native.GLContext;
+
+	function new(context: webgl.native.GLContext) {
+		this.context = context;
+	}
+
+	public function loseContext() {
+		context.markLost();
+	}
+
+	public function restoreContext() {
+		context.markRestored();
+	}
+}
 #end
\ No newline at end of file
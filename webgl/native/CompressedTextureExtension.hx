@@ -0,0 +1,109 @@
+package webgl.native;
+
+import webgl.extension.*;
+
+/**
+	Base of the native `WEBGL_compressed_texture_*` extension objects
+
+	Desktop and mobile drivers expose compressed formats under several GL extension names, each WebGL extension is enabled when any of its aliases is present
+	or the driver lists one of its formats in `COMPRESSED_TEXTURE_FORMATS`
+**/
+@:allow(webgl.native.GLContext)
+@:noCompletion
+class CompressedTextureExtension {
+
+	/**
+		Formats of this extension the driver accepts in `compressedTexImage2D`
+	**/
+	public final formats: Array<Int>;
+
+	function new(formats: Array<Int>) {
+		this.formats = formats;
+	}
+
+	/**
+		WebGL compressed texture extension names, in the order they're reported by `getSupportedExtensions()`
+	**/
+	static final names = [
+		'WEBGL_compressed_texture_s3tc',
+		'WEBGL_compressed_texture_s3tc_srgb',
+		'WEBGL_compressed_texture_etc',
+		'WEBGL_compressed_texture_etc1',
+		'WEBGL_compressed_texture_astc',
+		'WEBGL_compressed_texture_pvrtc',
+		'WEBGL_compressed_texture_atc',
+	];
+
+	/**
+		Returns null if `name` isn't a compressed texture extension or the driver doesn't support it
+		- `glExtensions` is the driver's extension list without the GL_ prefix
+		- `driverFormats` is the driver's `COMPRESSED_TEXTURE_FORMATS`
+	**/
+	static function create(name: String, glExtensions: Array<String>, driverFormats: Array<Int>): Null<CompressedTextureExtension> {
+		var formats = supportedFormats(name, glExtensions, driverFormats);
+		if (formats == null) return null;
+		return switch name {
+			case 'WEBGL_compressed_texture_s3tc': new WEBGLCompressedTextureS3tc(formats);
+			case 'WEBGL_compressed_texture_s3tc_srgb': new WEBGLCompressedTextureS3tcSrgb(formats);
+			case 'WEBGL_compressed_texture_etc': new WEBGLCompressedTextureEtc(formats);
+			case 'WEBGL_compressed_texture_etc1': new WEBGLCompressedTextureEtc1(formats);
+			case 'WEBGL_compressed_texture_astc': new WEBGLCompressedTextureAstc(formats, glExtensions.indexOf('KHR_texture_compression_astc_hdr') != -1);
+			case 'WEBGL_compressed_texture_pvrtc': new WEBGLCompressedTexturePvrtc(formats);
+			case 'WEBGL_compressed_texture_atc': new WEBGLCompressedTextureAtc(formats);
+			default: null;
+		}
+	}
+
+	/**
+		Returns null if the extension is unsupported. If the driver doesn't list any of the extension's formats (some drivers leave `COMPRESSED_TEXTURE_FORMATS` empty) every format of the extension is assumed supported
+	**/
+	static function supportedFormats(name: String, glExtensions: Array<String>, driverFormats: Array<Int>): Null<Array<Int>> {
+		var aliases = glAliases(name);
+		var allFormats = extensionFormats(name);
+		if (aliases == null || allFormats == null) return null;
+
+		var listedFormats = allFormats.filter(format -> driverFormats.indexOf(format) != -1);
+		var hasAlias = false;
+		for (alias in aliases) {
+			if (glExtensions.indexOf(alias) != -1) {
+				hasAlias = true;
+				break;
+			}
+		}
+
+		return if (listedFormats.length > 0) {
+			listedFormats;
+		} else if (hasAlias) {
+			allFormats;
+		} else {
+			null;
+		}
+	}
+
+	static function glAliases(name: String): Null<Array<String>> {
+		return switch name {
+			case 'WEBGL_compressed_texture_s3tc': ['EXT_texture_compression_s3tc', 'WEBGL_compressed_texture_s3tc'];
+			case 'WEBGL_compressed_texture_s3tc_srgb': ['EXT_texture_compression_s3tc_srgb', 'EXT_texture_sRGB', 'NV_sRGB_formats'];
+			case 'WEBGL_compressed_texture_etc': ['ARB_ES3_compatibility', 'OES_compressed_ETC2_RGB8_texture'];
+			case 'WEBGL_compressed_texture_etc1': ['OES_compressed_ETC1_RGB8_texture'];
+			case 'WEBGL_compressed_texture_astc': ['KHR_texture_compression_astc_ldr', 'OES_texture_compression_astc'];
+			case 'WEBGL_compressed_texture_pvrtc': ['IMG_texture_compression_pvrtc'];
+			case 'WEBGL_compressed_texture_atc': ['AMD_compressed_ATC_texture', 'ATI_texture_compression_atitc'];
+			default: null;
+		}
+	}
+
+	static function extensionFormats(name: String): Null<Array<Int>> {
+		return switch name {
+			case 'WEBGL_compressed_texture_s3tc': [0x83F0, 0x83F1, 0x83F2, 0x83F3];
+			case 'WEBGL_compressed_texture_s3tc_srgb': [0x8C4C, 0x8C4D, 0x8C4E, 0x8C4F];
+			case 'WEBGL_compressed_texture_etc': [for (format in 0x9270...0x927A) format];
+			case 'WEBGL_compressed_texture_etc1': [0x8D64];
+			case 'WEBGL_compressed_texture_astc': [for (format in 0x93B0...0x93BE) format].concat([for (format in 0x93D0...0x93DE) format]);
+			case 'WEBGL_compressed_texture_pvrtc': [0x8C00, 0x8C01, 0x8C02, 0x8C03];
+			case 'WEBGL_compressed_texture_atc': [0x8C92, 0x8C93, 0x87EE];
+			default: null;
+		}
+	}
+
+}
@@ -186,6 +186,7 @@ class ES2ContextMacro {
 			</section>
 			<section if="android">
 				<lib name="-lGLESv2" unless="static_link" />
+				<lib name="-lEGL" unless="static_link" />
 			</section>
 		</target>
 
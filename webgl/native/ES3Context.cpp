@@ -0,0 +1,62 @@
+#include "./ES3Context.h"
+
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+thread_local const WebGL_ES3Functions* webglES3 = NULL;
+
+// every table returned by WebGL_loadES3Functions(), contexts may be created on different threads
+typedef struct WebGL_ES3FunctionsNode {
+	WebGL_ES3Functions functions;
+	struct WebGL_ES3FunctionsNode* next;
+} WebGL_ES3FunctionsNode;
+
+static WebGL_ES3FunctionsNode* webglES3Tables = NULL;
+static std::mutex webglES3TablesMutex;
+
+static int WebGL_majorVersion() {
+	const char* version = (const char*) glGetString(GL_VERSION);
+	if (version == NULL) return 0;
+	// "OpenGL ES 3.0 ..." or "3.3.0 ..."
+	while (*version != '\0' && (*version < '0' || *version > '9')) version++;
+	int major = 0;
+	int minor = 0;
+	if (sscanf(version, "%d.%d", &major, &minor) != 2) return 0;
+	// desktop GL 3.0 - 3.2 lack instancing and samplers
+	bool isES = strstr((const char*) glGetString(GL_VERSION), "OpenGL ES") != NULL;
+	if (!isES && major == 3 && minor < 3) return 2;
+	return major;
+}
+
+const WebGL_ES3Functions* WebGL_loadES3Functions() {
+	if (WebGL_majorVersion() < 3) return NULL;
+
+	WebGL_ES3Functions functions = {};
+	bool complete = true;
+
+	#define WEBGL_ES3_LOAD(ret, name, params, args) \
+		functions.name = (ret (WEBGL_APIENTRY *) params) WebGL_getProcAddress("gl" #name); \
+		complete = complete && functions.name != NULL;
+	WEBGL_ES3_FUNCTIONS(WEBGL_ES3_LOAD)
+	#undef WEBGL_ES3_LOAD
+
+	#define WEBGL_ES3_LOAD_OPTIONAL(ret, name, params, args) \
+		functions.name = (ret (WEBGL_APIENTRY *) params) WebGL_getProcAddress("gl" #name);
+	WEBGL_ES3_OPTIONAL_FUNCTIONS(WEBGL_ES3_LOAD_OPTIONAL)
+	#undef WEBGL_ES3_LOAD_OPTIONAL
+
+	if (!complete) return NULL;
+
+	std::lock_guard<std::mutex> lock(webglES3TablesMutex);
+	for (WebGL_ES3FunctionsNode* node = webglES3Tables; node != NULL; node = node->next) {
+		if (memcmp(&node->functions, &functions, sizeof(functions)) == 0) return &node->functions;
+	}
+	WebGL_ES3FunctionsNode* node = (WebGL_ES3FunctionsNode*) malloc(sizeof(WebGL_ES3FunctionsNode));
+	if (node == NULL) return NULL;
+	node->functions = functions;
+	node->next = webglES3Tables;
+	webglES3Tables = node;
+	return &node->functions;
+}
@@ -0,0 +1,109 @@
+#ifndef WEBGL_NATIVE_ES3_CONTEXT_H
+#define WEBGL_NATIVE_ES3_CONTEXT_H
+
+#include "./GLExtensionFunctions.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// GLES2 headers don't declare the ES3 types
+typedef void* WebGLsync;
+typedef uint64_t WebGLuint64;
+
+/**
+ * OpenGL ES 3.0 entry points used by GL2Context, the GLES2 headers don't declare them so they are always called through function pointers
+ * X(return type, name without gl prefix, parameters, arguments)
+ */
+#define WEBGL_ES3_FUNCTIONS(X) \
+	X(void, CopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size)) \
+	X(void*, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access)) \
+	X(GLboolean, UnmapBuffer, (GLenum target), (target)) \
+	X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+	X(void, BindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size)) \
+	X(void, DrawRangeElements, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices), (mode, start, end, count, type, indices)) \
+	X(void, DrawBuffers, (GLsizei n, const GLenum* bufs), (n, bufs)) \
+	X(void, ReadBuffer, (GLenum src), (src)) \
+	X(void, ClearBufferiv, (GLenum buffer, GLint drawbuffer, const GLint* value), (buffer, drawbuffer, value)) \
+	X(void, ClearBufferuiv, (GLenum buffer, GLint drawbuffer, const GLuint* value), (buffer, drawbuffer, value)) \
+	X(void, ClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat* value), (buffer, drawbuffer, value)) \
+	X(void, ClearBufferfi, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (buffer, drawbuffer, depth, stencil)) \
+	X(void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)) \
+	X(void, FramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer), (target, attachment, texture, level, layer)) \
+	X(void, RenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height)) \
+	X(void, TexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels)) \
+	X(void, TexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels)) \
+	X(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer), (index, size, type, stride, pointer)) \
+	X(void, VertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w)) \
+	X(void, VertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w)) \
+	X(void, Uniform1ui, (GLint location, GLuint v0), (location, v0)) \
+	X(void, Uniform2ui, (GLint location, GLuint v0, GLuint v1), (location, v0, v1)) \
+	X(void, Uniform3ui, (GLint location, GLuint v0, GLuint v1, GLuint v2), (location, v0, v1, v2)) \
+	X(void, Uniform4ui, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (location, v0, v1, v2, v3)) \
+	X(void, Uniform1uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+	X(void, Uniform2uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+	X(void, Uniform3uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+	X(void, Uniform4uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+	X(void, UniformMatrix2x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(void, UniformMatrix3x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(void, UniformMatrix2x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(void, UniformMatrix4x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(void, UniformMatrix3x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(void, UniformMatrix4x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(GLuint, GetUniformBlockIndex, (GLuint program, const GLchar* uniformBlockName), (program, uniformBlockName)) \
+	X(void, GetActiveUniformBlockiv, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint* params), (program, uniformBlockIndex, pname, params)) \
+	X(void, UniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding)) \
+	X(void, GenSamplers, (GLsizei count, GLuint* samplers), (count, samplers)) \
+	X(void, DeleteSamplers, (GLsizei count, const GLuint* samplers), (count, samplers)) \
+	X(GLboolean, IsSampler, (GLuint sampler), (sampler)) \
+	X(void, BindSampler, (GLuint unit, GLuint sampler), (unit, sampler)) \
+	X(void, SamplerParameteri, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param)) \
+	X(void, SamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param)) \
+	X(WebGLsync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+	X(GLenum, ClientWaitSync, (WebGLsync sync, GLbitfield flags, WebGLuint64 timeout), (sync, flags, timeout)) \
+	X(void, DeleteSync, (WebGLsync sync), (sync))
+
+/**
+ * Part of ES 3.0 but missing from desktop GL before 4.2, these may be NULL
+ */
+#define WEBGL_ES3_OPTIONAL_FUNCTIONS(X) \
+	X(void, TexStorage2D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (target, levels, internalformat, width, height)) \
+	X(void, TexStorage3D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (target, levels, internalformat, width, height, depth))
+
+#define WEBGL_ES3_FIELD(ret, name, params, args) ret (WEBGL_APIENTRY * name) params;
+
+typedef struct {
+	WEBGL_ES3_FUNCTIONS(WEBGL_ES3_FIELD)
+	WEBGL_ES3_OPTIONAL_FUNCTIONS(WEBGL_ES3_FIELD)
+} WebGL_ES3Functions;
+
+#undef WEBGL_ES3_FIELD
+
+/**
+ * Entry points of the GL2Context current on this thread, set by `GLContext.setContext()`
+ * Each context keeps its own table because drivers may return different entry points per context (e.g. two GPUs or a software fallback)
+ */
+extern thread_local const WebGL_ES3Functions* webglES3;
+
+/**
+ * Looks up the ES3 entry points of the current context
+ * Returns NULL if the context isn't ES 3.0 / GL 3.3 or any required entry point is missing
+ * Tables are never freed, contexts with identical entry points share one
+ */
+const WebGL_ES3Functions* WebGL_loadES3Functions();
+
+static inline void WebGL_setES3Functions(const void* functions) {
+	webglES3 = (const WebGL_ES3Functions*) functions;
+}
+
+// WebGL_<name>(...) calls gl<name>(...)
+#define WEBGL_ES3_CALL(ret, name, params, args) static inline ret WebGL_##name params { return webglES3->name args; }
+WEBGL_ES3_FUNCTIONS(WEBGL_ES3_CALL)
+WEBGL_ES3_OPTIONAL_FUNCTIONS(WEBGL_ES3_CALL)
+#undef WEBGL_ES3_CALL
+
+static inline bool WebGL_hasTexStorage() {
+	return webglES3->TexStorage2D != NULL && webglES3->TexStorage3D != NULL;
+}
+
+#endif
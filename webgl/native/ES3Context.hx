@@ -0,0 +1,68 @@
+package webgl.native;
+
+import cpp.*;
+import webgl.GLContext;
+
+/**
+	OpenGL ES 3.0 entry points, loaded at runtime with `WebGL_loadES3Functions()` (see ES3Context.h)
+**/
+@:native('')
+@:include('./ES3Context.h')
+@:sourceFile('./ES3Context.cpp')
+@:unreflective
+extern class ES3Context {
+
+	@:native('WebGL_loadES3Functions') static function loadES3Functions(): ConstStar<cpp.Void>;
+	@:native('WebGL_setES3Functions') static function setES3Functions(functions: ConstStar<cpp.Void>): Void;
+	@:native('WebGL_hasTexStorage') static function hasTexStorage(): Bool;
+
+	@:native('WebGL_CopyBufferSubData') static function glCopyBufferSubData(readTarget: GLenum, writeTarget: GLenum, readOffset: GLintptr, writeOffset: GLintptr, size: GLsizeiptr): Void;
+	@:native('WebGL_MapBufferRange') static function glMapBufferRange(target: GLenum, offset: GLintptr, length: GLsizeiptr, access: GLbitfield): Star<cpp.Void>;
+	@:native('WebGL_UnmapBuffer') static function glUnmapBuffer(target: GLenum): Bool;
+	@:native('WebGL_BindBufferBase') static function glBindBufferBase(target: GLenum, index: GLuint, buffer: GLuint): Void;
+	@:native('WebGL_BindBufferRange') static function glBindBufferRange(target: GLenum, index: GLuint, buffer: GLuint, offset: GLintptr, size: GLsizeiptr): Void;
+	@:native('WebGL_DrawRangeElements') static function glDrawRangeElements(mode: GLenum, start: GLuint, end: GLuint, count: GLsizei, type: GLenum, indices: ConstStar<cpp.Void>): Void;
+	@:native('WebGL_DrawBuffers') static function glDrawBuffers(n: GLsizei, bufs: ConstStar<GLenum>): Void;
+	@:native('WebGL_ReadBuffer') static function glReadBuffer(src: GLenum): Void;
+	@:native('WebGL_ClearBufferiv') static function glClearBufferiv(buffer: GLenum, drawbuffer: GLint, value: ConstStar<GLint>): Void;
+	@:native('WebGL_ClearBufferuiv') static function glClearBufferuiv(buffer: GLenum, drawbuffer: GLint, value: ConstStar<GLuint>): Void;
+	@:native('WebGL_ClearBufferfv') static function glClearBufferfv(buffer: GLenum, drawbuffer: GLint, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_ClearBufferfi') static function glClearBufferfi(buffer: GLenum, drawbuffer: GLint, depth: GLfloat, stencil: GLint): Void;
+	@:native('WebGL_BlitFramebuffer') static function glBlitFramebuffer(srcX0: GLint, srcY0: GLint, srcX1: GLint, srcY1: GLint, dstX0: GLint, dstY0: GLint, dstX1: GLint, dstY1: GLint, mask: GLbitfield, filter: GLenum): Void;
+	@:native('WebGL_FramebufferTextureLayer') static function glFramebufferTextureLayer(target: GLenum, attachment: GLenum, texture: GLuint, level: GLint, layer: GLint): Void;
+	@:native('WebGL_RenderbufferStorageMultisample') static function glRenderbufferStorageMultisample(target: GLenum, samples: GLsizei, internalformat: GLenum, width: GLsizei, height: GLsizei): Void;
+	@:native('WebGL_TexImage3D') static function glTexImage3D(target: GLenum, level: GLint, internalformat: GLint, width: GLsizei, height: GLsizei, depth: GLsizei, border: GLint, format: GLenum, type: GLenum, pixels: ConstStar<cpp.Void>): Void;
+	@:native('WebGL_TexSubImage3D') static function glTexSubImage3D(target: GLenum, level: GLint, xoffset: GLint, yoffset: GLint, zoffset: GLint, width: GLsizei, height: GLsizei, depth: GLsizei, format: GLenum, type: GLenum, pixels: ConstStar<cpp.Void>): Void;
+	@:native('WebGL_TexStorage2D') static function glTexStorage2D(target: GLenum, levels: GLsizei, internalformat: GLenum, width: GLsizei, height: GLsizei): Void;
+	@:native('WebGL_TexStorage3D') static function glTexStorage3D(target: GLenum, levels: GLsizei, internalformat: GLenum, width: GLsizei, height: GLsizei, depth: GLsizei): Void;
+	@:native('WebGL_VertexAttribIPointer') static function glVertexAttribIPointer(index: GLuint, size: GLint, type: GLenum, stride: GLsizei, pointer: ConstStar<cpp.Void>): Void;
+	@:native('WebGL_VertexAttribI4i') static function glVertexAttribI4i(index: GLuint, x: GLint, y: GLint, z: GLint, w: GLint): Void;
+	@:native('WebGL_VertexAttribI4ui') static function glVertexAttribI4ui(index: GLuint, x: GLuint, y: GLuint, z: GLuint, w: GLuint): Void;
+	@:native('WebGL_Uniform1ui') static function glUniform1ui(location: GLint, v0: GLuint): Void;
+	@:native('WebGL_Uniform2ui') static function glUniform2ui(location: GLint, v0: GLuint, v1: GLuint): Void;
+	@:native('WebGL_Uniform3ui') static function glUniform3ui(location: GLint, v0: GLuint, v1: GLuint, v2: GLuint): Void;
+	@:native('WebGL_Uniform4ui') static function glUniform4ui(location: GLint, v0: GLuint, v1: GLuint, v2: GLuint, v3: GLuint): Void;
+	@:native('WebGL_Uniform1uiv') static function glUniform1uiv(location: GLint, count: GLsizei, value: ConstStar<GLuint>): Void;
+	@:native('WebGL_Uniform2uiv') static function glUniform2uiv(location: GLint, count: GLsizei, value: ConstStar<GLuint>): Void;
+	@:native('WebGL_Uniform3uiv') static function glUniform3uiv(location: GLint, count: GLsizei, value: ConstStar<GLuint>): Void;
+	@:native('WebGL_Uniform4uiv') static function glUniform4uiv(location: GLint, count: GLsizei, value: ConstStar<GLuint>): Void;
+	@:native('WebGL_UniformMatrix2x3fv') static function glUniformMatrix2x3fv(location: GLint, count: GLsizei, transpose: Bool, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_UniformMatrix3x2fv') static function glUniformMatrix3x2fv(location: GLint, count: GLsizei, transpose: Bool, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_UniformMatrix2x4fv') static function glUniformMatrix2x4fv(location: GLint, count: GLsizei, transpose: Bool, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_UniformMatrix4x2fv') static function glUniformMatrix4x2fv(location: GLint, count: GLsizei, transpose: Bool, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_UniformMatrix3x4fv') static function glUniformMatrix3x4fv(location: GLint, count: GLsizei, transpose: Bool, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_UniformMatrix4x3fv') static function glUniformMatrix4x3fv(location: GLint, count: GLsizei, transpose: Bool, value: ConstStar<GLfloat>): Void;
+	@:native('WebGL_GetUniformBlockIndex') static function glGetUniformBlockIndex(program: GLuint, uniformBlockName: ConstCharStar): GLuint;
+	@:native('WebGL_GetActiveUniformBlockiv') static function glGetActiveUniformBlockiv(program: GLuint, uniformBlockIndex: GLuint, pname: GLenum, params: Star<GLint>): Void;
+	@:native('WebGL_UniformBlockBinding') static function glUniformBlockBinding(program: GLuint, uniformBlockIndex: GLuint, uniformBlockBinding: GLuint): Void;
+	@:native('WebGL_GenSamplers') static function glGenSamplers(count: GLsizei, samplers: Star<GLuint>): Void;
+	@:native('WebGL_DeleteSamplers') static function glDeleteSamplers(count: GLsizei, samplers: ConstStar<GLuint>): Void;
+	@:native('WebGL_IsSampler') static function glIsSampler(sampler: GLuint): Bool;
+	@:native('WebGL_BindSampler') static function glBindSampler(unit: GLuint, sampler: GLuint): Void;
+	@:native('WebGL_SamplerParameteri') static function glSamplerParameteri(sampler: GLuint, pname: GLenum, param: GLint): Void;
+	@:native('WebGL_SamplerParameterf') static function glSamplerParameterf(sampler: GLuint, pname: GLenum, param: GLfloat): Void;
+	@:native('WebGL_FenceSync') static function glFenceSync(condition: GLenum, flags: GLbitfield): Star<cpp.Void>;
+	@:native('WebGL_ClientWaitSync') static function glClientWaitSync(sync: Star<cpp.Void>, flags: GLbitfield, timeout: UInt64): GLenum;
+	@:native('WebGL_DeleteSync') static function glDeleteSync(sync: Star<cpp.Void>): Void;
+
+}
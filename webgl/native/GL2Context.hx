@@ -0,0 +1,463 @@
+package webgl.native;
+
+import cpp.*;
+import webgl.GLContext;
+import webgl.extension.ANGLEInstancedArrays;
+import webgl.extension.OESVertexArrayObject;
+import typedarray.Int32Array;
+import typedarray.Uint32Array;
+import typedarray.Float32Array;
+import webgl.native.ES2Context.*;
+import webgl.native.ES3Context.*;
+
+/**
+	WebGL2 methods on an OpenGL ES 3.0 (or desktop GL 3.3) context, created by `GLContext.create()` when the driver supports it
+**/
+@:nullSafety
+@:noCompletion
+@:allow(webgl.native.GLContext)
+@:access(webgl.native.GLObject)
+@:access(webgl.extension.OESVertexArrayObject)
+@:access(webgl.extension.ANGLEInstancedArrays)
+class GL2Context extends webgl.native.GLContext {
+
+	// core entry points behave like the WebGL1 extensions
+	final vertexArrays: OESVertexArrayObject;
+	final instancing: ANGLEInstancedArrays;
+
+	@:keep
+	function new(
+		nativeReference: Pointer<cpp.Void>,
+		alpha: Bool,
+		depth: Bool,
+		stencil: Bool,
+		antialias: Bool,
+		nativeMakeCurrent: Callable<(nativeReference: Star<cpp.Void>) -> Void>,
+		nativeGetDrawingBufferWidth: Callable<(nativeReference: Star<cpp.Void>) -> Int32>,
+		nativeGetDrawingBufferHeight: Callable<(nativeReference: Star<cpp.Void>) -> Int32>,
+		es3Functions: ConstStar<cpp.Void>
+	) {
+		super(nativeReference, alpha, depth, stencil, antialias, nativeMakeCurrent, nativeGetDrawingBufferWidth, nativeGetDrawingBufferHeight);
+		this.es3Functions = es3Functions;
+		vertexArrays = new OESVertexArrayObject(this, '');
+		instancing = new ANGLEInstancedArrays(this, '');
+	}
+
+	/* Buffer objects */
+
+	public inline function copyBufferSubData(readTarget:BufferTarget, writeTarget:BufferTarget, readOffset:GLintptr, writeOffset:GLintptr, size:GLsizeiptr) {
+		setContext();
+		glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+	}
+
+	/**
+		Copies `dstBuffer.byteLength` bytes from the buffer bound to `target`
+	**/
+	public function getBufferSubData(target:BufferTarget, srcByteOffset:GLintptr, dstBuffer:GLArrayBufferView) {
+		setContext();
+		var source = glMapBufferRange(target, srcByteOffset, dstBuffer.byteLength, MAP_READ_BIT);
+		if (source == null) return;
+		Native.memcpy(cast dstBuffer.toCPointer(), cast source, dstBuffer.byteLength);
+		glUnmapBuffer(target);
+	}
+
+	public inline function bindBufferBase(target:BufferTarget, index:GLuint, ?buffer:GLBuffer) {
+		setContext();
+		var ref = buffer != null ? buffer.handle : 0;
+		#if gl_state_cache
+		stateCache.onBindBufferBase(target, ref);
+		#end
+		glBindBufferBase(target, index, ref);
+	}
+
+	public inline function bindBufferRange(target:BufferTarget, index:GLuint, buffer:Null<GLBuffer>, offset:GLintptr, size:GLsizeiptr) {
+		setContext();
+		var ref = buffer != null ? buffer.handle : 0;
+		#if gl_state_cache
+		stateCache.onBindBufferBase(target, ref);
+		#end
+		glBindBufferRange(target, index, ref, offset, size);
+	}
+
+	/* Vertex array objects */
+
+	public inline function createVertexArray():Null<GLVertexArrayObject> {
+		return vertexArrays.createVertexArrayOES();
+	}
+
+	public inline function deleteVertexArray(?vertexArray:GLVertexArrayObject) {
+		vertexArrays.deleteVertexArrayOES(vertexArray);
+	}
+
+	public inline function isVertexArray(?vertexArray:GLVertexArrayObject):Bool {
+		return vertexArrays.isVertexArrayOES(vertexArray);
+	}
+
+	public inline function bindVertexArray(?vertexArray:GLVertexArrayObject) {
+		vertexArrays.bindVertexArrayOES(vertexArray);
+	}
+
+	/* Drawing */
+
+	public inline function drawArraysInstanced(mode:DrawMode, first:GLint, count:GLsizei, instanceCount:GLsizei) {
+		instancing.drawArraysInstancedANGLE(mode, first, count, instanceCount);
+	}
+
+	public inline function drawElementsInstanced(mode:DrawMode, count:GLsizei, type:DataType, offset:GLintptr, instanceCount:GLsizei) {
+		instancing.drawElementsInstancedANGLE(mode, count, type, offset, instanceCount);
+	}
+
+	public inline function vertexAttribDivisor(index:GLuint, divisor:GLuint) {
+		instancing.vertexAttribDivisorANGLE(index, divisor);
+	}
+
+	public inline function drawRangeElements(mode:DrawMode, start:GLuint, end:GLuint, count:GLsizei, type:DataType, offset:GLintptr) {
+		setContext();
+		var offsetAsPointer: ConstStar<cpp.Void> = untyped __cpp__('reinterpret_cast<void*>({0})', offset);
+		glDrawRangeElements(mode, start, end, count, type, offsetAsPointer);
+	}
+
+	/* Multiple render targets */
+
+	public function drawBuffers(buffers:Array<GLenum>) {
+		setContext();
+		var list = new Uint32Array(buffers.length);
+		for (i in 0...buffers.length) list[i] = buffers[i];
+		glDrawBuffers(buffers.length, list.toCPointer());
+	}
+
+	public inline function readBuffer(src:GLenum) {
+		setContext();
+		glReadBuffer(src);
+	}
+
+	public inline function clearBufferfv(buffer:GLenum, drawbuffer:GLint, values:GLFloat32Array) {
+		setContext();
+		glClearBufferfv(buffer, drawbuffer, values.toCPointer());
+	}
+
+	public inline function clearBufferiv(buffer:GLenum, drawbuffer:GLint, values:GLInt32Array) {
+		setContext();
+		glClearBufferiv(buffer, drawbuffer, values.toCPointer());
+	}
+
+	public inline function clearBufferuiv(buffer:GLenum, drawbuffer:GLint, values:GLUint32Array) {
+		setContext();
+		glClearBufferuiv(buffer, drawbuffer, values.toCPointer());
+	}
+
+	public inline function clearBufferfi(buffer:GLenum, drawbuffer:GLint, depth:GLfloat, stencil:GLint) {
+		setContext();
+		glClearBufferfi(buffer, drawbuffer, depth, stencil);
+	}
+
+	/* Framebuffers and renderbuffers */
+
+	public inline function blitFramebuffer(srcX0:GLint, srcY0:GLint, srcX1:GLint, srcY1:GLint, dstX0:GLint, dstY0:GLint, dstX1:GLint, dstY1:GLint, mask:ClearBufferMask, filter:GLenum) {
+		setContext();
+		glBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+	}
+
+	public inline function framebufferTextureLayer(target:FramebufferTarget, attachment:FramebufferAttachement, texture:Null<GLTexture>, level:GLint, layer:GLint) {
+		setContext();
+		var ref = texture != null ? texture.handle : 0;
+		glFramebufferTextureLayer(target, attachment, ref, level, layer);
+	}
+
+	public inline function renderbufferStorageMultisample(target:RenderbufferTarget, samples:GLsizei, internalformat:GLenum, width:GLsizei, height:GLsizei) {
+		setContext();
+		glRenderbufferStorageMultisample(target, samples, internalformat, width, height);
+	}
+
+	/* Textures */
+
+	/**
+		Desktop GL before 4.2 has no immutable textures; there every level is allocated with `texImage2D` instead, which doesn't support integer formats
+	**/
+	public function texStorage2D(target:TextureTarget, levels:GLsizei, internalformat:GLenum, width:GLsizei, height:GLsizei) {
+		setContext();
+		if (hasTexStorage()) {
+			glTexStorage2D(target, levels, internalformat, width, height);
+			return;
+		}
+		var format = storageFormat(internalformat);
+		var type = storageType(internalformat);
+		var targets: Array<GLenum> = (target: GLenum) == webgl.native.GLContext.TEXTURE_CUBE_MAP ? [for (face in 0...6) webgl.native.GLContext.TEXTURE_CUBE_MAP_POSITIVE_X + face] : [target];
+		for (level in 0...levels) {
+			var levelWidth = width >> level > 0 ? width >> level : 1;
+			var levelHeight = height >> level > 0 ? height >> level : 1;
+			for (levelTarget in targets) {
+				glTexImage2D(levelTarget, level, cast internalformat, levelWidth, levelHeight, 0, format, type, null);
+			}
+		}
+		glTexParameteri(target, TEXTURE_MAX_LEVEL, levels - 1);
+	}
+
+	public function texStorage3D(target:TextureTarget, levels:GLsizei, internalformat:GLenum, width:GLsizei, height:GLsizei, depth:GLsizei) {
+		setContext();
+		if (hasTexStorage()) {
+			glTexStorage3D(target, levels, internalformat, width, height, depth);
+			return;
+		}
+		var format = storageFormat(internalformat);
+		var type = storageType(internalformat);
+		for (level in 0...levels) {
+			var levelWidth = width >> level > 0 ? width >> level : 1;
+			var levelHeight = height >> level > 0 ? height >> level : 1;
+			// 2D array textures keep their layer count at every level
+			var levelDepth = (target: GLenum) == TEXTURE_3D ? (depth >> level > 0 ? depth >> level : 1) : depth;
+			glTexImage3D(target, level, cast internalformat, levelWidth, levelHeight, levelDepth, 0, format, type, null);
+		}
+		glTexParameteri(target, TEXTURE_MAX_LEVEL, levels - 1);
+	}
+
+	public inline function texImage3D(target:TextureTarget, level:GLint, internalformat:GLenum, width:GLsizei, height:GLsizei, depth:GLsizei, border:GLint, format:PixelFormat, type:PixelDataType, pixels:Null<GLArrayBufferView>) {
+		setContext();
+		var ptr: Star<UInt8> = pixels != null ? pixels.toCPointer() : null;
+		glTexImage3D(target, level, cast internalformat, width, height, depth, border, format, type, cast ptr);
+	}
+
+	public inline function texSubImage3D(target:TextureTarget, level:GLint, xoffset:GLint, yoffset:GLint, zoffset:GLint, width:GLsizei, height:GLsizei, depth:GLsizei, format:PixelFormat, type:PixelDataType, pixels:GLArrayBufferView) {
+		setContext();
+		var ptr: Star<UInt8> = pixels != null ? pixels.toCPointer() : null;
+		glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, cast ptr);
+	}
+
+	/* Pixel buffer objects */
+
+	/**
+		`readPixels()` into the buffer bound to `PIXEL_PACK_BUFFER`, at byte `offset`
+	**/
+	public inline function readPixelsToBuffer(x:GLint, y:GLint, width:GLsizei, height:GLsizei, format:PixelFormat, type:PixelDataType, offset:GLintptr) {
+		setContext();
+		var offsetAsPointer: Star<cpp.Void> = untyped __cpp__('reinterpret_cast<void*>({0})', offset);
+		glReadPixels(x, y, width, height, format, type, offsetAsPointer);
+	}
+
+	/**
+		`texSubImage2D()` from the buffer bound to `PIXEL_UNPACK_BUFFER`, at byte `offset`
+	**/
+	public inline function texSubImage2DFromBuffer(target:TextureTarget, level:GLint, xoffset:GLint, yoffset:GLint, width:GLsizei, height:GLsizei, format:PixelFormat, type:PixelDataType, offset:GLintptr) {
+		setContext();
+		var offsetAsPointer: ConstStar<cpp.Void> = untyped __cpp__('reinterpret_cast<void*>({0})', offset);
+		glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, offsetAsPointer);
+	}
+
+	/* Integer vertex attributes */
+
+	public inline function vertexAttribIPointer(index:GLuint, size:GLint, type:DataType, stride:GLsizei, offset:GLintptr) {
+		setContext();
+		var offsetAsPointer: ConstStar<cpp.Void> = untyped __cpp__('reinterpret_cast<void*>({0})', offset);
+		glVertexAttribIPointer(index, size, type, stride, offsetAsPointer);
+	}
+
+	public inline function vertexAttribI4i(index:GLuint, x:GLint, y:GLint, z:GLint, w:GLint) {
+		setContext();
+		glVertexAttribI4i(index, x, y, z, w);
+	}
+
+	public inline function vertexAttribI4ui(index:GLuint, x:GLuint, y:GLuint, z:GLuint, w:GLuint) {
+		setContext();
+		glVertexAttribI4ui(index, x, y, z, w);
+	}
+
+	/* Uniforms */
+
+	public inline function uniform1ui(location:GLUniformLocation, v0:GLuint) {
+		setContext();
+		glUniform1ui(location, v0);
+	}
+
+	public inline function uniform2ui(location:GLUniformLocation, v0:GLuint, v1:GLuint) {
+		setContext();
+		glUniform2ui(location, v0, v1);
+	}
+
+	public inline function uniform3ui(location:GLUniformLocation, v0:GLuint, v1:GLuint, v2:GLuint) {
+		setContext();
+		glUniform3ui(location, v0, v1, v2);
+	}
+
+	public inline function uniform4ui(location:GLUniformLocation, v0:GLuint, v1:GLuint, v2:GLuint, v3:GLuint) {
+		setContext();
+		glUniform4ui(location, v0, v1, v2, v3);
+	}
+
+	public inline function uniform1uiv(location:GLUniformLocation, data:GLUint32Array) {
+		setContext();
+		glUniform1uiv(location, data.length, data.toCPointer());
+	}
+
+	public inline function uniform2uiv(location:GLUniformLocation, data:GLUint32Array) {
+		setContext();
+		glUniform2uiv(location, NativeMath.idiv(data.length, 2), data.toCPointer());
+	}
+
+	public inline function uniform3uiv(location:GLUniformLocation, data:GLUint32Array) {
+		setContext();
+		glUniform3uiv(location, NativeMath.idiv(data.length, 3), data.toCPointer());
+	}
+
+	public inline function uniform4uiv(location:GLUniformLocation, data:GLUint32Array) {
+		setContext();
+		glUniform4uiv(location, NativeMath.idiv(data.length, 4), data.toCPointer());
+	}
+
+	public inline function uniformMatrix2x3fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array) {
+		setContext();
+		glUniformMatrix2x3fv(location, NativeMath.idiv(data.length, 6), transpose, data.toCPointer());
+	}
+
+	public inline function uniformMatrix3x2fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array) {
+		setContext();
+		glUniformMatrix3x2fv(location, NativeMath.idiv(data.length, 6), transpose, data.toCPointer());
+	}
+
+	public inline function uniformMatrix2x4fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array) {
+		setContext();
+		glUniformMatrix2x4fv(location, NativeMath.idiv(data.length, 8), transpose, data.toCPointer());
+	}
+
+	public inline function uniformMatrix4x2fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array) {
+		setContext();
+		glUniformMatrix4x2fv(location, NativeMath.idiv(data.length, 8), transpose, data.toCPointer());
+	}
+
+	public inline function uniformMatrix3x4fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array) {
+		setContext();
+		glUniformMatrix3x4fv(location, NativeMath.idiv(data.length, 12), transpose, data.toCPointer());
+	}
+
+	public inline function uniformMatrix4x3fv(location:GLUniformLocation, transpose:Bool, data:GLFloat32Array) {
+		setContext();
+		glUniformMatrix4x3fv(location, NativeMath.idiv(data.length, 12), transpose, data.toCPointer());
+	}
+
+	/* Uniform buffer objects */
+
+	public inline function getUniformBlockIndex(program:GLProgram, uniformBlockName:String):GLuint {
+		setContext();
+		return glGetUniformBlockIndex(program.handle, ConstCharStar.fromString(uniformBlockName));
+	}
+
+	/**
+		Returns a `Uint32Array` for `UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES`, a `Bool` for `UNIFORM_BLOCK_REFERENCED_BY_*_SHADER` and otherwise an `Int`
+	**/
+	public function getActiveUniformBlockParameter(program:GLProgram, uniformBlockIndex:GLuint, pname:GLenum):Any {
+		setContext();
+		var result: GLint = 0;
+		if (pname == UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES) {
+			glGetActiveUniformBlockiv(program.handle, uniformBlockIndex, UNIFORM_BLOCK_ACTIVE_UNIFORMS, Native.addressOf(result));
+			var indices = new Int32Array(result);
+			if (result > 0) {
+				glGetActiveUniformBlockiv(program.handle, uniformBlockIndex, pname, indices.toCPointer());
+			}
+			return new Uint32Array(indices.buffer);
+		}
+		glGetActiveUniformBlockiv(program.handle, uniformBlockIndex, pname, Native.addressOf(result));
+		return if (pname == UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER || pname == UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER) {
+			result != 0;
+		} else {
+			result;
+		}
+	}
+
+	public inline function uniformBlockBinding(program:GLProgram, uniformBlockIndex:GLuint, uniformBlockBinding:GLuint) {
+		setContext();
+		glUniformBlockBinding(program.handle, uniformBlockIndex, uniformBlockBinding);
+	}
+
+	/* Sampler objects */
+
+	public inline function createSampler():Null<GLSampler> {
+		setContext();
+		var ref: GLuint = 0;
+		glGenSamplers(1, Native.addressOf(ref));
+		return ref != 0 ? new GLSampler(this, ref) : null;
+	}
+
+	public inline function deleteSampler(?sampler:GLSampler) {
+		setContext();
+		if (sampler != null) {
+			if (sampler.handle != 0) glDeleteSamplers(1, Native.addressOf(sampler.handle));
+			sampler.handle = 0;
+		}
+	}
+
+	public inline function isSampler(?sampler:GLSampler):Bool {
+		setContext();
+		return sampler != null ? glIsSampler(sampler.handle) : false;
+	}
+
+	public inline function bindSampler(unit:GLuint, ?sampler:GLSampler) {
+		setContext();
+		var ref = sampler != null ? sampler.handle : 0;
+		glBindSampler(unit, ref);
+	}
+
+	public inline function samplerParameteri(sampler:GLSampler, pname:GLenum, param:GLint) {
+		setContext();
+		glSamplerParameteri(sampler.handle, pname, param);
+	}
+
+	public inline function samplerParameterf(sampler:GLSampler, pname:GLenum, param:GLfloat) {
+		setContext();
+		glSamplerParameterf(sampler.handle, pname, param);
+	}
+
+	/* Sync objects */
+
+	public inline function fenceSync(condition:GLenum, flags:GLbitfield):Null<GLSync> {
+		setContext();
+		var sync = glFenceSync(condition, flags);
+		return sync != null ? new GLSync(this, sync) : null;
+	}
+
+	/**
+		`timeout` is in nanoseconds
+	**/
+	public inline function clientWaitSync(sync:GLSync, flags:GLbitfield, timeout:Int):GLenum {
+		setContext();
+		return sync.handle != null ? glClientWaitSync(sync.handle, flags, timeout) : WAIT_FAILED;
+	}
+
+	public inline function deleteSync(?sync:GLSync) {
+		setContext();
+		if (sync != null) {
+			if (sync.handle != null) glDeleteSync(sync.handle);
+			sync.handle = null;
+		}
+	}
+
+	// unsized format and type accepted by desktop GL when allocating storage for `internalformat` without data
+	static function storageFormat(internalformat:GLenum):GLenum {
+		return switch (internalformat: Int) {
+			case 0x81A5, 0x81A6, 0x8CAC: webgl.native.GLContext.DEPTH_COMPONENT; // DEPTH_COMPONENT16, DEPTH_COMPONENT24, DEPTH_COMPONENT32F
+			case 0x88F0, 0x8CAD: DEPTH_STENCIL; // DEPTH24_STENCIL8, DEPTH32F_STENCIL8
+			default: webgl.native.GLContext.RGBA;
+		}
+	}
+
+	static function storageType(internalformat:GLenum):GLenum {
+		return switch (internalformat: Int) {
+			case 0x81A5, 0x81A6, 0x8CAC: webgl.native.GLContext.UNSIGNED_INT;
+			case 0x88F0, 0x8CAD: UNSIGNED_INT_24_8;
+			default: webgl.native.GLContext.UNSIGNED_BYTE;
+		}
+	}
+
+	// constants
+
+	static public inline final TEXTURE_3D = 0x806F;
+	static public inline final TEXTURE_2D_ARRAY = 0x8C1A;
+	static public inline final TEXTURE_MAX_LEVEL = 0x813D;
+	static public inline final DEPTH_STENCIL = 0x84F9;
+	static public inline final UNSIGNED_INT_24_8 = 0x84FA;
+	static public inline final MAP_READ_BIT = 0x0001;
+	static public inline final UNIFORM_BLOCK_ACTIVE_UNIFORMS = 0x8A42;
+	static public inline final UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES = 0x8A43;
+	static public inline final UNIFORM_BLOCK_REFERENCED_BY_VERTEX_SHADER = 0x8A44;
+	static public inline final UNIFORM_BLOCK_REFERENCED_BY_FRAGMENT_SHADER = 0x8A46;
+	static public inline final WAIT_FAILED = 0x911D;
+
+}
@@ -6,7 +6,7 @@ final class GLBuffer extends GLObject {
 
 	@:noCompletion
 	override public function finalize() {
-		context.deleteBuffer(this);
+		deleteLater(GLDeletionQueue.BUFFER, null);
 	}
 
 }
\ No newline at end of file
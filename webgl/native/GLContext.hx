@@ -8,13 +8,29 @@ import typedarray.Float32Array;
 import typedarray.Uint8Array;
 import typedarray.ArrayBufferView;
 import webgl.native.ES2Context.*;
+import webgl.extension.EXTDisjointTimerQuery;
 
+// native reference of the context known to be current on each thread, null whenever it is possible that the current graphics context has been changed externally
+// number of `nativeMakeCurrent` calls made on each thread, see `makeCurrentCalls`
+@:headerCode('extern thread_local void* webglKnownCurrentContextReference;\nextern thread_local int webglMakeCurrentCalls;')
+@:cppFileCode('thread_local void* webglKnownCurrentContextReference = nullptr;\nthread_local int webglMakeCurrentCalls = 0;')
 @:nullSafety
 @:noCompletion
 class GLContext {
-	
-	// set this variable to null whenever it is possible that the current graphics context has been changed externally
-	static var knownCurrentReference: Star<cpp.Void> = null;
+
+	/**
+		Number of times `nativeMakeCurrent` has been called on the calling thread, for all contexts
+	**/
+	static public var makeCurrentCalls(get, never): Int;
+	static function get_makeCurrentCalls(): Int {
+		return untyped __cpp__('webglMakeCurrentCalls');
+	}
+
+	/**
+		Native code may call `glPixelStorei()` between callbacks into haxe, so the shadowed pixel store state is read again after each one.
+		Set to false if native code never changes pixel store state to skip the `glGetIntegerv()` calls (two, or five on OpenGL ES 3.0) on the first upload of each callback
+	**/
+	static public var invalidatePixelStoreAfterHaxeExecution: Bool = true;
 
 	public var drawingBufferWidth (get, never): Int;
 	public var drawingBufferHeight (get, never): Int;
@@ -27,6 +43,51 @@ class GLContext {
 	
 	final defaultFramebuffer: GLFramebuffer;
 
+	final extensions: GLExtensionRegistry;
+
+	// see `isContextLost()`
+	var lost = false;
+	// set by `onNativeContextLost()`, the context cannot be restored
+	var destroyed = false;
+
+	// formats of enabled compressed texture extensions, reported by getParameter(COMPRESSED_TEXTURE_FORMATS)
+	final enabledCompressedTextureFormats = new Array<Int>();
+
+	#if gl_state_cache
+	final stateCache = new GLStateCache();
+	#end
+
+	// names of objects released by the garbage collector, see deletePendingObjects()
+	final deletionQueue: Star<GLDeletionQueue> = GLDeletionQueue.create();
+	final deletionBatches = [for (type in 0...DELETION_BATCHED_TYPES) new Uint32Array(DELETION_BATCH_SIZE)];
+	final deletionBatchLengths = [for (type in 0...DELETION_BATCHED_TYPES) 0];
+	var vertexArrayDeletionProc: Star<cpp.Void> = null;
+
+	// ES3 entry points of a GL2Context, made current for the calling thread by setContext()
+	var es3Functions: ConstStar<cpp.Void> = null;
+
+	// created by TextureUploadQueue.forContext()
+	var uploadQueue: Null<webgl.TextureUploadQueue> = null;
+
+	// pixel store state set through pixelStorei(), so uploads and getParameter() don't query the driver, see validatePixelStore()
+	var unpackAlignment = 4;
+	var packAlignment = 4;
+	// OpenGL ES 3.0 only, always 0 on an OpenGL ES 2.0 context
+	var unpackRowLength = 0;
+	var unpackSkipRows = 0;
+	var unpackSkipPixels = 0;
+	var pixelStoreGeneration = -1;
+	static var externalPixelStoreGeneration = 0;
+
+	// names generated ahead of time so most createBuffer() and createTexture() calls don't call the driver
+	final bufferNamePool = new Uint32Array(NAME_POOL_SIZE);
+	final textureNamePool = new Uint32Array(NAME_POOL_SIZE);
+	var bufferNamesAvailable = 0;
+	var textureNamesAvailable = 0;
+
+	// every context that may have objects pending deletion
+	static final contexts = new Array<cpp.vm.WeakRef<GLContext>>();
+
 	#if windows
 	
 	// initialize GLEW on platforms that require it
@@ -59,7 +120,7 @@ class GLContext {
 		- `nativeGetDrawingBufferHeight` is a callback that receives the `nativeReference` and returns the drawing buffer height in pixels
 	**/
 	@:keep
-	public inline function new(
+	public function new(
 		nativeReference: Pointer<cpp.Void>,
 
 		// context attributes
@@ -91,11 +152,45 @@ class GLContext {
 		initGlew();
 		#end
 
+		// the host makes the context current before creating it
+		setKnownCurrentReference(this.nativeReference);
+
 		// get initially bound framebuffer and use it for our default framebuffer `bindFramebuffer(FRAMEBUFFER, null)`
 		var temp = new Int32Array(1);
 		glGetIntegerv(FRAMEBUFFER_BINDING, temp.toCPointer());
 		var initialFramebufferRef = temp[0];
 		defaultFramebuffer = new GLFramebuffer(this, initialFramebufferRef);
+
+		extensions = new GLExtensionRegistry(this);
+
+		// the host may have changed pixel store state from the defaults
+		validatePixelStore();
+
+		contexts.push(new cpp.vm.WeakRef(this));
+	}
+
+
+	/**
+		Called by the native host when its context is ready, the context must be current.
+		Returns a `GL2Context` if the context supports OpenGL ES 3.0 or desktop GL 3.3, see `webgl.GL2Context.fromContext()`
+	**/
+	@:keep
+	static public function create(
+		nativeReference: Pointer<cpp.Void>,
+		alpha: Bool,
+		depth: Bool,
+		stencil: Bool,
+		antialias: Bool,
+		nativeMakeCurrent: Callable<(nativeReference: Star<cpp.Void>) -> Void>,
+		nativeGetDrawingBufferWidth: Callable<(nativeReference: Star<cpp.Void>) -> Int32>,
+		nativeGetDrawingBufferHeight: Callable<(nativeReference: Star<cpp.Void>) -> Int32>
+	): GLContext {
+		var es3Functions = ES3Context.loadES3Functions();
+		return if (es3Functions != null) {
+			new GL2Context(nativeReference, alpha, depth, stencil, antialias, nativeMakeCurrent, nativeGetDrawingBufferWidth, nativeGetDrawingBufferHeight, es3Functions);
+		} else {
+			new GLContext(nativeReference, alpha, depth, stencil, antialias, nativeMakeCurrent, nativeGetDrawingBufferWidth, nativeGetDrawingBufferHeight);
+		}
 	}
 
 	#end
@@ -104,14 +199,142 @@ class GLContext {
 		- Ensures that OpenGL calls are applied to our context
 		- This method is called for every gl-call, however the overhead of this method is extremely small so it's not expected to have any impact on performance. 
 			However, if there can never be more than 1 graphics context you can pass `-D single_graphics_context` to remove it
+		- On a GL2Context the thread's ES3 entry points are switched to this context's, see `WebGL_setES3Functions()` in ES3Context.h
+		- With `-D gl_state_cache` calls that would not change the context's state are skipped, see `GLStateCache`
 	 **/
 	inline function setContext() {
 		#if !single_graphics_context
-		if (knownCurrentReference == nativeReference) {
+		var knownCurrentReference: Star<cpp.Void> = untyped __cpp__('webglKnownCurrentContextReference');
+		if (knownCurrentReference != nativeReference) {
 			nativeMakeCurrent(nativeReference);
-			knownCurrentReference = nativeReference;
+			untyped __cpp__('webglMakeCurrentCalls++');
+			untyped __cpp__('webglKnownCurrentContextReference = {0}', nativeReference);
+		}
+		#end
+		if (es3Functions != null) {
+			ES3Context.setES3Functions(es3Functions);
+		}
+		#if gl_state_cache
+		stateCache.validate();
+		#end
+	}
+
+	/**
+		Called by the native host when it has made the context of `nativeReference` current on the calling thread (or null if the current context is unknown),
+		so the next gl call doesn't make it current again
+	**/
+	@:keep
+	@:noCompletion
+	static public function setKnownCurrentReference(nativeReference: Star<cpp.Void>) {
+		untyped __cpp__('webglKnownCurrentContextReference = {0}', nativeReference);
+	}
+
+	/**
+		Called by the native host after each callback into haxe; native code may change the current context and GL state before the next one
+	**/
+	@:keep
+	@:noCompletion
+	static public function postHaxeExecution() {
+		untyped __cpp__('webglKnownCurrentContextReference = nullptr');
+		if (invalidatePixelStoreAfterHaxeExecution) {
+			externalPixelStoreGeneration++;
+		}
+		#if gl_state_cache
+		if (GLStateCache.invalidateAfterHaxeExecution) {
+			GLStateCache.invalidateAll();
+		}
+		#end
+	}
+
+	/**
+		Delete objects released by the garbage collector for every context, called by the native host at the start of each frame
+	**/
+	@:keep
+	@:noCompletion
+	static public function deletePendingObjectsOfAllContexts() {
+		var i = 0;
+		while (i < contexts.length) {
+			var context: Null<GLContext> = contexts[i].get();
+			if (context == null) {
+				// the native context and its objects have been destroyed with it
+				contexts.splice(i, 1);
+				continue;
+			}
+			// objects of a context lost through WEBGL_lose_context are deleted once it's restored
+			if (!context.lost) {
+				context.deletePendingObjects();
+			}
+			i++;
+		}
+	}
+
+	/**
+		Delete objects released by the garbage collector since the last call. Names of the same type are deleted together with one call where GL allows it
+	**/
+	public function deletePendingObjects() {
+		if (!GLDeletionQueue.hasPending(deletionQueue)) return;
+		setContext();
+		var type: Int32 = 0;
+		var handle: SizeT = 0;
+		var proc: Star<cpp.Void> = null;
+		while (GLDeletionQueue.pop(deletionQueue, Native.addressOf(type), Native.addressOf(handle), Native.addressOf(proc))) {
+			if (type == GLDeletionQueue.SYNC) {
+				ES3Context.glDeleteSync(untyped __cpp__('(void*){0}', handle));
+				continue;
+			}
+			if (type == GLDeletionQueue.QUERY) {
+				var query: GLuint = cast handle;
+				GLExtensionFunctions.deleteQueries(proc, 1, Native.addressOf(query));
+				continue;
+			}
+
+			var name: GLuint = cast handle;
+			if (type == GLDeletionQueue.PROGRAM) {
+				#if gl_state_cache
+				stateCache.onDeleteProgram(name);
+				#end
+				glDeleteProgram(name);
+			} else if (type == GLDeletionQueue.SHADER) {
+				glDeleteShader(name);
+			} else {
+				if (type == GLDeletionQueue.VERTEX_ARRAY && proc != vertexArrayDeletionProc) {
+					deleteBatch(type);
+					vertexArrayDeletionProc = proc;
+				}
+				var length = deletionBatchLengths[type];
+				deletionBatches[type][length] = name;
+				deletionBatchLengths[type] = length + 1;
+				if (length + 1 == DELETION_BATCH_SIZE) {
+					deleteBatch(type);
+				}
+			}
+		}
+		for (type in 0...DELETION_BATCHED_TYPES) {
+			deleteBatch(type);
+		}
+	}
+
+	function deleteBatch(type: Int) {
+		var length = deletionBatchLengths[type];
+		if (length == 0) return;
+		var names = deletionBatches[type];
+		#if gl_state_cache
+		for (i in 0...length) {
+			var name: Int = names[i];
+			if (type == GLDeletionQueue.BUFFER) stateCache.onDeleteBuffer(name);
+			else if (type == GLDeletionQueue.TEXTURE) stateCache.onDeleteTexture(name);
+			else if (type == GLDeletionQueue.FRAMEBUFFER) stateCache.onDeleteFramebuffer(name);
+			else if (type == GLDeletionQueue.RENDERBUFFER) stateCache.onDeleteRenderbuffer(name);
+			else if (type == GLDeletionQueue.VERTEX_ARRAY) stateCache.onDeleteVertexArray(name);
 		}
 		#end
+		if (type == GLDeletionQueue.BUFFER) glDeleteBuffers(length, names.toCPointer());
+		else if (type == GLDeletionQueue.TEXTURE) glDeleteTextures(length, names.toCPointer());
+		else if (type == GLDeletionQueue.FRAMEBUFFER) glDeleteFramebuffers(length, names.toCPointer());
+		else if (type == GLDeletionQueue.RENDERBUFFER) glDeleteRenderbuffers(length, names.toCPointer());
+		else if (type == GLDeletionQueue.VERTEX_ARRAY) GLExtensionFunctions.deleteVertexArrays(vertexArrayDeletionProc, length, names.toCPointer());
+		else if (type == GLDeletionQueue.SAMPLER) ES3Context.glDeleteSamplers(length, names.toCPointer());
+		deletionBatchLengths[type] = 0;
 	}
 
 	public inline function getContextAttributes(): GLContextAttributes {
@@ -119,24 +342,94 @@ class GLContext {
 	}
 	
 	public inline function getSupportedExtensions():Array<String> {
-		setContext();
-		var extensions = getString(EXTENSIONS);
-		return extensions.split(' ').map(name -> name.substr(3)); // remove GL_ prefix
+		return extensions.supportedNames.copy();
+	}
+
+	public function getExtension<T>(name: Extension<T>): Null<T> {
+		var extension = extensions.get(name);
+		if (extension != null && !extensions.enabled.exists(name)) {
+			extensions.enabled.set(name, true);
+			var compressedTextureExtension = extensions.compressedTextureExtensions.get(name);
+			if (compressedTextureExtension != null) {
+				for (format in compressedTextureExtension.formats) {
+					if (enabledCompressedTextureFormats.indexOf(format) == -1) {
+						enabledCompressedTextureFormats.push(format);
+					}
+				}
+			}
+		}
+		return cast extension;
 	}
 
-	public inline function getExtension<T>(name: Extension<T>): Null<T> {
-		setContext();
-		var isSupported = getSupportedExtensions().indexOf(name) != -1;
-		// @! should generate extension objects
-		return isSupported ? cast {} : null;
+	function getDriverCompressedTextureFormats(): Array<Int> {
+		var count: Int = getInt32(NUM_COMPRESSED_TEXTURE_FORMATS);
+		if (count <= 0) return [];
+		var formats = getInt32Array(COMPRESSED_TEXTURE_FORMATS, count);
+		return [for (i in 0...count) formats[i]];
+	}
+
+	/**
+		Reads the shadowed pixel store state from the driver if native code may have changed it since it was last read, the context must be current
+	**/
+	inline function validatePixelStore() {
+		if (pixelStoreGeneration != externalPixelStoreGeneration) {
+			unpackAlignment = getInt32(UNPACK_ALIGNMENT);
+			packAlignment = getInt32(PACK_ALIGNMENT);
+			if (es3Functions != null) {
+				unpackRowLength = getInt32(webgl.GL2Context.UNPACK_ROW_LENGTH);
+				unpackSkipRows = getInt32(webgl.GL2Context.UNPACK_SKIP_ROWS);
+				unpackSkipPixels = getInt32(webgl.GL2Context.UNPACK_SKIP_PIXELS);
+			}
+			pixelStoreGeneration = externalPixelStoreGeneration;
+		}
 	}
 
 	public inline function isContextLost():Bool {
-		return false;
+		return lost;
+	}
+
+	/**
+		Called by `WEBGL_lose_context.loseContext()`, `isContextLost()` returns true until `restoreContext()`
+	**/
+	function markLost() {
+		lost = true;
+	}
+
+	/**
+		Called by `WEBGL_lose_context.restoreContext()`, a context lost by the native host stays lost
+	**/
+	function markRestored() {
+		if (!destroyed) lost = false;
+	}
+
+	/**
+		Called by the native host when the native context has been lost or destroyed, on the thread that owned it.
+		Its objects are gone with it, so pending names are dropped and `deletePendingObjectsOfAllContexts()` never makes the context current again
+	**/
+	@:keep
+	@:noCompletion
+	public function onNativeContextLost() {
+		lost = true;
+		destroyed = true;
+		GLDeletionQueue.discard(deletionQueue);
+		var i = 0;
+		while (i < contexts.length) {
+			var context: Null<GLContext> = contexts[i].get();
+			if (context == null || context == this) {
+				contexts.splice(i, 1);
+				continue;
+			}
+			i++;
+		}
+		// the host may reuse the native reference for its next context
+		untyped __cpp__('if (webglKnownCurrentContextReference == {0}) webglKnownCurrentContextReference = nullptr', nativeReference);
 	}
 
 	public inline function activeTexture(unit:TextureUnit) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipActiveTexture(unit)) return;
+		#end
 		glActiveTexture(unit);
 	}
 
@@ -154,49 +447,76 @@ class GLContext {
 	public inline function bindBuffer(target:BufferTarget, ?buffer:GLBuffer) {
 		setContext();
 		var ref = buffer != null ? buffer.handle : 0;
+		#if gl_state_cache
+		if (stateCache.skipBindBuffer(target, ref)) return;
+		#end
 		glBindBuffer(target, ref);
 	}
 
 	public inline function bindFramebuffer(target:FramebufferTarget, ?framebuffer:GLFramebuffer) {
 		setContext();
 		var ref = framebuffer != null ? framebuffer.handle : defaultFramebuffer.handle;
+		#if gl_state_cache
+		if (stateCache.skipBindFramebuffer(target, ref)) return;
+		#end
 		glBindFramebuffer(target, ref);
 	}
 
 	public inline function bindRenderbuffer(target:RenderbufferTarget, ?renderbuffer:GLRenderbuffer) {
 		setContext();
 		var ref = renderbuffer != null ? renderbuffer.handle : 0;
+		#if gl_state_cache
+		if (stateCache.skipBindRenderbuffer(ref)) return;
+		#end
 		glBindRenderbuffer(target, ref);
 	}
 
 	public inline function bindTexture(target:TextureTarget, ?texture:GLTexture) {
 		setContext();
 		var ref = texture != null ? texture.handle : 0;
+		#if gl_state_cache
+		if (stateCache.skipBindTexture(target, ref)) return;
+		#end
 		glBindTexture(target, ref);
 	}
 
 	public inline function blendColor(red:GLclampf, green:GLclampf, blue:GLclampf, alpha:GLclampf) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipBlendColor(red, green, blue, alpha)) return;
+		#end
 		glBlendColor(red, green, blue, alpha);
 	}
 
 	public inline function blendEquation(mode:BlendEquation) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipBlendEquationSeparate(mode, mode)) return;
+		#end
 		glBlendEquation(mode);
 	}
 
 	public inline function blendEquationSeparate(modeRGB:BlendEquation, modeAlpha:BlendEquation) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipBlendEquationSeparate(modeRGB, modeAlpha)) return;
+		#end
 		glBlendEquationSeparate(modeRGB, modeAlpha);
 	}
 
 	public inline function blendFunc(sfactor:BlendFactor, dfactor:BlendFactor) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipBlendFuncSeparate(sfactor, dfactor, sfactor, dfactor)) return;
+		#end
 		glBlendFunc(sfactor, dfactor);
 	}
 
 	public inline function blendFuncSeparate(srcRGB:BlendFactor, dstRGB:BlendFactor, srcAlpha:BlendFactor, dstAlpha:BlendFactor) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha)) return;
+		#end
 		glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
 	}
 
@@ -215,6 +535,19 @@ class GLContext {
 		glBufferSubData(target, offset, data.byteLength, cast data.toCPointer());
 	}
 
+	/**
+		WebGL2 `bufferSubData()` (available on every native context), `srcOffset` and `length` are in elements of `srcData` and a `length` of 0 copies to the end of `srcData`
+	**/
+	public function bufferSubDataRange(target:BufferTarget, dstByteOffset:GLintptr, srcData:ArrayBufferView, srcOffset:GLuint, length:GLuint) {
+		setContext();
+		var view = Std.downcast(srcData, typedarray.ArrayBufferView.ArrayBufferViewBase);
+		var bytesPerElement = view != null ? view.BYTES_PER_ELEMENT_ : 1;
+		var byteOffset = srcOffset * bytesPerElement;
+		var byteLength = length != 0 ? length * bytesPerElement : srcData.byteLength - byteOffset;
+		var src: ConstStar<cpp.Void> = untyped __cpp__('(const void*)({0} + {1})', srcData.toCPointer(), byteOffset);
+		glBufferSubData(target, dstByteOffset, byteLength, src);
+	}
+
 	public inline function checkFramebufferStatus(target:FramebufferTarget):FramebufferStatus {
 		setContext();
 		return glCheckFramebufferStatus(target);
@@ -227,11 +560,17 @@ class GLContext {
 
 	public inline function clearColor(red:GLclampf, green:GLclampf, blue:GLclampf, alpha:GLclampf) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipClearColor(red, green, blue, alpha)) return;
+		#end
 		glClearColor(red, green, blue, alpha);
 	}
 
 	public inline function clearDepth(depth:GLclampf) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipClearDepth(depth)) return;
+		#end
 		glClearDepthf(depth);
 	}
 
@@ -242,6 +581,9 @@ class GLContext {
 
 	public inline function colorMask(red:Bool, green:Bool, blue:Bool, alpha:Bool) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipColorMask(red, green, blue, alpha)) return;
+		#end
 		glColorMask(red, green, blue, alpha);
 	}
 
@@ -274,8 +616,11 @@ class GLContext {
 
 	public inline function createBuffer():Null<GLBuffer> {
 		setContext();
-		var ref: GLuint = 0;
-		glGenBuffers(1, Native.addressOf(ref));
+		if (bufferNamesAvailable == 0) {
+			glGenBuffers(NAME_POOL_SIZE, bufferNamePool.toCPointer());
+			bufferNamesAvailable = NAME_POOL_SIZE;
+		}
+		var ref: GLuint = bufferNamePool[--bufferNamesAvailable];
 		return ref != 0 ? new GLBuffer(this, ref) : null;
 	}
 
@@ -307,19 +652,28 @@ class GLContext {
 
 	public inline function createTexture():Null<GLTexture> {
 		setContext();
-		var ref: GLuint = 0;
-		glGenTextures(1, Native.addressOf(ref));
+		if (textureNamesAvailable == 0) {
+			glGenTextures(NAME_POOL_SIZE, textureNamePool.toCPointer());
+			textureNamesAvailable = NAME_POOL_SIZE;
+		}
+		var ref: GLuint = textureNamePool[--textureNamesAvailable];
 		return ref != 0 ? new GLTexture(this, ref) : null;
 	}
 
 	public inline function cullFace(mode:CullFaceMode) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipCullFace(mode)) return;
+		#end
 		glCullFace(mode);
 	}
 
 	public inline function deleteBuffer(?buffer:GLBuffer) {
 		setContext();
 		if (buffer != null) {
+			#if gl_state_cache
+			stateCache.onDeleteBuffer(buffer.handle);
+			#end
 			if (buffer.handle != 0) glDeleteBuffers(1, Native.addressOf(buffer.handle));
 			buffer.handle = 0;
 		}
@@ -328,6 +682,9 @@ class GLContext {
 	public inline function deleteFramebuffer(?framebuffer:GLFramebuffer) {
 		setContext();
 		if (framebuffer != null) {
+			#if gl_state_cache
+			stateCache.onDeleteFramebuffer(framebuffer.handle);
+			#end
 			if (framebuffer.handle != 0) glDeleteFramebuffers(1, Native.addressOf(framebuffer.handle));
 			framebuffer.handle = 0;
 		}
@@ -336,6 +693,9 @@ class GLContext {
 	public inline function deleteProgram(?program:GLProgram) {
 		setContext();
 		if (program != null) {
+			#if gl_state_cache
+			stateCache.onDeleteProgram(program.handle);
+			#end
 			if (program.handle != 0) glDeleteProgram(program.handle);
 			program.handle = 0;
 		}
@@ -344,6 +704,9 @@ class GLContext {
 	public inline function deleteRenderbuffer(?renderbuffer:GLRenderbuffer) {
 		setContext();
 		if (renderbuffer != null) {
+			#if gl_state_cache
+			stateCache.onDeleteRenderbuffer(renderbuffer.handle);
+			#end
 			if (renderbuffer.handle != 0) glDeleteRenderbuffers(1, Native.addressOf(renderbuffer.handle));
 			renderbuffer.handle = 0;
 		}
@@ -360,6 +723,9 @@ class GLContext {
 	public inline function deleteTexture(?texture:GLTexture) {
 		setContext();
 		if (texture != null) {
+			#if gl_state_cache
+			stateCache.onDeleteTexture(texture.handle);
+			#end
 			if (texture.handle != 0) glDeleteTextures(1, Native.addressOf(texture.handle));
 			texture.handle = 0;
 		}
@@ -367,16 +733,25 @@ class GLContext {
 
 	public inline function depthFunc(func:ComparisonFunction) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipDepthFunc(func)) return;
+		#end
 		glDepthFunc(func);
 	}
 
 	public inline function depthMask(flag:Bool) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipDepthMask(flag)) return;
+		#end
 		glDepthMask(flag);
 	}
 
 	public inline function depthRange(zNear:GLclampf, zFar:GLclampf) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipDepthRange(zNear, zFar)) return;
+		#end
 		glDepthRangef(zNear, zFar);
 	}
 
@@ -387,6 +762,9 @@ class GLContext {
 
 	public inline function disable(cap:Capability) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipSetCapability(cap, false)) return;
+		#end
 		glDisable(cap);
 	}
 
@@ -408,6 +786,9 @@ class GLContext {
 
 	public inline function enable(cap:Capability) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipSetCapability(cap, true)) return;
+		#end
 		glEnable(cap);
 	}
 
@@ -440,6 +821,9 @@ class GLContext {
 
 	public inline function frontFace(mode:FrontFaceDirection) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipFrontFace(mode)) return;
+		#end
 		glFrontFace(mode);
 	}
 
@@ -581,9 +965,17 @@ class GLContext {
 			case Parameter.DEPTH_CLEAR_VALUE, Parameter.LINE_WIDTH, Parameter.POLYGON_OFFSET_FACTOR, Parameter.POLYGON_OFFSET_UNITS, Parameter.SAMPLE_COVERAGE_VALUE:
 				return getFloat32(pname);
 				
-			case Parameter.ALPHA_BITS, Parameter.BLUE_BITS, Parameter.DEPTH_BITS, Parameter.GREEN_BITS, Parameter.MAX_COMBINED_TEXTURE_IMAGE_UNITS, Parameter.MAX_CUBE_MAP_TEXTURE_SIZE, Parameter.MAX_FRAGMENT_UNIFORM_VECTORS, Parameter.MAX_RENDERBUFFER_SIZE, Parameter.MAX_TEXTURE_IMAGE_UNITS, Parameter.MAX_TEXTURE_SIZE, Parameter.MAX_VARYING_VECTORS, Parameter.MAX_VERTEX_ATTRIBS, Parameter.MAX_VERTEX_TEXTURE_IMAGE_UNITS, Parameter.MAX_VERTEX_UNIFORM_VECTORS, Parameter.PACK_ALIGNMENT, Parameter.RED_BITS, Parameter.SAMPLE_BUFFERS, Parameter.SAMPLES, Parameter.STENCIL_BACK_REF, Parameter.STENCIL_BITS, Parameter.STENCIL_CLEAR_VALUE, Parameter.STENCIL_REF, Parameter.SUBPIXEL_BITS, Parameter.UNPACK_ALIGNMENT:
+			case Parameter.ALPHA_BITS, Parameter.BLUE_BITS, Parameter.DEPTH_BITS, Parameter.GREEN_BITS, Parameter.MAX_COMBINED_TEXTURE_IMAGE_UNITS, Parameter.MAX_CUBE_MAP_TEXTURE_SIZE, Parameter.MAX_FRAGMENT_UNIFORM_VECTORS, Parameter.MAX_RENDERBUFFER_SIZE, Parameter.MAX_TEXTURE_IMAGE_UNITS, Parameter.MAX_TEXTURE_SIZE, Parameter.MAX_VARYING_VECTORS, Parameter.MAX_VERTEX_ATTRIBS, Parameter.MAX_VERTEX_TEXTURE_IMAGE_UNITS, Parameter.MAX_VERTEX_UNIFORM_VECTORS, Parameter.RED_BITS, Parameter.SAMPLE_BUFFERS, Parameter.SAMPLES, Parameter.STENCIL_BACK_REF, Parameter.STENCIL_BITS, Parameter.STENCIL_CLEAR_VALUE, Parameter.STENCIL_REF, Parameter.SUBPIXEL_BITS:
 				return getInt32(pname);
 
+			case Parameter.PACK_ALIGNMENT:
+				validatePixelStore();
+				return cast packAlignment;
+
+			case Parameter.UNPACK_ALIGNMENT:
+				validatePixelStore();
+				return cast unpackAlignment;
+
 			case Parameter.STENCIL_BACK_VALUE_MASK, Parameter.STENCIL_BACK_WRITEMASK, Parameter.STENCIL_VALUE_MASK, Parameter.STENCIL_WRITEMASK:
 				return getInt32(pname);
 			
@@ -598,7 +990,11 @@ class GLContext {
 			
 			case Parameter.COMPRESSED_TEXTURE_FORMATS:
 				//"The core WebGL specification does not define any supported compressed texture formats" (supported via extensions)
-				return new Uint32Array(0);
+				var formats = new Uint32Array(enabledCompressedTextureFormats.length);
+				for (i in 0...enabledCompressedTextureFormats.length) {
+					formats[i] = enabledCompressedTextureFormats[i];
+				}
+				return formats;
 
 			// GLObject Types
 
@@ -629,8 +1025,21 @@ class GLContext {
 				// args.GetReturnValue().Set(args.Holder()->GetHiddenValue(v8::String::NewFromUtf8(isolate, "UNPACK_FLIP_Y_WEBGL")));
 			// case UNPACK_PREMULTIPLY_ALPHA_WEBGL:
 				// args.GetReturnValue().Set(args.Holder()->GetHiddenValue(v8::String::NewFromUtf8(isolate, "UNPACK_PREMULTIPLY_ALPHA_WEBGL")));
-			// extensions
-			// default: //assume pname refers to an extension parameter
+		}
+
+		// extension parameters that aren't Int32
+		switch ((pname: Int)) {
+			case 0x84FF: // EXT_texture_filter_anisotropic MAX_TEXTURE_MAX_ANISOTROPY_EXT
+				return cast getFloat32(pname);
+			case 0x9245: // WEBGL_debug_renderer_info UNMASKED_VENDOR_WEBGL
+				return cast getString(VENDOR);
+			case 0x9246: // WEBGL_debug_renderer_info UNMASKED_RENDERER_WEBGL
+				return cast getString(RENDERER);
+			case 0x8FBB: // EXT_disjoint_timer_query GPU_DISJOINT_EXT
+				return cast getBool(pname);
+			case 0x8E28: // EXT_disjoint_timer_query TIMESTAMP_EXT
+				var timerQuery: Null<EXTDisjointTimerQuery> = extensions.get('EXT_disjoint_timer_query');
+				return cast (timerQuery != null ? timerQuery.getTimestamp() : 0.0);
 		}
 
 		#if debug
@@ -640,6 +1049,40 @@ class GLContext {
 		return getInt32(pname);
 	}
 
+	/**
+		Like `getParameter()` but writes into `result` rather than allocating a new array
+	**/
+	public function getParameterInt32Array(pname:Parameter<GLInt32Array>, result:GLInt32Array): GLInt32Array {
+		setContext();
+		var n = switch pname {
+			case Parameter.MAX_VIEWPORT_DIMS: 2;
+			case Parameter.SCISSOR_BOX, Parameter.VIEWPORT: 4;
+			default: throw 'Unsupported Int32Array parameter ${StringTools.hex(pname)}';
+		}
+		if (result.length < n) {
+			throw 'Parameter ${StringTools.hex(pname)} has $n components but result has length ${result.length}';
+		}
+		glGetIntegerv(pname, result.toCPointer());
+		return result;
+	}
+
+	/**
+		Like `getParameter()` but writes into `result` rather than allocating a new array
+	**/
+	public function getParameterFloat32Array(pname:Parameter<GLFloat32Array>, result:GLFloat32Array): GLFloat32Array {
+		setContext();
+		var n = switch pname {
+			case Parameter.ALIASED_LINE_WIDTH_RANGE, Parameter.ALIASED_POINT_SIZE_RANGE, Parameter.DEPTH_RANGE: 2;
+			case Parameter.BLEND_COLOR, Parameter.COLOR_CLEAR_VALUE: 4;
+			default: throw 'Unsupported Float32Array parameter ${StringTools.hex(pname)}';
+		}
+		if (result.length < n) {
+			throw 'Parameter ${StringTools.hex(pname)} has $n components but result has length ${result.length}';
+		}
+		glGetFloatv(pname, result.toCPointer());
+		return result;
+	}
+
 
 	public inline function getError():ErrorCode {
 		setContext();
@@ -863,6 +1306,12 @@ class GLContext {
 				glGetVertexAttribfv(index, pname, temp.toCPointer());
 				return temp;
 		}
+		// ANGLE_instanced_arrays VERTEX_ATTRIB_ARRAY_DIVISOR_ANGLE
+		if ((pname: GLenum) == 0x88FE) {
+			var result: GLint = 0;
+			glGetVertexAttribiv(index, pname, Native.addressOf(result));
+			return cast result;
+		}
 		return null;
 	}
 
@@ -925,11 +1374,28 @@ class GLContext {
 
 	public inline function pixelStorei<T>(pname:PixelStoreParameter<T>, param:T) {
 		setContext();
-		glPixelStorei(pname, cast param);
+		var value: GLint = cast param;
+		validatePixelStore();
+		var name: GLenum = pname;
+		if (name == UNPACK_ALIGNMENT) {
+			unpackAlignment = value;
+		} else if (name == PACK_ALIGNMENT) {
+			packAlignment = value;
+		} else if (name == webgl.GL2Context.UNPACK_ROW_LENGTH) {
+			unpackRowLength = value;
+		} else if (name == webgl.GL2Context.UNPACK_SKIP_ROWS) {
+			unpackSkipRows = value;
+		} else if (name == webgl.GL2Context.UNPACK_SKIP_PIXELS) {
+			unpackSkipPixels = value;
+		}
+		glPixelStorei(pname, value);
 	}
 
 	public inline function polygonOffset(factor:GLfloat, units:GLfloat) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipPolygonOffset(factor, units)) return;
+		#end
 		glPolygonOffset(factor, units);
 	}
 
@@ -951,6 +1417,9 @@ class GLContext {
 
 	public inline function scissor(x:GLint, y:GLint, width:GLsizei, height:GLsizei) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipScissor(x, y, width, height)) return;
+		#end
 		glScissor(x, y, width, height);
 	}
 
@@ -964,31 +1433,49 @@ class GLContext {
 
 	public inline function stencilFunc(func:ComparisonFunction, ref:GLint, mask:GLuint) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipStencilFuncSeparate(FRONT_AND_BACK, func, ref, mask)) return;
+		#end
 		glStencilFunc(func, ref, mask);
 	}
 
 	public inline function stencilFuncSeparate(face:CullFaceMode, func:ComparisonFunction, ref:GLint, mask:GLuint) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipStencilFuncSeparate(face, func, ref, mask)) return;
+		#end
 		glStencilFuncSeparate(face, func, ref, mask);
 	}
 
 	public inline function stencilMask(mask:GLuint) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipStencilMaskSeparate(FRONT_AND_BACK, mask)) return;
+		#end
 		glStencilMask(mask);
 	}
 
 	public inline function stencilMaskSeparate(face:CullFaceMode, mask:GLuint) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipStencilMaskSeparate(face, mask)) return;
+		#end
 		glStencilMaskSeparate(face, mask);
 	}
 
 	public inline function stencilOp(fail:Operation, zfail:Operation, zpass:Operation) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipStencilOpSeparate(FRONT_AND_BACK, fail, zfail, zpass)) return;
+		#end
 		glStencilOp(fail, zfail, zpass);
 	}
 
 	public inline function stencilOpSeparate(face:CullFaceMode, fail:Operation, zfail:Operation, zpass:Operation) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipStencilOpSeparate(face, fail, zfail, zpass)) return;
+		#end
 		glStencilOpSeparate(face, fail, zfail, zpass);
 	}
 
@@ -1035,15 +1522,19 @@ class GLContext {
 
 			var ptr: Star<UInt8> = imageData != null ? imageData.toCPointer() : null;
 
-			var initialUnpackAlignment: Int32 = cast getParameter(PixelStoreParameter.UNPACK_ALIGNMENT);
-
-			// set unpack alignment to 1 for the upload
-			pixelStorei(PixelStoreParameter.UNPACK_ALIGNMENT, 1);
+			// image rows are tightly packed, unpack alignment only needs to drop to 1 when a row doesn't end on an alignment boundary
+			var rowByteLength = source.width * nChannels * (type == FLOAT ? 4 : 1);
+			validatePixelStore();
+			var realign = rowByteLength % unpackAlignment != 0;
+			if (realign) glPixelStorei(UNPACK_ALIGNMENT, 1);
 
 			glTexImage2D(target, level, internalformat, source.width, source.height, 0, format, type, cast ptr);
 
-			// restore initial unpack alignment
-			pixelStorei(PixelStoreParameter.UNPACK_ALIGNMENT, initialUnpackAlignment);
+			if (realign) glPixelStorei(UNPACK_ALIGNMENT, unpackAlignment);
+
+			if (imageSource.releasePixelDataAfterUpload) {
+				imageSource.releasePixelData();
+			}
 		}
 	}
 
@@ -1100,15 +1591,19 @@ class GLContext {
 
 			var ptr: Star<UInt8> = imageData != null ? imageData.toCPointer() : null;
 
-			var initialUnpackAlignment: Int32 = cast getParameter(PixelStoreParameter.UNPACK_ALIGNMENT);
-
-			// set unpack alignment to 1 for the upload
-			pixelStorei(PixelStoreParameter.UNPACK_ALIGNMENT, 1);
+			// image rows are tightly packed, unpack alignment only needs to drop to 1 when a row doesn't end on an alignment boundary
+			var rowByteLength = source.width * nChannels * (type == FLOAT ? 4 : 1);
+			validatePixelStore();
+			var realign = rowByteLength % unpackAlignment != 0;
+			if (realign) glPixelStorei(UNPACK_ALIGNMENT, 1);
 
 			glTexSubImage2D(target, level, xoffset, yoffset, source.width, source.height, format, type, cast ptr);
 
-			// restore initial unpack alignment
-			pixelStorei(PixelStoreParameter.UNPACK_ALIGNMENT, initialUnpackAlignment);
+			if (realign) glPixelStorei(UNPACK_ALIGNMENT, unpackAlignment);
+
+			if (imageSource.releasePixelDataAfterUpload) {
+				imageSource.releasePixelData();
+			}
 		}
 	}
 
@@ -1210,6 +1705,9 @@ class GLContext {
 	public inline function useProgram(?program:GLProgram) {
 		setContext();
 		var ref = program != null ? program.handle : 0;
+		#if gl_state_cache
+		if (stateCache.skipUseProgram(ref)) return;
+		#end
 		glUseProgram(ref);
 	}
 
@@ -1266,6 +1764,9 @@ class GLContext {
 
 	public inline function viewport(x:GLint, y:GLint, width:GLsizei, height:GLsizei) {
 		setContext();
+		#if gl_state_cache
+		if (stateCache.skipViewport(x, y, width, height)) return;
+		#end
 		glViewport(x, y, width, height);
 	}
 
@@ -1288,33 +1789,41 @@ class GLContext {
 
 	// internal utility methods
 	inline function getFloat32Array(pname: GLenum, n: Int) {
-		var temp = new Float32Array(n);
-		glGetFloatv(pname, temp.toCPointer());
-		return new Float32Array(temp);
+		var result = new Float32Array(n);
+		glGetFloatv(pname, result.toCPointer());
+		return result;
 	}
 
 	inline function getInt32Array(pname: GLenum, n: Int) {
-		var temp = new Int32Array(n);
-		glGetIntegerv(pname, temp.toCPointer());
-		return new Int32Array(temp);
+		var result = new Int32Array(n);
+		glGetIntegerv(pname, result.toCPointer());
+		return result;
 	}
 
 	inline function getGLbooleanArray(pname: GLenum, n: Int) {
-		var temp = new Uint8Array(n);
-		glGetBooleanv(pname, temp.toCPointer());
-		return new Uint8Array(temp);
+		var result = new Uint8Array(n);
+		glGetBooleanv(pname, result.toCPointer());
+		return result;
 	}
 
+	// scalar parameters are read into a local rather than a temporary typed array
+
 	inline function getInt32<T>(pname: GLenum): T {
-		return cast getInt32Array(pname, 1)[0];
+		var result: GLint = 0;
+		glGetIntegerv(pname, Native.addressOf(result));
+		return cast result;
 	}
 
 	inline function getBool(pname: GLenum): Bool {
-		return getGLbooleanArray(pname, 1)[0] != 0;
+		var result: UInt8 = 0;
+		glGetBooleanv(pname, Native.addressOf(result));
+		return result != 0;
 	}
 
 	inline function getFloat32(pname: GLenum): GLfloat {
-		return cast getFloat32Array(pname, 1)[0];
+		var result: GLfloat = 0;
+		glGetFloatv(pname, Native.addressOf(result));
+		return result;
 	}
 
 	inline function getString(pname: GLenum): String {
@@ -1323,6 +1832,11 @@ class GLContext {
 		return cStr.toString();
 	}
 
+	static inline final NAME_POOL_SIZE = 32;
+	static inline final DELETION_BATCH_SIZE = 64;
+	// object types deleted in batches are numbered below SYNC, see GLDeletionQueue
+	static inline final DELETION_BATCHED_TYPES = GLDeletionQueue.SYNC;
+
 	// constants
 
 	static public inline final DEPTH_BUFFER_BIT = 0x00000100;
@@ -0,0 +1,168 @@
+#ifndef WEBGL_NATIVE_GL_DELETION_QUEUE_H
+#define WEBGL_NATIVE_GL_DELETION_QUEUE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * GL objects released by the garbage collector
+ *
+ * Finalizers run on whichever thread collects, where the object's context may not be current, so they only push names here.
+ * Pushing is lock-free and may happen from any thread, popping must only happen on the thread that owns the context
+ *
+ * Entries live in chunks of WEBGL_DELETION_CHUNK_SIZE owned by the queue and are recycled through a free list, so a push only allocates
+ * when every entry is pending. Entries are referenced by index + 1 (0 for none) so the free list head can carry a tag against ABA in 64 bits
+ */
+#define WEBGL_DELETION_CHUNK_SIZE 1024
+#define WEBGL_DELETION_MAX_CHUNKS 1024
+
+struct WebGL_DeletionEntry {
+	std::atomic<uint32_t> next;
+	int32_t type;
+	size_t handle;
+	// entry point used to delete the object when it comes from an extension, otherwise NULL
+	void* proc;
+};
+
+struct WebGL_DeletionQueue {
+	// pending entries, pushed by finalizers and taken all at once by the context's thread
+	std::atomic<uint32_t> head;
+	// unused entries, the low 32 bits are the first entry and the high 32 bits a tag incremented on every change
+	std::atomic<uint64_t> freeHead;
+	std::atomic<uint32_t> chunkCount;
+	std::atomic<WebGL_DeletionEntry*> chunks[WEBGL_DELETION_MAX_CHUNKS];
+	// entries taken from `head` that haven't been popped yet, owned by the context's thread
+	uint32_t taken;
+	// popped entries, returned to the free list together when `taken` is empty
+	uint32_t popped;
+	WebGL_DeletionEntry* lastPopped;
+	// set when the native context is lost, its names are gone with it so later pushes are dropped
+	std::atomic<bool> discarded;
+};
+
+inline WebGL_DeletionEntry* WebGL_getDeletionEntry(WebGL_DeletionQueue* queue, uint32_t ref) {
+	uint32_t index = ref - 1;
+	return queue->chunks[index / WEBGL_DELETION_CHUNK_SIZE].load(std::memory_order_acquire) + index % WEBGL_DELETION_CHUNK_SIZE;
+}
+
+/**
+ * Pushes the chain of entries from `first` to `last` onto the free list
+ */
+inline void WebGL_freeDeletionEntries(WebGL_DeletionQueue* queue, uint32_t first, WebGL_DeletionEntry* last) {
+	uint64_t freeHead = queue->freeHead.load(std::memory_order_relaxed);
+	uint64_t newHead;
+	do {
+		last->next.store((uint32_t) freeHead, std::memory_order_relaxed);
+		newHead = (((freeHead >> 32) + 1) << 32) | first;
+	} while (!queue->freeHead.compare_exchange_weak(freeHead, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+/**
+ * Adds a chunk of entries, keeping the first for the caller and freeing the rest. Returns 0 when out of memory or chunks
+ */
+inline uint32_t WebGL_growDeletionQueue(WebGL_DeletionQueue* queue) {
+	uint32_t chunkIndex = queue->chunkCount.fetch_add(1, std::memory_order_relaxed);
+	if (chunkIndex >= WEBGL_DELETION_MAX_CHUNKS) return 0;
+	WebGL_DeletionEntry* chunk = (WebGL_DeletionEntry*) calloc(WEBGL_DELETION_CHUNK_SIZE, sizeof(WebGL_DeletionEntry));
+	if (chunk == NULL) return 0;
+	uint32_t first = chunkIndex * WEBGL_DELETION_CHUNK_SIZE + 1;
+	for (uint32_t i = 1; i < WEBGL_DELETION_CHUNK_SIZE - 1; i++) {
+		chunk[i].next.store(first + i + 1, std::memory_order_relaxed);
+	}
+	queue->chunks[chunkIndex].store(chunk, std::memory_order_release);
+	WebGL_freeDeletionEntries(queue, first + 1, &chunk[WEBGL_DELETION_CHUNK_SIZE - 1]);
+	return first;
+}
+
+/**
+ * Queues are never freed: objects may be finalized in the same collection as their context and still push to its queue
+ */
+inline WebGL_DeletionQueue* WebGL_createDeletionQueue() {
+	WebGL_DeletionQueue* queue = new WebGL_DeletionQueue();
+	queue->head.store(0);
+	queue->freeHead.store(0);
+	queue->chunkCount.store(0);
+	for (int i = 0; i < WEBGL_DELETION_MAX_CHUNKS; i++) queue->chunks[i].store(NULL);
+	queue->taken = 0;
+	queue->popped = 0;
+	queue->lastPopped = NULL;
+	queue->discarded.store(false);
+	// preallocate the first chunk so pushes never allocate until more than a chunk is pending
+	uint32_t ref = WebGL_growDeletionQueue(queue);
+	if (ref != 0) WebGL_freeDeletionEntries(queue, ref, WebGL_getDeletionEntry(queue, ref));
+	return queue;
+}
+
+inline void WebGL_pushDeletion(WebGL_DeletionQueue* queue, int32_t type, size_t handle, void* proc) {
+	if (queue->discarded.load(std::memory_order_relaxed)) return;
+
+	// take an entry from the free list, the tag makes the exchange fail if the entry was taken and freed again meanwhile
+	uint32_t ref = 0;
+	uint64_t freeHead = queue->freeHead.load(std::memory_order_acquire);
+	while ((uint32_t) freeHead != 0) {
+		uint32_t next = WebGL_getDeletionEntry(queue, (uint32_t) freeHead)->next.load(std::memory_order_relaxed);
+		uint64_t newHead = (((freeHead >> 32) + 1) << 32) | next;
+		if (queue->freeHead.compare_exchange_weak(freeHead, newHead, std::memory_order_acquire, std::memory_order_acquire)) {
+			ref = (uint32_t) freeHead;
+			break;
+		}
+	}
+	if (ref == 0) ref = WebGL_growDeletionQueue(queue);
+	// the name leaks if we're out of memory
+	if (ref == 0) return;
+
+	WebGL_DeletionEntry* entry = WebGL_getDeletionEntry(queue, ref);
+	entry->type = type;
+	entry->handle = handle;
+	entry->proc = proc;
+	uint32_t head = queue->head.load(std::memory_order_relaxed);
+	do {
+		entry->next.store(head, std::memory_order_relaxed);
+	} while (!queue->head.compare_exchange_weak(head, ref, std::memory_order_release, std::memory_order_relaxed));
+}
+
+inline bool WebGL_hasPendingDeletions(WebGL_DeletionQueue* queue) {
+	return queue->taken != 0 || queue->head.load(std::memory_order_relaxed) != 0;
+}
+
+/**
+ * Returns false when the queue is empty
+ */
+inline bool WebGL_popDeletion(WebGL_DeletionQueue* queue, int32_t* type, size_t* handle, void** proc) {
+	if (queue->taken == 0) {
+		queue->taken = queue->head.exchange(0, std::memory_order_acquire);
+		if (queue->taken == 0) return false;
+	}
+	uint32_t ref = queue->taken;
+	WebGL_DeletionEntry* entry = WebGL_getDeletionEntry(queue, ref);
+	queue->taken = entry->next.load(std::memory_order_relaxed);
+	*type = entry->type;
+	*handle = entry->handle;
+	*proc = entry->proc;
+
+	entry->next.store(queue->popped, std::memory_order_relaxed);
+	if (queue->popped == 0) queue->lastPopped = entry;
+	queue->popped = ref;
+	if (queue->taken == 0) {
+		WebGL_freeDeletionEntries(queue, queue->popped, queue->lastPopped);
+		queue->popped = 0;
+		queue->lastPopped = NULL;
+	}
+	return true;
+}
+
+/**
+ * Frees every pending entry without deleting the names and drops later pushes, called on the context's thread when the native context is lost.
+ * An entry pushed by a finalizer racing with this call may be left in the queue
+ */
+inline void WebGL_discardDeletions(WebGL_DeletionQueue* queue) {
+	queue->discarded.store(true);
+	int32_t type;
+	size_t handle;
+	void* proc;
+	while (WebGL_popDeletion(queue, &type, &handle, &proc));
+}
+
+#endif
@@ -0,0 +1,31 @@
+package webgl.native;
+
+import cpp.*;
+
+/**
+	Names of GL objects released by the garbage collector, deleted by their context in `GLContext.deletePendingObjects()` (see GLDeletionQueue.h)
+**/
+@:native('WebGL_DeletionQueue')
+@:include('./GLDeletionQueue.h')
+@:unreflective
+@:noCompletion
+extern class GLDeletionQueue {
+
+	@:native('WebGL_createDeletionQueue') static function create(): Star<GLDeletionQueue>;
+	@:native('WebGL_pushDeletion') static function push(queue: Star<GLDeletionQueue>, type: Int32, handle: SizeT, proc: Star<cpp.Void>): Void;
+	@:native('WebGL_hasPendingDeletions') static function hasPending(queue: Star<GLDeletionQueue>): Bool;
+	@:native('WebGL_popDeletion') static function pop(queue: Star<GLDeletionQueue>, type: Star<Int32>, handle: Star<SizeT>, proc: Star<Star<cpp.Void>>): Bool;
+	@:native('WebGL_discardDeletions') static function discard(queue: Star<GLDeletionQueue>): Void;
+
+	static inline final BUFFER = 0;
+	static inline final TEXTURE = 1;
+	static inline final FRAMEBUFFER = 2;
+	static inline final RENDERBUFFER = 3;
+	static inline final PROGRAM = 4;
+	static inline final SHADER = 5;
+	static inline final VERTEX_ARRAY = 6;
+	static inline final SAMPLER = 7;
+	static inline final SYNC = 8;
+	static inline final QUERY = 9;
+
+}
\ No newline at end of file
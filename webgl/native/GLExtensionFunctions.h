@@ -0,0 +1,119 @@
+#ifndef WEBGL_NATIVE_GL_EXTENSION_FUNCTIONS_H
+#define WEBGL_NATIVE_GL_EXTENSION_FUNCTIONS_H
+
+#include "./ES2Context.h"
+
+#include <stdint.h>
+
+#if defined(HX_WINDOWS)
+	#include <windows.h>
+	#define WEBGL_APIENTRY __stdcall
+#elif defined(HX_ANDROID)
+	#include <EGL/egl.h>
+	#define WEBGL_APIENTRY
+#else
+	#include <dlfcn.h>
+	#define WEBGL_APIENTRY
+#endif
+
+/**
+ * Returns the address of a GL entry point, or NULL if the driver doesn't provide it
+ * The current context must be the one the function will be called with
+ */
+static inline void* WebGL_getProcAddress(const char* name) {
+	#if defined(HX_WINDOWS)
+	intptr_t proc = (intptr_t) wglGetProcAddress(name);
+	// some drivers return small values rather than NULL on failure
+	return (proc >= -1 && proc <= 3) ? NULL : (void*) proc;
+	#elif defined(HX_ANDROID)
+	return (void*) eglGetProcAddress(name);
+	#else
+	return dlsym(RTLD_DEFAULT, name);
+	#endif
+}
+
+// calls through entry points returned by WebGL_getProcAddress
+
+static inline void WebGL_genVertexArrays(void* proc, GLsizei n, GLuint* arrays) {
+	((void (WEBGL_APIENTRY *)(GLsizei, GLuint*)) proc)(n, arrays);
+}
+
+static inline void WebGL_deleteVertexArrays(void* proc, GLsizei n, const GLuint* arrays) {
+	((void (WEBGL_APIENTRY *)(GLsizei, const GLuint*)) proc)(n, arrays);
+}
+
+static inline void WebGL_bindVertexArray(void* proc, GLuint array) {
+	((void (WEBGL_APIENTRY *)(GLuint)) proc)(array);
+}
+
+static inline bool WebGL_isVertexArray(void* proc, GLuint array) {
+	return ((GLboolean (WEBGL_APIENTRY *)(GLuint)) proc)(array) == GL_TRUE;
+}
+
+static inline void WebGL_drawArraysInstanced(void* proc, GLenum mode, GLint first, GLsizei count, GLsizei primcount) {
+	((void (WEBGL_APIENTRY *)(GLenum, GLint, GLsizei, GLsizei)) proc)(mode, first, count, primcount);
+}
+
+static inline void WebGL_drawElementsInstanced(void* proc, GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount) {
+	((void (WEBGL_APIENTRY *)(GLenum, GLsizei, GLenum, const void*, GLsizei)) proc)(mode, count, type, indices, primcount);
+}
+
+static inline void WebGL_vertexAttribDivisor(void* proc, GLuint index, GLuint divisor) {
+	((void (WEBGL_APIENTRY *)(GLuint, GLuint)) proc)(index, divisor);
+}
+
+static inline void WebGL_drawBuffers(void* proc, GLsizei n, const GLenum* buffers) {
+	((void (WEBGL_APIENTRY *)(GLsizei, const GLenum*)) proc)(n, buffers);
+}
+
+// timer queries, 64-bit results are passed as int64_t/uint64_t because GLES2 headers don't define GLint64/GLuint64
+
+static inline void WebGL_genQueries(void* proc, GLsizei n, GLuint* ids) {
+	((void (WEBGL_APIENTRY *)(GLsizei, GLuint*)) proc)(n, ids);
+}
+
+static inline void WebGL_deleteQueries(void* proc, GLsizei n, const GLuint* ids) {
+	((void (WEBGL_APIENTRY *)(GLsizei, const GLuint*)) proc)(n, ids);
+}
+
+static inline bool WebGL_isQuery(void* proc, GLuint id) {
+	return ((GLboolean (WEBGL_APIENTRY *)(GLuint)) proc)(id) == GL_TRUE;
+}
+
+static inline void WebGL_beginQuery(void* proc, GLenum target, GLuint id) {
+	((void (WEBGL_APIENTRY *)(GLenum, GLuint)) proc)(target, id);
+}
+
+static inline void WebGL_endQuery(void* proc, GLenum target) {
+	((void (WEBGL_APIENTRY *)(GLenum)) proc)(target);
+}
+
+static inline void WebGL_queryCounter(void* proc, GLuint id, GLenum target) {
+	((void (WEBGL_APIENTRY *)(GLuint, GLenum)) proc)(id, target);
+}
+
+static inline GLint WebGL_getQueryiv(void* proc, GLenum target, GLenum pname) {
+	GLint value = 0;
+	((void (WEBGL_APIENTRY *)(GLenum, GLenum, GLint*)) proc)(target, pname, &value);
+	return value;
+}
+
+static inline GLuint WebGL_getQueryObjectuiv(void* proc, GLuint id, GLenum pname) {
+	GLuint value = 0;
+	((void (WEBGL_APIENTRY *)(GLuint, GLenum, GLuint*)) proc)(id, pname, &value);
+	return value;
+}
+
+static inline uint64_t WebGL_getQueryObjectui64v(void* proc, GLuint id, GLenum pname) {
+	uint64_t value = 0;
+	((void (WEBGL_APIENTRY *)(GLuint, GLenum, uint64_t*)) proc)(id, pname, &value);
+	return value;
+}
+
+static inline int64_t WebGL_getInteger64v(void* proc, GLenum pname) {
+	int64_t value = 0;
+	((void (WEBGL_APIENTRY *)(GLenum, int64_t*)) proc)(pname, &value);
+	return value;
+}
+
+#endif
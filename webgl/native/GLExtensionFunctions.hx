@@ -0,0 +1,61 @@
+package webgl.native;
+
+import cpp.*;
+import webgl.GLContext;
+
+/**
+	Entry points that aren't part of GLES2 are looked up at runtime and called through function pointers
+**/
+@:native('')
+@:include('./GLExtensionFunctions.h')
+@:unreflective
+@:noCompletion
+extern class GLExtensionFunctions {
+
+	@:native('WebGL_getProcAddress') static function getProcAddress(name: ConstCharStar): Star<cpp.Void>;
+
+	@:native('WebGL_genVertexArrays') static function genVertexArrays(proc: Star<cpp.Void>, n: GLsizei, arrays: Star<GLuint>): Void;
+	@:native('WebGL_deleteVertexArrays') static function deleteVertexArrays(proc: Star<cpp.Void>, n: GLsizei, arrays: ConstStar<GLuint>): Void;
+	@:native('WebGL_bindVertexArray') static function bindVertexArray(proc: Star<cpp.Void>, array: GLuint): Void;
+	@:native('WebGL_isVertexArray') static function isVertexArray(proc: Star<cpp.Void>, array: GLuint): Bool;
+	@:native('WebGL_drawArraysInstanced') static function drawArraysInstanced(proc: Star<cpp.Void>, mode: GLenum, first: GLint, count: GLsizei, primcount: GLsizei): Void;
+	@:native('WebGL_drawElementsInstanced') static function drawElementsInstanced(proc: Star<cpp.Void>, mode: GLenum, count: GLsizei, type: GLenum, indices: ConstStar<cpp.Void>, primcount: GLsizei): Void;
+	@:native('WebGL_vertexAttribDivisor') static function vertexAttribDivisor(proc: Star<cpp.Void>, index: GLuint, divisor: GLuint): Void;
+	@:native('WebGL_drawBuffers') static function drawBuffers(proc: Star<cpp.Void>, n: GLsizei, buffers: ConstStar<GLenum>): Void;
+	@:native('WebGL_genQueries') static function genQueries(proc: Star<cpp.Void>, n: GLsizei, ids: Star<GLuint>): Void;
+	@:native('WebGL_deleteQueries') static function deleteQueries(proc: Star<cpp.Void>, n: GLsizei, ids: ConstStar<GLuint>): Void;
+	@:native('WebGL_isQuery') static function isQuery(proc: Star<cpp.Void>, id: GLuint): Bool;
+	@:native('WebGL_beginQuery') static function beginQuery(proc: Star<cpp.Void>, target: GLenum, id: GLuint): Void;
+	@:native('WebGL_endQuery') static function endQuery(proc: Star<cpp.Void>, target: GLenum): Void;
+	@:native('WebGL_queryCounter') static function queryCounter(proc: Star<cpp.Void>, id: GLuint, target: GLenum): Void;
+	@:native('WebGL_getQueryiv') static function getQueryiv(proc: Star<cpp.Void>, target: GLenum, pname: GLenum): GLint;
+	@:native('WebGL_getQueryObjectuiv') static function getQueryObjectuiv(proc: Star<cpp.Void>, id: GLuint, pname: GLenum): GLuint;
+	@:native('WebGL_getQueryObjectui64v') static function getQueryObjectui64v(proc: Star<cpp.Void>, id: GLuint, pname: GLenum): UInt64;
+	@:native('WebGL_getInteger64v') static function getInteger64v(proc: Star<cpp.Void>, pname: GLenum): Int64;
+
+	/**
+		Returns the first suffix (e.g. `OES`, or `''` for core entry points) for which every function in `names` is provided by the driver, or null if there is none
+	**/
+	static inline function findSuffix(names: Array<String>, suffixes: Array<String>): Null<String> {
+		var found: Null<String> = null;
+		for (suffix in suffixes) {
+			var allFound = true;
+			for (name in names) {
+				if (getProcAddress(ConstCharStar.fromString(name + suffix)) == null) {
+					allFound = false;
+					break;
+				}
+			}
+			if (allFound) {
+				found = suffix;
+				break;
+			}
+		}
+		return found;
+	}
+
+	static inline function getProc(name: String): Star<cpp.Void> {
+		return getProcAddress(ConstCharStar.fromString(name));
+	}
+
+}
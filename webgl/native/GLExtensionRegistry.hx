@@ -0,0 +1,110 @@
+package webgl.native;
+
+import webgl.extension.*;
+
+/**
+	A context's supported extensions, read from the driver once when the context is created
+
+	Extension objects are created up front (resolving any function pointers they need) so `getExtension()` is a map lookup that returns the same object on every call.
+	Only WebGL extensions are reported; each is enabled when the driver has an equivalent GL extension or the feature is core in the driver's GL version
+**/
+@:allow(webgl.native.GLContext)
+@:access(webgl.native.GLContext)
+@:access(webgl.extension)
+@:noCompletion
+class GLExtensionRegistry {
+
+	// driver extension names without the GL_ prefix
+	final glExtensions = new Map<String, Bool>();
+	// in the order reported by getSupportedExtensions()
+	final supportedNames = new Array<String>();
+	final objects = new Map<String, Any>();
+	final compressedTextureExtensions = new Map<String, CompressedTextureExtension>();
+	// names passed to getExtension()
+	final enabled = new Map<String, Bool>();
+
+	/**
+		The context must be current
+	**/
+	function new(context: GLContext) {
+		var extensionList = context.getString(GLContext.EXTENSIONS).split(' ').filter(name -> name.length > 0).map(name -> name.substr(3)); // remove GL_ prefix
+		for (name in extensionList) {
+			glExtensions.set(name, true);
+		}
+
+		// compressed texture formats are exposed under different names by desktop and mobile drivers
+		var driverFormats = context.getDriverCompressedTextureFormats();
+		for (name in CompressedTextureExtension.names) {
+			var extension = CompressedTextureExtension.create(name, extensionList, driverFormats);
+			if (extension != null) {
+				compressedTextureExtensions.set(name, extension);
+				add(name, extension);
+			}
+		}
+
+		var glVersion = context.getString(GLContext.VERSION);
+		var glMajorVersion = getMajorVersion(glVersion);
+		var gles = glVersion.indexOf('OpenGL ES') != -1;
+		var gles3 = gles && glMajorVersion >= 3;
+		var desktop = !gles;
+		var desktop3 = desktop && glMajorVersion >= 3;
+
+		// extensions with entry points, available under several extension names or core
+		add('OES_vertex_array_object', OESVertexArrayObject.create(context, extensionList, glMajorVersion));
+		add('ANGLE_instanced_arrays', ANGLEInstancedArrays.create(context, extensionList, glMajorVersion));
+		add('WEBGL_draw_buffers', WEBGLDrawBuffers.create(context, extensionList, glMajorVersion));
+		add('EXT_disjoint_timer_query', EXTDisjointTimerQuery.create(context, extensionList));
+
+		// extensions that only add constants, formats or shader features
+		if (has(['EXT_blend_minmax']) || desktop || gles3) add('EXT_blend_minmax', new EXTBlendMinmax());
+		if (has(['EXT_color_buffer_float']) || desktop3) add('EXT_color_buffer_float', new EXTColorBufferFloat());
+		if (has(['EXT_color_buffer_half_float', 'EXT_color_buffer_float']) || desktop3) add('EXT_color_buffer_half_float', new EXTColorBufferHalfFloat());
+		if (has(['EXT_frag_depth']) || desktop) add('EXT_frag_depth', new EXTFragDepth());
+		if (has(['EXT_sRGB']) || desktop || gles3) add('EXT_sRGB', new EXTSrgb());
+		if (has(['EXT_shader_texture_lod', 'ARB_shader_texture_lod'])) add('EXT_shader_texture_lod', new EXTShaderTextureLod());
+		if (has(['EXT_texture_filter_anisotropic', 'ARB_texture_filter_anisotropic'])) add('EXT_texture_filter_anisotropic', new EXTTextureFilterAnisotropic());
+		if (has(['OES_element_index_uint']) || desktop || gles3) add('OES_element_index_uint', new OESElementIndexUint());
+		if (has(['OES_standard_derivatives']) || desktop || gles3) add('OES_standard_derivatives', new OESStandardDerivatives());
+		if (has(['OES_texture_float', 'ARB_texture_float']) || desktop3 || gles3) add('OES_texture_float', new OESTextureFloat());
+		if (has(['OES_texture_float_linear']) || desktop3) add('OES_texture_float_linear', new OESTextureFloatLinear());
+		if (has(['OES_texture_half_float', 'ARB_half_float_pixel']) || desktop3 || gles3) add('OES_texture_half_float', new OESTextureHalfFloat());
+		if (has(['OES_texture_half_float_linear']) || desktop3 || gles3) add('OES_texture_half_float_linear', new OESTextureHalfFloatLinear());
+		if (has(['EXT_color_buffer_float', 'ARB_color_buffer_float']) || desktop3) add('WEBGL_color_buffer_float', new WEBGLColorBufferFloat());
+		if (has(['OES_depth_texture', 'ANGLE_depth_texture', 'ARB_depth_texture']) || desktop3 || gles3) add('WEBGL_depth_texture', new WEBGLDepthTexture());
+
+		// implemented on top of core GL
+		add('WEBGL_debug_renderer_info', new WEBGLDebugRendererInfo());
+		add('WEBGL_debug_shaders', new WEBGLDebugShaders(context));
+		add('WEBGL_lose_context', new WEBGLLoseContext(context));
+	}
+
+	inline function get(name: String): Null<Any> {
+		return objects.get(name);
+	}
+
+	function add(name: String, extension: Null<Any>) {
+		if (extension == null) return;
+		objects.set(name, extension);
+		supportedNames.push(name);
+	}
+
+	/**
+		True if the driver lists any of `aliases`
+	**/
+	function has(aliases: Array<String>): Bool {
+		for (alias in aliases) {
+			if (glExtensions.exists(alias)) return true;
+		}
+		return false;
+	}
+
+	/**
+		Major version from a `VERSION` string, e.g. 3 for `OpenGL ES 3.0` or `3.3.0 NVIDIA`
+	**/
+	static function getMajorVersion(version: String): Int {
+		var pattern = ~/(\d+)\.\d+/;
+		var major = pattern.match(version) ? Std.parseInt(pattern.matched(1)) : null;
+		return major != null ? major : 2;
+	}
+
+}
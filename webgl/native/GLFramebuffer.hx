@@ -6,7 +6,7 @@ final class GLFramebuffer extends GLObject {
 
 	@:noCompletion
 	override public function finalize() {
-		context.deleteFramebuffer(this);
+		deleteLater(GLDeletionQueue.FRAMEBUFFER, null);
 	}
 
 }
\ No newline at end of file
@@ -4,6 +4,7 @@ import cpp.NativeGc;
 import webgl.GLContext.GLuint;
 
 @:allow(webgl.native.GLContext)
+@:access(webgl.native.GLContext)
 @:noCompletion
 class GLObject {
 
@@ -22,4 +23,12 @@ class GLObject {
 		handle = 0;
 	}
 
+	/**
+		Finalizers may run on any thread while another context is current, so the name is deleted later by `context.deletePendingObjects()`
+	**/
+	inline function deleteLater(type: Int, proc: cpp.Star<cpp.Void>) {
+		if (handle != 0) GLDeletionQueue.push(context.deletionQueue, type, cast handle, proc);
+		handle = 0;
+	}
+
 }
\ No newline at end of file
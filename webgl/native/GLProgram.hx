@@ -6,7 +6,7 @@ final class GLProgram extends GLObject {
 
 	@:noCompletion
 	override public function finalize() {
-		context.deleteProgram(this);
+		deleteLater(GLDeletionQueue.PROGRAM, null);
 	}
 
 }
\ No newline at end of file
@@ -6,7 +6,7 @@ final class GLRenderbuffer extends GLObject {
 
 	@:noCompletion
 	override public function finalize() {
-		context.deleteRenderbuffer(this);
+		deleteLater(GLDeletionQueue.RENDERBUFFER, null);
 	}
 
 }
\ No newline at end of file
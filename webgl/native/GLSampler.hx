@@ -0,0 +1,13 @@
+package webgl.native;
+
+@:allow(webgl.native.GLContext)
+@:allow(webgl.native.GL2Context)
+@:noCompletion
+final class GLSampler extends GLObject {
+
+	@:noCompletion
+	override public function finalize() {
+		deleteLater(GLDeletionQueue.SAMPLER, null);
+	}
+
+}
\ No newline at end of file
@@ -6,7 +6,7 @@ final class GLShader extends GLObject {
 
 	@:noCompletion
 	override public function finalize() {
-		context.deleteShader(this);
+		deleteLater(GLDeletionQueue.SHADER, null);
 	}
 
 }
\ No newline at end of file
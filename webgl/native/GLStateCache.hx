@@ -0,0 +1,435 @@
+package webgl.native;
+
+import webgl.GLContext.GLenum;
+
+/**
+	Shadow copy of a context's GL state used to skip calls that would not change it, enabled with `-D gl_state_cache`
+
+	Each `skip*` method returns true if the call is redundant, otherwise it records the new state and the call must be made.
+	State is unknown (and the next call is always made) after `invalidate()`, which happens for every context when native code may have made GL calls, see `GLContext.postHaxeExecution()`
+
+	Texture bindings are cached for the first 32 units and the 2D, cube map, 3D and 2D array targets, buffer bindings for the WebGL2 generic binding points;
+	calls for other units or targets are always made. `clearStencil()`, `lineWidth()`, `sampleCoverage()` and `hint()` are not cached, pixel store state is shadowed by `GLContext` itself
+**/
+@:allow(webgl.native.GLContext)
+@:noCompletion
+class GLStateCache {
+
+	/**
+		Calls skipped because they would not change state, summed over all contexts
+	**/
+	static public var elidedCalls(default, null): Int = 0;
+
+	/**
+		Calls made to the driver by methods that check the state cache
+	**/
+	static public var issuedCalls(default, null): Int = 0;
+
+	/**
+		Set to false if native code never makes GL calls on haxe's contexts, so state is kept between callbacks into haxe
+	**/
+	static public var invalidateAfterHaxeExecution: Bool = true;
+
+	static var generation: Int = 0;
+
+	static public function resetCounters() {
+		elidedCalls = 0;
+		issuedCalls = 0;
+	}
+
+	/**
+		Forget the shadowed state of every context
+	**/
+	static public function invalidateAll() {
+		generation++;
+	}
+
+	var cacheGeneration: Int = -1;
+
+	var activeTextureUnit: Int = -1;
+	// indexed by unit * TEXTURE_TARGETS + textureTargetIndex(target), -1 when unknown
+	final textureBindings = [for (i in 0...TEXTURE_UNITS * TEXTURE_TARGETS) -1];
+	// indexed by bufferTargetIndex(target)
+	final bufferBindings = [for (i in 0...BUFFER_TARGETS) -1];
+	var readFramebuffer: Int = -1;
+	var drawFramebuffer: Int = -1;
+	var renderbuffer: Int = -1;
+	var program: Int = -1;
+	var vertexArray: Int = -1;
+
+	final capabilities = new Map<Int, Bool>();
+
+	var blendSrcRGB: Int = -1;
+	var blendDstRGB: Int = -1;
+	var blendSrcAlpha: Int = -1;
+	var blendDstAlpha: Int = -1;
+	var blendEquationRGB: Int = -1;
+	var blendEquationAlpha: Int = -1;
+	final blendColor = [Math.NaN, Math.NaN, Math.NaN, Math.NaN];
+
+	var depthFunc: Int = -1;
+	var depthMask: Int = -1;
+	var clearDepth: Float = Math.NaN;
+	var depthRangeNear: Float = Math.NaN;
+	var depthRangeFar: Float = Math.NaN;
+	var polygonOffsetFactor: Float = Math.NaN;
+	var polygonOffsetUnits: Float = Math.NaN;
+	var cullFaceMode: Int = -1;
+	var frontFaceMode: Int = -1;
+	var colorMask: Int = -1;
+
+	// front and back face values
+	final stencilFunc = [-1, -1];
+	final stencilRef = [-1, -1];
+	final stencilValueMask = [-1, -1];
+	final stencilWriteMask = [-1, -1];
+	final stencilFail = [-1, -1];
+	final stencilDepthFail = [-1, -1];
+	final stencilDepthPass = [-1, -1];
+
+	final viewport = [-1, -1, -1, -1];
+	final scissor = [-1, -1, -1, -1];
+	final clearColor = [Math.NaN, Math.NaN, Math.NaN, Math.NaN];
+
+	function new() { }
+
+	/**
+		Forget the shadowed state if `invalidateAll()` has been called since the state was recorded
+	**/
+	inline function validate() {
+		if (cacheGeneration != generation) {
+			invalidate();
+		}
+	}
+
+	function invalidate() {
+		cacheGeneration = generation;
+		activeTextureUnit = -1;
+		for (i in 0...textureBindings.length) textureBindings[i] = -1;
+		for (i in 0...bufferBindings.length) bufferBindings[i] = -1;
+		readFramebuffer = drawFramebuffer = -1;
+		renderbuffer = -1;
+		program = -1;
+		vertexArray = -1;
+		capabilities.clear();
+		blendSrcRGB = blendDstRGB = blendSrcAlpha = blendDstAlpha = -1;
+		blendEquationRGB = blendEquationAlpha = -1;
+		depthFunc = depthMask = cullFaceMode = frontFaceMode = colorMask = -1;
+		clearDepth = depthRangeNear = depthRangeFar = Math.NaN;
+		polygonOffsetFactor = polygonOffsetUnits = Math.NaN;
+		for (i in 0...2) {
+			stencilFunc[i] = stencilRef[i] = stencilValueMask[i] = stencilWriteMask[i] = -1;
+			stencilFail[i] = stencilDepthFail[i] = stencilDepthPass[i] = -1;
+		}
+		for (i in 0...4) {
+			viewport[i] = scissor[i] = -1;
+			blendColor[i] = clearColor[i] = Math.NaN;
+		}
+	}
+
+	inline function result(redundant: Bool): Bool {
+		if (redundant) elidedCalls++ else issuedCalls++;
+		return redundant;
+	}
+
+	function skipActiveTexture(unit: GLenum): Bool {
+		if (result(activeTextureUnit == unit)) return true;
+		activeTextureUnit = unit;
+		return false;
+	}
+
+	function skipBindTexture(target: GLenum, texture: Int): Bool {
+		// the binding can't be recorded if the active unit is unknown
+		var unit = activeTextureUnit - GLContext.TEXTURE0;
+		var targetIndex = textureTargetIndex(target);
+		if (activeTextureUnit == -1 || unit < 0 || unit >= TEXTURE_UNITS || targetIndex == -1) return result(false);
+		var index = unit * TEXTURE_TARGETS + targetIndex;
+		if (result(textureBindings[index] == texture)) return true;
+		textureBindings[index] = texture;
+		return false;
+	}
+
+	function skipBindBuffer(target: GLenum, buffer: Int): Bool {
+		var index = bufferTargetIndex(target);
+		if (index == -1) return result(false);
+		if (result(bufferBindings[index] == buffer)) return true;
+		bufferBindings[index] = buffer;
+		return false;
+	}
+
+	/**
+		`bindBufferBase()` and `bindBufferRange()` also bind the buffer to the generic binding point of `target`
+	**/
+	function onBindBufferBase(target: GLenum, buffer: Int) {
+		var index = bufferTargetIndex(target);
+		if (index != -1) bufferBindings[index] = buffer;
+	}
+
+	function skipBindFramebuffer(target: GLenum, framebuffer: Int): Bool {
+		var redundant =
+			if (target == READ_FRAMEBUFFER) readFramebuffer == framebuffer;
+			else if (target == DRAW_FRAMEBUFFER) drawFramebuffer == framebuffer;
+			else readFramebuffer == framebuffer && drawFramebuffer == framebuffer;
+		if (result(redundant)) return true;
+		if (target != DRAW_FRAMEBUFFER) readFramebuffer = framebuffer;
+		if (target != READ_FRAMEBUFFER) drawFramebuffer = framebuffer;
+		return false;
+	}
+
+	function skipBindRenderbuffer(renderbuffer: Int): Bool {
+		if (result(this.renderbuffer == renderbuffer)) return true;
+		this.renderbuffer = renderbuffer;
+		return false;
+	}
+
+	function skipUseProgram(program: Int): Bool {
+		if (result(this.program == program)) return true;
+		this.program = program;
+		return false;
+	}
+
+	function skipBindVertexArray(vertexArray: Int): Bool {
+		if (result(this.vertexArray == vertexArray)) return true;
+		this.vertexArray = vertexArray;
+		// the element array buffer binding is part of the vertex array object's state
+		bufferBindings[ELEMENT_ARRAY_BUFFER_INDEX] = -1;
+		return false;
+	}
+
+	function skipSetCapability(cap: GLenum, enabled: Bool): Bool {
+		if (result(capabilities.get(cap) == enabled)) return true;
+		capabilities.set(cap, enabled);
+		return false;
+	}
+
+	function skipBlendFuncSeparate(srcRGB: GLenum, dstRGB: GLenum, srcAlpha: GLenum, dstAlpha: GLenum): Bool {
+		if (result(blendSrcRGB == srcRGB && blendDstRGB == dstRGB && blendSrcAlpha == srcAlpha && blendDstAlpha == dstAlpha)) return true;
+		blendSrcRGB = srcRGB;
+		blendDstRGB = dstRGB;
+		blendSrcAlpha = srcAlpha;
+		blendDstAlpha = dstAlpha;
+		return false;
+	}
+
+	function skipBlendEquationSeparate(modeRGB: GLenum, modeAlpha: GLenum): Bool {
+		if (result(blendEquationRGB == modeRGB && blendEquationAlpha == modeAlpha)) return true;
+		blendEquationRGB = modeRGB;
+		blendEquationAlpha = modeAlpha;
+		return false;
+	}
+
+	function skipBlendColor(r: Float, g: Float, b: Float, a: Float): Bool {
+		return skipSetColor(blendColor, r, g, b, a);
+	}
+
+	function skipClearColor(r: Float, g: Float, b: Float, a: Float): Bool {
+		return skipSetColor(clearColor, r, g, b, a);
+	}
+
+	function skipDepthFunc(func: GLenum): Bool {
+		if (result(depthFunc == func)) return true;
+		depthFunc = func;
+		return false;
+	}
+
+	function skipDepthMask(flag: Bool): Bool {
+		var value = flag ? 1 : 0;
+		if (result(depthMask == value)) return true;
+		depthMask = value;
+		return false;
+	}
+
+	function skipClearDepth(depth: Float): Bool {
+		if (result(clearDepth == depth)) return true;
+		clearDepth = depth;
+		return false;
+	}
+
+	function skipDepthRange(zNear: Float, zFar: Float): Bool {
+		if (result(depthRangeNear == zNear && depthRangeFar == zFar)) return true;
+		depthRangeNear = zNear;
+		depthRangeFar = zFar;
+		return false;
+	}
+
+	function skipPolygonOffset(factor: Float, units: Float): Bool {
+		if (result(polygonOffsetFactor == factor && polygonOffsetUnits == units)) return true;
+		polygonOffsetFactor = factor;
+		polygonOffsetUnits = units;
+		return false;
+	}
+
+	function skipCullFace(mode: GLenum): Bool {
+		if (result(cullFaceMode == mode)) return true;
+		cullFaceMode = mode;
+		return false;
+	}
+
+	function skipFrontFace(mode: GLenum): Bool {
+		if (result(frontFaceMode == mode)) return true;
+		frontFaceMode = mode;
+		return false;
+	}
+
+	function skipColorMask(red: Bool, green: Bool, blue: Bool, alpha: Bool): Bool {
+		var value = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
+		if (result(colorMask == value)) return true;
+		colorMask = value;
+		return false;
+	}
+
+	function skipStencilFuncSeparate(face: GLenum, func: GLenum, ref: Int, mask: Int): Bool {
+		var redundant = true;
+		for (i in faceIndices(face)) {
+			redundant = redundant && stencilFunc[i] == func && stencilRef[i] == ref && stencilValueMask[i] == mask;
+		}
+		if (result(redundant)) return true;
+		for (i in faceIndices(face)) {
+			stencilFunc[i] = func;
+			stencilRef[i] = ref;
+			stencilValueMask[i] = mask;
+		}
+		return false;
+	}
+
+	function skipStencilMaskSeparate(face: GLenum, mask: Int): Bool {
+		var redundant = true;
+		for (i in faceIndices(face)) {
+			redundant = redundant && stencilWriteMask[i] == mask;
+		}
+		if (result(redundant)) return true;
+		for (i in faceIndices(face)) {
+			stencilWriteMask[i] = mask;
+		}
+		return false;
+	}
+
+	function skipStencilOpSeparate(face: GLenum, fail: GLenum, zfail: GLenum, zpass: GLenum): Bool {
+		var redundant = true;
+		for (i in faceIndices(face)) {
+			redundant = redundant && stencilFail[i] == fail && stencilDepthFail[i] == zfail && stencilDepthPass[i] == zpass;
+		}
+		if (result(redundant)) return true;
+		for (i in faceIndices(face)) {
+			stencilFail[i] = fail;
+			stencilDepthFail[i] = zfail;
+			stencilDepthPass[i] = zpass;
+		}
+		return false;
+	}
+
+	function skipViewport(x: Int, y: Int, width: Int, height: Int): Bool {
+		return skipSetRect(viewport, x, y, width, height);
+	}
+
+	function skipScissor(x: Int, y: Int, width: Int, height: Int): Bool {
+		return skipSetRect(scissor, x, y, width, height);
+	}
+
+	/**
+		GL unbinds deleted objects, and their names may be reused by new objects
+	**/
+	function onDeleteTexture(texture: Int) {
+		for (i in 0...textureBindings.length) {
+			if (textureBindings[i] == texture) textureBindings[i] = 0;
+		}
+	}
+
+	function onDeleteBuffer(buffer: Int) {
+		for (i in 0...bufferBindings.length) {
+			if (bufferBindings[i] == buffer) bufferBindings[i] = 0;
+		}
+	}
+
+	function onDeleteFramebuffer(framebuffer: Int) {
+		if (readFramebuffer == framebuffer) readFramebuffer = 0;
+		if (drawFramebuffer == framebuffer) drawFramebuffer = 0;
+	}
+
+	function onDeleteRenderbuffer(renderbuffer: Int) {
+		if (this.renderbuffer == renderbuffer) this.renderbuffer = 0;
+	}
+
+	function onDeleteProgram(program: Int) {
+		// a deleted program stays in use until another is used, but its name may be reused
+		if (this.program == program) this.program = -1;
+	}
+
+	function onDeleteVertexArray(vertexArray: Int) {
+		if (this.vertexArray == vertexArray) {
+			// GL reverts to the default vertex array object
+			this.vertexArray = 0;
+			bufferBindings[ELEMENT_ARRAY_BUFFER_INDEX] = -1;
+		}
+	}
+
+	function skipSetRect(rect: Array<Int>, x: Int, y: Int, width: Int, height: Int): Bool {
+		if (result(rect[0] == x && rect[1] == y && rect[2] == width && rect[3] == height)) return true;
+		rect[0] = x;
+		rect[1] = y;
+		rect[2] = width;
+		rect[3] = height;
+		return false;
+	}
+
+	function skipSetColor(color: Array<Float>, r: Float, g: Float, b: Float, a: Float): Bool {
+		if (result(color[0] == r && color[1] == g && color[2] == b && color[3] == a)) return true;
+		color[0] = r;
+		color[1] = g;
+		color[2] = b;
+		color[3] = a;
+		return false;
+	}
+
+	static inline function faceIndices(face: GLenum): IntIterator {
+		return if (face == GLContext.FRONT) 0...1 else if (face == GLContext.BACK) 1...2 else 0...2;
+	}
+
+	/**
+		Returns -1 for targets that aren't cached
+	**/
+	static inline function textureTargetIndex(target: GLenum): Int {
+		var t: Int = target;
+		return
+			if (t == GLContext.TEXTURE_2D) 0
+			else if (t == GLContext.TEXTURE_CUBE_MAP) 1
+			else if (t == TEXTURE_3D) 2
+			else if (t == TEXTURE_2D_ARRAY) 3
+			else -1;
+	}
+
+	/**
+		Returns -1 for targets that aren't cached
+	**/
+	static inline function bufferTargetIndex(target: GLenum): Int {
+		var t: Int = target;
+		return
+			if (t == GLContext.ARRAY_BUFFER) 0
+			else if (t == GLContext.ELEMENT_ARRAY_BUFFER) ELEMENT_ARRAY_BUFFER_INDEX
+			else if (t == COPY_READ_BUFFER) 2
+			else if (t == COPY_WRITE_BUFFER) 3
+			else if (t == PIXEL_PACK_BUFFER) 4
+			else if (t == PIXEL_UNPACK_BUFFER) 5
+			else if (t == TRANSFORM_FEEDBACK_BUFFER) 6
+			else if (t == UNIFORM_BUFFER) 7
+			else -1;
+	}
+
+	// GL_TEXTURE0 to GL_TEXTURE31 are the units with their own enum
+	static inline final TEXTURE_UNITS = 32;
+	static inline final TEXTURE_TARGETS = 4;
+	static inline final BUFFER_TARGETS = 8;
+	static inline final ELEMENT_ARRAY_BUFFER_INDEX = 1;
+
+	static inline final READ_FRAMEBUFFER = 0x8CA8;
+	static inline final DRAW_FRAMEBUFFER = 0x8CA9;
+	static inline final TEXTURE_3D = 0x806F;
+	static inline final TEXTURE_2D_ARRAY = 0x8C1A;
+	static inline final COPY_READ_BUFFER = 0x8F36;
+	static inline final COPY_WRITE_BUFFER = 0x8F37;
+	static inline final PIXEL_PACK_BUFFER = 0x88EB;
+	static inline final PIXEL_UNPACK_BUFFER = 0x88EC;
+	static inline final TRANSFORM_FEEDBACK_BUFFER = 0x8C8E;
+	static inline final UNIFORM_BUFFER = 0x8A11;
+
+}
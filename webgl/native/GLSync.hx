@@ -0,0 +1,28 @@
+package webgl.native;
+
+import cpp.NativeGc;
+
+@:allow(webgl.native.GL2Context)
+@:access(webgl.native.GLContext)
+@:noCompletion
+final class GLSync {
+
+	final context: GL2Context;
+	var handle: cpp.Star<cpp.Void>;
+
+	function new(context: GL2Context, handle: cpp.Star<cpp.Void>) {
+		this.context = context;
+		this.handle = handle;
+		NativeGc.addFinalizable(this, false);
+	}
+
+	/**
+		Finalizers may run on any thread while another context is current, so the sync is deleted later by `context.deletePendingObjects()`
+	**/
+	@:noCompletion
+	public function finalize() {
+		if (handle != null) GLDeletionQueue.push(context.deletionQueue, GLDeletionQueue.SYNC, untyped __cpp__('(size_t){0}', handle), null);
+		handle = null;
+	}
+
+}
\ No newline at end of file
@@ -6,7 +6,7 @@ final class GLTexture extends GLObject {
 
 	@:noCompletion
 	override public function finalize() {
-		context.deleteTexture(this);
+		deleteLater(GLDeletionQueue.TEXTURE, null);
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+package webgl.native;
+
+import webgl.GLContext.GLuint;
+import webgl.extension.EXTDisjointTimerQuery;
+
+/**
+	`WebGLTimerQueryEXT`, created by `EXTDisjointTimerQuery.createQueryEXT()`
+**/
+@:allow(webgl.extension.EXTDisjointTimerQuery)
+@:access(webgl.extension.EXTDisjointTimerQuery)
+@:noCompletion
+final class GLTimerQuery extends GLObject {
+
+	final extension: EXTDisjointTimerQuery;
+
+	function new(context: GLContext, handle: GLuint, extension: EXTDisjointTimerQuery) {
+		super(context, handle);
+		this.extension = extension;
+	}
+
+	@:noCompletion
+	override public function finalize() {
+		deleteLater(GLDeletionQueue.QUERY, extension.glDeleteQueries);
+	}
+
+}
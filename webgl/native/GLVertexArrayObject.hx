@@ -0,0 +1,24 @@
+package webgl.native;
+
+import webgl.GLContext.GLuint;
+import webgl.extension.OESVertexArrayObject;
+
+@:allow(webgl.native.GLContext)
+@:allow(webgl.extension.OESVertexArrayObject)
+@:access(webgl.extension.OESVertexArrayObject)
+@:noCompletion
+final class GLVertexArrayObject extends GLObject {
+
+	final extension: OESVertexArrayObject;
+
+	function new(context: GLContext, handle: GLuint, extension: OESVertexArrayObject) {
+		super(context, handle);
+		this.extension = extension;
+	}
+
+	@:noCompletion
+	override public function finalize() {
+		deleteLater(GLDeletionQueue.VERTEX_ARRAY, extension.glDeleteVertexArrays);
+	}
+
+}
@@ -0,0 +1,1240 @@
+/**
+ * GL call pattern benchmarks for the native WebGL layer
+ *
+ * Each benchmark issues the GL calls the Haxe classes make, on a real OpenGL ES 3.0 context, with and without the optimization:
+ *   BM_SpriteScene   redundant state changes of a sprite renderer, direct vs skipped the way GLStateCache does (-D gl_state_cache)
+ *   BM_DrawCalls     per-draw attribute setup vs OES_vertex_array_object vs ANGLE_instanced_arrays
+ *   BM_UniformBlock  uniform*() per draw vs UniformRing's one bufferSubData() and a bindBufferRange() per draw
+ *   BM_StreamingRing bufferData() per dynamic draw vs DynamicBufferRing's orphaned ring, uploading per draw or once per frame
+ *   BM_MakeCurrent   two views drawn each frame, the host making each view current and GLContext making it current again vs being told it is current
+ *   BM_TextureUpload textures uploaded all at once vs sliced over frames by TextureUploadQueue, reported as a histogram of frame times
+ *   BM_DeletionChurn create and delete buffers one call each vs GLContext's name pool and batched GLDeletionQueue
+ *   BM_Transcode     Basis Universal KTX2 transcoding per target format, only built with BASIS_UNIVERSAL=<path> and run with --ktx2=<file>
+ *
+ * Output follows Google Benchmark's console format so results can be compared across commits:
+ *   ./benchmark                 table on stdout
+ *   ./benchmark --json > a.json results as JSON
+ *   ./benchmark --filter=Sprite only benchmarks whose name contains the filter
+ *   ./benchmark --min-time=2    run each benchmark for at least 2 seconds
+ * Every iteration is one frame and ends with glFinish(), so time includes the driver's work for the frame.
+ * Benchmarks with a frame cycle run whole cycles and also report how their frame times are distributed
+ *
+ * Limitation: compiled Haxe code can't be linked into this harness, so the logic of GLStateCache, UniformRing, DynamicBufferRing, TextureUploadQueue
+ * and GLContext's name pool is re-implemented here in C++ by hand (GLDeletionQueue.h and ES3Context are the real native code).
+ * Results measure the GL call patterns those classes produce, not the cost of the Haxe code itself, and each re-implementation must be kept
+ * in step with its class by hand when the class changes
+ */
+
+#include "./context.h"
+#include "../GLDeletionQueue.h"
+
+#ifdef WEBGL_BENCHMARK_BASIS
+#include "../../../image/native/basis.h"
+#endif
+
+// ES 3.0 enums missing from the GLES2 headers
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+
+#define WIDTH 64
+#define HEIGHT 64
+#define MAX_COUNTERS 4
+#define HISTOGRAM_BUCKETS 8
+
+typedef enum {
+	COUNTER_PER_ITERATION,
+	// per cpu second
+	COUNTER_RATE,
+	// the value counts bytes and is reported as cpu microseconds per megabyte
+	COUNTER_CPU_US_PER_MB,
+} CounterKind;
+
+typedef struct {
+	const char* name;
+	double value;
+	CounterKind kind;
+} Counter;
+
+typedef struct {
+	const char* name;
+	int n;
+	const char* variant;
+	int option;
+	void* (*setup)(int n, int option);
+	void (*frame)(void* state);
+	void (*teardown)(void* state);
+	// frames in one cycle of the benchmark's scene, when non-zero whole cycles are run and frame times are reported as a histogram
+	int frameCycle;
+} Benchmark;
+
+static Counter counters[MAX_COUNTERS];
+static int counterCount = 0;
+
+// counters are registered by setup and reset for each benchmark
+static double* addCounter(const char* name, CounterKind kind) {
+	counters[counterCount].name = name;
+	counters[counterCount].value = 0;
+	counters[counterCount].kind = kind;
+	return &counters[counterCount++].value;
+}
+
+static double Counter_report(const Counter* counter, unsigned long long iterations, double cpuElapsed) {
+	switch (counter->kind) {
+		case COUNTER_RATE: return counter->value / cpuElapsed;
+		case COUNTER_CPU_US_PER_MB: return counter->value > 0 ? cpuElapsed * 1e6 / (counter->value / (1024.0 * 1024.0)) : 0;
+		default: return counter->value / (double) iterations;
+	}
+}
+
+// upper bounds of the frame time histogram's buckets in milliseconds, the last bucket has no bound
+static const double histogramBucketMs[HISTOGRAM_BUCKETS - 1] = { 1, 2, 4, 8, 16.7, 33.3, 66.7 };
+
+static const char* ktx2Path = NULL;
+
+// the context created by main(), benchmarks that create their own contexts make it current again in teardown
+static BenchContext* mainContext = NULL;
+
+/**
+ * Shared quad geometry and a textured sprite program
+ */
+
+static const char* spriteVertexSource =
+	"attribute vec2 position;\n"
+	"uniform vec4 transform;\n"
+	"varying vec2 uv;\n"
+	"void main() {\n"
+	"	uv = position;\n"
+	"	gl_Position = vec4(position * transform.zw + transform.xy, 0.0, 1.0);\n"
+	"}\n";
+
+static const char* spriteFragmentSource =
+	"precision mediump float;\n"
+	"uniform sampler2D tex;\n"
+	"uniform vec4 tint;\n"
+	"varying vec2 uv;\n"
+	"void main() {\n"
+	"	gl_FragColor = texture2D(tex, uv) * tint;\n"
+	"}\n";
+
+static GLuint createQuadBuffer() {
+	const float quad[] = { 0, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 1 };
+	GLuint buffer;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+	return buffer;
+}
+
+static GLuint createTexture(int size, unsigned char value) {
+	unsigned char* pixels = (unsigned char*) malloc(size * size * 4);
+	memset(pixels, value, size * size * 4);
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	free(pixels);
+	return texture;
+}
+
+/**
+ * BM_SpriteScene
+ * Sprites are sorted by program and texture, as a sprite batcher would, but each sprite still sets all of its state
+ */
+
+#define SPRITE_TEXTURES 4
+#define SPRITE_PROGRAMS 2
+
+// the checks GLStateCache.hx makes for these calls
+typedef struct {
+	GLuint program;
+	GLenum activeTexture;
+	GLuint texture2D;
+	GLuint arrayBuffer;
+	int blend;
+	GLenum blendSrc;
+	GLenum blendDst;
+} StateShadow;
+
+typedef struct {
+	int n;
+	bool cached;
+	StateShadow shadow;
+	GLuint quad;
+	GLuint programs[SPRITE_PROGRAMS];
+	GLint transformLocations[SPRITE_PROGRAMS];
+	GLint tintLocations[SPRITE_PROGRAMS];
+	GLuint textures[SPRITE_TEXTURES];
+	double* issued;
+	double* elided;
+} SpriteScene;
+
+static void StateShadow_invalidate(StateShadow* shadow) {
+	shadow->program = (GLuint) -1;
+	shadow->activeTexture = 0;
+	shadow->texture2D = (GLuint) -1;
+	shadow->arrayBuffer = (GLuint) -1;
+	shadow->blend = -1;
+	shadow->blendSrc = 0;
+	shadow->blendDst = 0;
+}
+
+// returns true if the call can be skipped
+static inline bool SpriteScene_skip(SpriteScene* scene, bool unchanged) {
+	if (scene->cached && unchanged) {
+		(*scene->elided)++;
+		return true;
+	}
+	(*scene->issued)++;
+	return false;
+}
+
+static void* SpriteScene_setup(int n, int cached) {
+	SpriteScene* scene = (SpriteScene*) calloc(1, sizeof(SpriteScene));
+	scene->n = n;
+	scene->cached = cached != 0;
+	scene->quad = createQuadBuffer();
+	for (int i = 0; i < SPRITE_PROGRAMS; i++) {
+		scene->programs[i] = BenchContext_compileProgram(spriteVertexSource, spriteFragmentSource);
+		scene->transformLocations[i] = glGetUniformLocation(scene->programs[i], "transform");
+		scene->tintLocations[i] = glGetUniformLocation(scene->programs[i], "tint");
+	}
+	for (int i = 0; i < SPRITE_TEXTURES; i++) {
+		scene->textures[i] = createTexture(32, (unsigned char)(60 * i));
+	}
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(0);
+	scene->issued = addCounter("issued_calls", COUNTER_PER_ITERATION);
+	scene->elided = addCounter("elided_calls", COUNTER_PER_ITERATION);
+	return scene;
+}
+
+static void SpriteScene_frame(void* state) {
+	SpriteScene* scene = (SpriteScene*) state;
+	StateShadow* shadow = &scene->shadow;
+	// postHaxeExecution() invalidates the cache after every callback, so each frame starts unknown
+	StateShadow_invalidate(shadow);
+
+	glClear(GL_COLOR_BUFFER_BIT);
+	for (int i = 0; i < scene->n; i++) {
+		int programIndex = (i * SPRITE_PROGRAMS) / scene->n;
+		GLuint program = scene->programs[programIndex];
+		GLuint texture = scene->textures[(i / 50) % SPRITE_TEXTURES];
+
+		if (!SpriteScene_skip(scene, shadow->program == program)) {
+			shadow->program = program;
+			glUseProgram(program);
+		}
+		if (!SpriteScene_skip(scene, shadow->activeTexture == GL_TEXTURE0)) {
+			shadow->activeTexture = GL_TEXTURE0;
+			glActiveTexture(GL_TEXTURE0);
+		}
+		if (!SpriteScene_skip(scene, shadow->texture2D == texture)) {
+			shadow->texture2D = texture;
+			glBindTexture(GL_TEXTURE_2D, texture);
+		}
+		if (!SpriteScene_skip(scene, shadow->arrayBuffer == scene->quad)) {
+			shadow->arrayBuffer = scene->quad;
+			glBindBuffer(GL_ARRAY_BUFFER, scene->quad);
+		}
+		if (!SpriteScene_skip(scene, shadow->blend == 1)) {
+			shadow->blend = 1;
+			glEnable(GL_BLEND);
+		}
+		if (!SpriteScene_skip(scene, shadow->blendSrc == GL_ONE && shadow->blendDst == GL_ONE_MINUS_SRC_ALPHA)) {
+			shadow->blendSrc = GL_ONE;
+			shadow->blendDst = GL_ONE_MINUS_SRC_ALPHA;
+			glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		}
+
+		float x = (float)(i % 37) / 37.0f * 2.0f - 1.0f;
+		float y = (float)(i % 23) / 23.0f * 2.0f - 1.0f;
+		glUniform4f(scene->transformLocations[programIndex], x, y, 0.05f, 0.05f);
+		glUniform4f(scene->tintLocations[programIndex], 1, 1, 1, 0.5f);
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		(*scene->issued) += 3;
+	}
+}
+
+static void SpriteScene_teardown(void* state) {
+	SpriteScene* scene = (SpriteScene*) state;
+	glDeleteBuffers(1, &scene->quad);
+	glDeleteTextures(SPRITE_TEXTURES, scene->textures);
+	for (int i = 0; i < SPRITE_PROGRAMS; i++) glDeleteProgram(scene->programs[i]);
+	free(scene);
+}
+
+/**
+ * BM_DrawCalls
+ * `n` colored quads from 8 meshes with an interleaved position and color buffer each
+ */
+
+#define DRAW_MESHES 8
+
+enum {
+	DRAW_ATTRIBUTES,
+	DRAW_VERTEX_ARRAYS,
+	DRAW_INSTANCED,
+};
+
+static const char* drawVertexSource =
+	"attribute vec2 position;\n"
+	"attribute vec4 color;\n"
+	"uniform vec2 offset;\n"
+	"varying vec4 vColor;\n"
+	"void main() {\n"
+	"	vColor = color;\n"
+	"	gl_Position = vec4(position * 0.05 + offset, 0.0, 1.0);\n"
+	"}\n";
+
+static const char* drawInstancedVertexSource =
+	"attribute vec2 position;\n"
+	"attribute vec4 color;\n"
+	"attribute vec2 offset;\n"
+	"varying vec4 vColor;\n"
+	"void main() {\n"
+	"	vColor = color;\n"
+	"	gl_Position = vec4(position * 0.05 + offset, 0.0, 1.0);\n"
+	"}\n";
+
+static const char* colorFragmentSource =
+	"precision mediump float;\n"
+	"varying vec4 vColor;\n"
+	"void main() {\n"
+	"	gl_FragColor = vColor;\n"
+	"}\n";
+
+typedef struct {
+	int n;
+	int mode;
+	GLuint program;
+	GLint offsetLocation;
+	GLuint meshes[DRAW_MESHES];
+	GLuint vertexArrays[DRAW_MESHES];
+	GLuint instanceBuffer;
+	float* instanceOffsets;
+	void* bindVertexArray;
+	void* drawArraysInstanced;
+	void* vertexAttribDivisor;
+	double* drawCalls;
+} DrawCalls;
+
+static void DrawCalls_setMeshAttributes(GLuint mesh) {
+	glBindBuffer(GL_ARRAY_BUFFER, mesh);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*) 0);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*) (2 * sizeof(float)));
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+}
+
+static void* DrawCalls_setup(int n, int mode) {
+	DrawCalls* draw = (DrawCalls*) calloc(1, sizeof(DrawCalls));
+	draw->n = n;
+	draw->mode = mode;
+	draw->program = BenchContext_compileProgram(mode == DRAW_INSTANCED ? drawInstancedVertexSource : drawVertexSource, colorFragmentSource);
+	draw->offsetLocation = glGetUniformLocation(draw->program, "offset");
+	glUseProgram(draw->program);
+
+	// GL2Context resolves the core entry points without a suffix, see OESVertexArrayObject and ANGLEInstancedArrays
+	void* genVertexArrays = BenchContext_getProc("glGenVertexArrays");
+	draw->bindVertexArray = BenchContext_getProc("glBindVertexArray");
+	draw->drawArraysInstanced = BenchContext_getProc("glDrawArraysInstanced");
+	draw->vertexAttribDivisor = BenchContext_getProc("glVertexAttribDivisor");
+
+	glGenBuffers(DRAW_MESHES, draw->meshes);
+	for (int i = 0; i < DRAW_MESHES; i++) {
+		float vertices[6 * 6];
+		const float quad[] = { 0, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 1 };
+		for (int v = 0; v < 6; v++) {
+			vertices[v * 6 + 0] = quad[v * 2];
+			vertices[v * 6 + 1] = quad[v * 2 + 1];
+			vertices[v * 6 + 2] = (float) i / DRAW_MESHES;
+			vertices[v * 6 + 3] = 0.5f;
+			vertices[v * 6 + 4] = 1.0f - (float) i / DRAW_MESHES;
+			vertices[v * 6 + 5] = 1.0f;
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, draw->meshes[i]);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	}
+
+	// instances are grouped by mesh
+	draw->instanceOffsets = (float*) malloc(sizeof(float) * 2 * n);
+	glGenBuffers(1, &draw->instanceBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, draw->instanceBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 2 * n, NULL, GL_STREAM_DRAW);
+
+	if (mode != DRAW_ATTRIBUTES) {
+		WebGL_genVertexArrays(genVertexArrays, DRAW_MESHES, draw->vertexArrays);
+		for (int i = 0; i < DRAW_MESHES; i++) {
+			WebGL_bindVertexArray(draw->bindVertexArray, draw->vertexArrays[i]);
+			DrawCalls_setMeshAttributes(draw->meshes[i]);
+			if (mode == DRAW_INSTANCED) {
+				glBindBuffer(GL_ARRAY_BUFFER, draw->instanceBuffer);
+				int first = (i * n) / DRAW_MESHES;
+				glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (void*) (first * 2 * sizeof(float)));
+				glEnableVertexAttribArray(2);
+				WebGL_vertexAttribDivisor(draw->vertexAttribDivisor, 2, 1);
+			}
+		}
+		WebGL_bindVertexArray(draw->bindVertexArray, 0);
+	}
+
+	draw->drawCalls = addCounter("draw_calls", COUNTER_PER_ITERATION);
+	return draw;
+}
+
+static void DrawCalls_frame(void* state) {
+	DrawCalls* draw = (DrawCalls*) state;
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	if (draw->mode == DRAW_INSTANCED) {
+		for (int i = 0; i < draw->n; i++) {
+			draw->instanceOffsets[i * 2] = (float)(i % 37) / 37.0f * 2.0f - 1.0f;
+			draw->instanceOffsets[i * 2 + 1] = (float)(i % 23) / 23.0f * 2.0f - 1.0f;
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, draw->instanceBuffer);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * 2 * draw->n, draw->instanceOffsets);
+		for (int mesh = 0; mesh < DRAW_MESHES; mesh++) {
+			int first = (mesh * draw->n) / DRAW_MESHES;
+			int last = ((mesh + 1) * draw->n) / DRAW_MESHES;
+			WebGL_bindVertexArray(draw->bindVertexArray, draw->vertexArrays[mesh]);
+			WebGL_drawArraysInstanced(draw->drawArraysInstanced, GL_TRIANGLES, 0, 6, last - first);
+			(*draw->drawCalls)++;
+		}
+		WebGL_bindVertexArray(draw->bindVertexArray, 0);
+		return;
+	}
+
+	for (int i = 0; i < draw->n; i++) {
+		int mesh = (i * DRAW_MESHES) / draw->n;
+		if (draw->mode == DRAW_VERTEX_ARRAYS) {
+			WebGL_bindVertexArray(draw->bindVertexArray, draw->vertexArrays[mesh]);
+		} else {
+			DrawCalls_setMeshAttributes(draw->meshes[mesh]);
+		}
+		glUniform2f(draw->offsetLocation, (float)(i % 37) / 37.0f * 2.0f - 1.0f, (float)(i % 23) / 23.0f * 2.0f - 1.0f);
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		(*draw->drawCalls)++;
+	}
+	if (draw->mode == DRAW_VERTEX_ARRAYS) {
+		WebGL_bindVertexArray(draw->bindVertexArray, 0);
+	}
+}
+
+static void DrawCalls_teardown(void* state) {
+	DrawCalls* draw = (DrawCalls*) state;
+	if (draw->mode != DRAW_ATTRIBUTES) {
+		WebGL_deleteVertexArrays(BenchContext_getProc("glDeleteVertexArrays"), DRAW_MESHES, draw->vertexArrays);
+	}
+	glDisableVertexAttribArray(1);
+	glDisableVertexAttribArray(2);
+	glDeleteBuffers(DRAW_MESHES, draw->meshes);
+	glDeleteBuffers(1, &draw->instanceBuffer);
+	glDeleteProgram(draw->program);
+	free(draw->instanceOffsets);
+	free(draw);
+}
+
+/**
+ * BM_UniformBlock
+ * `n` draws that each set a mat4 and a vec4, as separate uniforms or as a std140 block in a UniformRing
+ */
+
+#define UNIFORM_RING_FRAMES 3
+
+enum {
+	UNIFORM_CALLS,
+	UNIFORM_RING,
+};
+
+static const char* uniformVertexSource =
+	"attribute vec2 position;\n"
+	"uniform mat4 model;\n"
+	"uniform vec4 tint;\n"
+	"varying vec4 vColor;\n"
+	"void main() {\n"
+	"	vColor = tint;\n"
+	"	gl_Position = model * vec4(position * 0.02, 0.0, 1.0);\n"
+	"}\n";
+
+static const char* uniformBlockVertexSource =
+	"#version 300 es\n"
+	"in vec2 position;\n"
+	"layout(std140) uniform Object {\n"
+	"	mat4 model;\n"
+	"	vec4 tint;\n"
+	"};\n"
+	"out vec4 vColor;\n"
+	"void main() {\n"
+	"	vColor = tint;\n"
+	"	gl_Position = model * vec4(position * 0.02, 0.0, 1.0);\n"
+	"}\n";
+
+static const char* uniformBlockFragmentSource =
+	"#version 300 es\n"
+	"precision mediump float;\n"
+	"in vec4 vColor;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"	fragColor = vColor;\n"
+	"}\n";
+
+// std140 layout of the Object block: mat4 model at 0, vec4 tint at 64
+#define OBJECT_BLOCK_BYTES 80
+
+typedef struct {
+	int n;
+	int mode;
+	GLuint program;
+	GLuint quad;
+	GLint modelLocation;
+	GLint tintLocation;
+	GLuint ring;
+	int alignment;
+	int frameByteLength;
+	int frame;
+	unsigned char* staging;
+	double* uniformCalls;
+} UniformBlock;
+
+static void UniformBlock_writeObject(float* model, float* tint, int i) {
+	memset(model, 0, sizeof(float) * 16);
+	model[0] = model[5] = model[10] = model[15] = 1;
+	model[12] = (float)(i % 97) / 97.0f * 2.0f - 1.0f;
+	model[13] = (float)(i % 89) / 89.0f * 2.0f - 1.0f;
+	tint[0] = (float)(i % 7) / 7.0f;
+	tint[1] = 0.5f;
+	tint[2] = 0.5f;
+	tint[3] = 1;
+}
+
+static void* UniformBlock_setup(int n, int mode) {
+	UniformBlock* block = (UniformBlock*) calloc(1, sizeof(UniformBlock));
+	block->n = n;
+	block->mode = mode;
+	block->quad = createQuadBuffer();
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, 0);
+	glEnableVertexAttribArray(0);
+
+	if (mode == UNIFORM_CALLS) {
+		block->program = BenchContext_compileProgram(uniformVertexSource, colorFragmentSource);
+		block->modelLocation = glGetUniformLocation(block->program, "model");
+		block->tintLocation = glGetUniformLocation(block->program, "tint");
+	} else {
+		block->program = BenchContext_compileProgram(uniformBlockVertexSource, uniformBlockFragmentSource);
+		WebGL_UniformBlockBinding(block->program, WebGL_GetUniformBlockIndex(block->program, "Object"), 0);
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		block->alignment = alignment > 0 ? alignment : 256;
+		int blockStride = (OBJECT_BLOCK_BYTES + block->alignment - 1) / block->alignment * block->alignment;
+		block->frameByteLength = blockStride * n;
+		block->staging = (unsigned char*) calloc(UNIFORM_RING_FRAMES, block->frameByteLength);
+		glGenBuffers(1, &block->ring);
+		glBindBuffer(GL_UNIFORM_BUFFER, block->ring);
+		glBufferData(GL_UNIFORM_BUFFER, block->frameByteLength * UNIFORM_RING_FRAMES, NULL, GL_DYNAMIC_DRAW);
+	}
+	glUseProgram(block->program);
+	block->uniformCalls = addCounter("uniform_calls", COUNTER_PER_ITERATION);
+	return block;
+}
+
+static void UniformBlock_frame(void* state) {
+	UniformBlock* block = (UniformBlock*) state;
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	if (block->mode == UNIFORM_CALLS) {
+		float model[16];
+		float tint[4];
+		for (int i = 0; i < block->n; i++) {
+			UniformBlock_writeObject(model, tint, i);
+			glUniformMatrix4fv(block->modelLocation, 1, GL_FALSE, model);
+			glUniform4fv(block->tintLocation, 1, tint);
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+			(*block->uniformCalls) += 2;
+		}
+		return;
+	}
+
+	// UniformRing: allocate and write every block, upload() once, then bind() each block before its draw
+	int blockStride = block->frameByteLength / block->n;
+	int frameStart = block->frame * block->frameByteLength;
+	for (int i = 0; i < block->n; i++) {
+		float* object = (float*) (block->staging + frameStart + i * blockStride);
+		UniformBlock_writeObject(object, object + 16, i);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, block->ring);
+	glBufferSubData(GL_UNIFORM_BUFFER, frameStart, block->frameByteLength, block->staging + frameStart);
+	(*block->uniformCalls)++;
+	for (int i = 0; i < block->n; i++) {
+		WebGL_BindBufferRange(GL_UNIFORM_BUFFER, 0, block->ring, frameStart + i * blockStride, OBJECT_BLOCK_BYTES);
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		(*block->uniformCalls)++;
+	}
+	block->frame = (block->frame + 1) % UNIFORM_RING_FRAMES;
+}
+
+static void UniformBlock_teardown(void* state) {
+	UniformBlock* block = (UniformBlock*) state;
+	glDeleteBuffers(1, &block->quad);
+	if (block->ring != 0) glDeleteBuffers(1, &block->ring);
+	glDeleteProgram(block->program);
+	free(block->staging);
+	free(block);
+}
+
+/**
+ * BM_StreamingRing
+ * `n` draws of 64 vertices rebuilt every frame, reported per frame and as cpu time per megabyte streamed
+ */
+
+#define STREAM_VERTICES 64
+#define STREAM_VERTEX_FLOATS 6
+#define STREAM_DRAW_BYTES (STREAM_VERTICES * STREAM_VERTEX_FLOATS * (int) sizeof(float))
+#define STREAM_RING_BUFFERS 3
+#define STREAM_RING_BYTES (1024 * 1024)
+
+enum {
+	STREAM_BUFFER_DATA,
+	// upload() after each allocation
+	STREAM_RING,
+	// every allocation of the frame is written before one upload()
+	STREAM_RING_BATCHED,
+};
+
+typedef struct {
+	int n;
+	int mode;
+	GLuint program;
+	GLint offsetLocation;
+	GLuint buffers[STREAM_RING_BUFFERS];
+	float* staging;
+	int bufferIndex;
+	int cursor;
+	int uploaded;
+	int frame;
+	double* uploadBytes;
+	double* cpuPerMegabyte;
+} StreamingRing;
+
+static void* StreamingRing_setup(int n, int mode) {
+	StreamingRing* ring = (StreamingRing*) calloc(1, sizeof(StreamingRing));
+	ring->n = n;
+	ring->mode = mode;
+	ring->program = BenchContext_compileProgram(drawVertexSource, colorFragmentSource);
+	ring->offsetLocation = glGetUniformLocation(ring->program, "offset");
+	glUseProgram(ring->program);
+	ring->staging = (float*) malloc(STREAM_RING_BYTES);
+	glGenBuffers(STREAM_RING_BUFFERS, ring->buffers);
+	for (int i = 0; i < STREAM_RING_BUFFERS; i++) {
+		glBindBuffer(GL_ARRAY_BUFFER, ring->buffers[i]);
+		glBufferData(GL_ARRAY_BUFFER, mode == STREAM_BUFFER_DATA ? STREAM_DRAW_BYTES : STREAM_RING_BYTES, NULL, GL_STREAM_DRAW);
+	}
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	ring->uploadBytes = addCounter("upload_bytes", COUNTER_PER_ITERATION);
+	ring->cpuPerMegabyte = addCounter("cpu_us_per_mb", COUNTER_CPU_US_PER_MB);
+	return ring;
+}
+
+static void StreamingRing_writeVertices(float* vertices, int draw, int frame) {
+	for (int v = 0; v < STREAM_VERTICES; v++) {
+		float angle = (float) v / STREAM_VERTICES * 6.2831853f + (float) frame * 0.01f;
+		vertices[v * STREAM_VERTEX_FLOATS + 0] = (float)(v & 1) * angle * 0.1f;
+		vertices[v * STREAM_VERTEX_FLOATS + 1] = (float)(v >> 1 & 1) * angle * 0.1f;
+		vertices[v * STREAM_VERTEX_FLOATS + 2] = (float)(draw % 5) / 5.0f;
+		vertices[v * STREAM_VERTEX_FLOATS + 3] = 0.5f;
+		vertices[v * STREAM_VERTEX_FLOATS + 4] = 0.5f;
+		vertices[v * STREAM_VERTEX_FLOATS + 5] = 1.0f;
+	}
+}
+
+// DynamicBufferRing.upload(), copies the bytes written since the last upload
+static void StreamingRing_upload(StreamingRing* ring) {
+	glBindBuffer(GL_ARRAY_BUFFER, ring->buffers[ring->bufferIndex]);
+	if (ring->cursor == ring->uploaded) return;
+	glBufferSubData(GL_ARRAY_BUFFER, ring->uploaded, ring->cursor - ring->uploaded, (unsigned char*) ring->staging + ring->uploaded);
+	ring->uploaded = ring->cursor;
+}
+
+// DynamicBufferRing.allocate(), orphaning the next buffer when this one is full
+static int StreamingRing_allocate(StreamingRing* ring, int byteLength) {
+	if (ring->cursor + byteLength > STREAM_RING_BYTES) {
+		StreamingRing_upload(ring);
+		ring->bufferIndex = (ring->bufferIndex + 1) % STREAM_RING_BUFFERS;
+		ring->cursor = 0;
+		ring->uploaded = 0;
+		glBindBuffer(GL_ARRAY_BUFFER, ring->buffers[ring->bufferIndex]);
+		glBufferData(GL_ARRAY_BUFFER, STREAM_RING_BYTES, NULL, GL_STREAM_DRAW);
+	}
+	int offset = ring->cursor;
+	ring->cursor += byteLength;
+	return offset;
+}
+
+static void StreamingRing_draw(StreamingRing* ring, int i, int offset) {
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, STREAM_VERTEX_FLOATS * sizeof(float), (void*)(intptr_t) offset);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, STREAM_VERTEX_FLOATS * sizeof(float), (void*)(intptr_t) (offset + 2 * sizeof(float)));
+	glUniform2f(ring->offsetLocation, (float)(i % 37) / 37.0f * 2.0f - 1.0f, (float)(i % 23) / 23.0f * 2.0f - 1.0f);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, STREAM_VERTICES);
+	(*ring->uploadBytes) += STREAM_DRAW_BYTES;
+	(*ring->cpuPerMegabyte) += STREAM_DRAW_BYTES;
+}
+
+static void StreamingRing_frame(void* state) {
+	StreamingRing* ring = (StreamingRing*) state;
+	ring->frame++;
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	if (ring->mode == STREAM_RING_BATCHED) {
+		// a frame fits in one buffer, so no allocation moves to the next buffer between upload() and the draws
+		int first = StreamingRing_allocate(ring, STREAM_DRAW_BYTES * ring->n);
+		for (int i = 0; i < ring->n; i++) {
+			StreamingRing_writeVertices(ring->staging + (first + i * STREAM_DRAW_BYTES) / sizeof(float), i, ring->frame);
+		}
+		StreamingRing_upload(ring);
+		for (int i = 0; i < ring->n; i++) {
+			StreamingRing_draw(ring, i, first + i * STREAM_DRAW_BYTES);
+		}
+		return;
+	}
+
+	for (int i = 0; i < ring->n; i++) {
+		int offset = 0;
+		if (ring->mode == STREAM_BUFFER_DATA) {
+			StreamingRing_writeVertices(ring->staging, i, ring->frame);
+			glBindBuffer(GL_ARRAY_BUFFER, ring->buffers[0]);
+			glBufferData(GL_ARRAY_BUFFER, STREAM_DRAW_BYTES, ring->staging, GL_STREAM_DRAW);
+		} else {
+			offset = StreamingRing_allocate(ring, STREAM_DRAW_BYTES);
+			StreamingRing_writeVertices(ring->staging + offset / sizeof(float), i, ring->frame);
+			StreamingRing_upload(ring);
+		}
+		StreamingRing_draw(ring, i, offset);
+	}
+}
+
+static void StreamingRing_teardown(void* state) {
+	StreamingRing* ring = (StreamingRing*) state;
+	glDisableVertexAttribArray(1);
+	glDeleteBuffers(STREAM_RING_BUFFERS, ring->buffers);
+	glDeleteProgram(ring->program);
+	free(ring->staging);
+	free(ring);
+}
+
+/**
+ * BM_MakeCurrent
+ * `n` views each drawn by one callback into haxe per frame, with VIEW_GL_CALLS gl calls per callback
+ * Each view's host (GLSurfaceView on Android) makes the view's context current before calling into haxe
+ */
+
+#define VIEW_GL_CALLS 64
+
+enum {
+	VIEW_UNREPORTED,
+	VIEW_HOST_REPORTED,
+};
+
+typedef struct {
+	int n;
+	int mode;
+	BenchContext* views;
+	// webglKnownCurrentContextReference
+	BenchContext* knownCurrent;
+	double* makeCurrentCalls;
+} MakeCurrent;
+
+static void* MakeCurrent_setup(int n, int mode) {
+	MakeCurrent* makeCurrent = (MakeCurrent*) calloc(1, sizeof(MakeCurrent));
+	makeCurrent->n = n;
+	makeCurrent->mode = mode;
+	makeCurrent->views = (BenchContext*) calloc(n, sizeof(BenchContext));
+	for (int i = 0; i < n; i++) {
+		BenchContext_init(&makeCurrent->views[i], WIDTH, HEIGHT);
+	}
+	makeCurrent->makeCurrentCalls = addCounter("make_current", COUNTER_PER_ITERATION);
+	return makeCurrent;
+}
+
+// GLContext.setContext()
+static inline void MakeCurrent_setContext(MakeCurrent* makeCurrent, BenchContext* view) {
+	if (makeCurrent->knownCurrent != view) {
+		BenchContext_makeCurrent(view);
+		(*makeCurrent->makeCurrentCalls)++;
+		makeCurrent->knownCurrent = view;
+	}
+	WebGL_setES3Functions(view->es3Functions);
+}
+
+static void MakeCurrent_frame(void* state) {
+	MakeCurrent* makeCurrent = (MakeCurrent*) state;
+	for (int i = 0; i < makeCurrent->n; i++) {
+		BenchContext* view = &makeCurrent->views[i];
+		// the host makes its view current before the renderer callback
+		BenchContext_makeCurrent(view);
+		if (makeCurrent->mode == VIEW_HOST_REPORTED) {
+			// HaxeApp_setCurrentGraphicsContext()
+			makeCurrent->knownCurrent = view;
+		}
+		// HaxeApp_onDrawFrame()
+		for (int j = 0; j < VIEW_GL_CALLS / 2; j++) {
+			MakeCurrent_setContext(makeCurrent, view);
+			glClearColor((float) i / (float) makeCurrent->n, (float) j / (float) VIEW_GL_CALLS, 0, 1);
+			MakeCurrent_setContext(makeCurrent, view);
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
+		glFlush();
+		// GLContext.postHaxeExecution()
+		makeCurrent->knownCurrent = NULL;
+	}
+}
+
+static void MakeCurrent_teardown(void* state) {
+	MakeCurrent* makeCurrent = (MakeCurrent*) state;
+	for (int i = 0; i < makeCurrent->n; i++) {
+		BenchContext_uninit(&makeCurrent->views[i]);
+	}
+	BenchContext_makeCurrent(mainContext);
+	free(makeCurrent->views);
+	free(makeCurrent);
+}
+
+/**
+ * BM_TextureUpload
+ * `n` 1024x1024 RGBA textures uploaded at the start of every UPLOAD_CYCLE frames, each frame also clears the framebuffer
+ * The queued variant sends slices through one orphaned PIXEL_UNPACK_BUFFER the way TextureUploadQueue does on OpenGL ES 3.0
+ */
+
+#define UPLOAD_SIZE 1024
+#define UPLOAD_CYCLE 120
+// TextureUploadQueue.budgetMs and TextureUploadQueue.sliceByteLength
+#define UPLOAD_BUDGET_MS 4
+#define UPLOAD_SLICE_BYTES (256 * 1024)
+
+enum {
+	UPLOAD_ALL,
+	UPLOAD_QUEUED,
+};
+
+typedef struct {
+	int n;
+	int mode;
+	int frame;
+	unsigned char* pixels;
+	GLuint* textures;
+	GLuint unpackBuffer;
+	// index of the texture being uploaded and rows of it sent so far
+	int texture;
+	int row;
+} TextureUpload;
+
+static void* TextureUpload_setup(int n, int mode) {
+	TextureUpload* upload = (TextureUpload*) calloc(1, sizeof(TextureUpload));
+	upload->n = n;
+	upload->mode = mode;
+	upload->pixels = (unsigned char*) malloc(UPLOAD_SIZE * UPLOAD_SIZE * 4);
+	for (int i = 0; i < UPLOAD_SIZE * UPLOAD_SIZE * 4; i++) {
+		upload->pixels[i] = (unsigned char) (i * 7);
+	}
+	upload->textures = (GLuint*) malloc(n * sizeof(GLuint));
+	glGenTextures(n, upload->textures);
+	glGenBuffers(1, &upload->unpackBuffer);
+	upload->texture = n;
+	return upload;
+}
+
+// TextureUploadQueue.sendSlice(), returns true when the texture is complete
+static bool TextureUpload_sendSlice(TextureUpload* upload) {
+	const int rowByteLength = UPLOAD_SIZE * 4;
+	glBindTexture(GL_TEXTURE_2D, upload->textures[upload->texture]);
+	if (upload->row == 0) {
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, UPLOAD_SIZE, UPLOAD_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	}
+	int rows = UPLOAD_SLICE_BYTES / rowByteLength;
+	if (rows < 1) rows = 1;
+	if (rows > UPLOAD_SIZE - upload->row) rows = UPLOAD_SIZE - upload->row;
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload->unpackBuffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, UPLOAD_SLICE_BYTES, NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, rows * rowByteLength, upload->pixels + upload->row * rowByteLength);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload->row, UPLOAD_SIZE, rows, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	upload->row += rows;
+	return upload->row >= UPLOAD_SIZE;
+}
+
+static void TextureUpload_frame(void* state) {
+	TextureUpload* upload = (TextureUpload*) state;
+	if (upload->frame == 0) {
+		if (upload->mode == UPLOAD_ALL) {
+			for (int i = 0; i < upload->n; i++) {
+				glBindTexture(GL_TEXTURE_2D, upload->textures[i]);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, UPLOAD_SIZE, UPLOAD_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, upload->pixels);
+			}
+		} else {
+			// uploads still pending from the last cycle are replaced
+			upload->texture = 0;
+			upload->row = 0;
+		}
+	}
+
+	// TextureUploadQueue.process()
+	if (upload->texture < upload->n) {
+		double deadline = nowSeconds() + UPLOAD_BUDGET_MS / 1000.0;
+		do {
+			if (TextureUpload_sendSlice(upload)) {
+				upload->texture++;
+				upload->row = 0;
+			}
+		} while (upload->texture < upload->n && nowSeconds() < deadline);
+	}
+
+	glClear(GL_COLOR_BUFFER_BIT);
+	upload->frame = (upload->frame + 1) % UPLOAD_CYCLE;
+}
+
+static void TextureUpload_teardown(void* state) {
+	TextureUpload* upload = (TextureUpload*) state;
+	glDeleteBuffers(1, &upload->unpackBuffer);
+	glDeleteTextures(upload->n, upload->textures);
+	free(upload->textures);
+	free(upload->pixels);
+	free(upload);
+}
+
+/**
+ * BM_DeletionChurn
+ * `n` buffers created, bound and released in one frame
+ */
+
+// GLContext.NAME_POOL_SIZE and GLContext.DELETION_BATCH_SIZE
+#define NAME_POOL_SIZE 32
+#define DELETION_BATCH_SIZE 64
+#define DELETION_TYPE_BUFFER 0
+
+enum {
+	DELETE_IMMEDIATE,
+	DELETE_DEFERRED,
+};
+
+typedef struct {
+	int n;
+	int mode;
+	WebGL_DeletionQueue* queue;
+	GLuint namePool[NAME_POOL_SIZE];
+	int namesAvailable;
+	double* glCalls;
+} DeletionChurn;
+
+static void* DeletionChurn_setup(int n, int mode) {
+	DeletionChurn* churn = (DeletionChurn*) calloc(1, sizeof(DeletionChurn));
+	churn->n = n;
+	churn->mode = mode;
+	churn->queue = WebGL_createDeletionQueue();
+	churn->glCalls = addCounter("gl_calls", COUNTER_PER_ITERATION);
+	return churn;
+}
+
+// GLContext.deletePendingObjects(), names are deleted DELETION_BATCH_SIZE at a time
+static void DeletionChurn_deletePending(DeletionChurn* churn) {
+	GLuint batch[DELETION_BATCH_SIZE];
+	int length = 0;
+	int32_t type;
+	size_t handle;
+	void* proc;
+	while (WebGL_popDeletion(churn->queue, &type, &handle, &proc)) {
+		batch[length++] = (GLuint) handle;
+		if (length == DELETION_BATCH_SIZE) {
+			glDeleteBuffers(length, batch);
+			(*churn->glCalls)++;
+			length = 0;
+		}
+	}
+	if (length > 0) {
+		glDeleteBuffers(length, batch);
+		(*churn->glCalls)++;
+	}
+}
+
+static void DeletionChurn_frame(void* state) {
+	DeletionChurn* churn = (DeletionChurn*) state;
+	for (int i = 0; i < churn->n; i++) {
+		GLuint buffer;
+		if (churn->mode == DELETE_IMMEDIATE) {
+			glGenBuffers(1, &buffer);
+			(*churn->glCalls)++;
+		} else {
+			// GLContext.createBuffer()
+			if (churn->namesAvailable == 0) {
+				glGenBuffers(NAME_POOL_SIZE, churn->namePool);
+				churn->namesAvailable = NAME_POOL_SIZE;
+				(*churn->glCalls)++;
+			}
+			buffer = churn->namePool[--churn->namesAvailable];
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		(*churn->glCalls)++;
+
+		if (churn->mode == DELETE_IMMEDIATE) {
+			glDeleteBuffers(1, &buffer);
+			(*churn->glCalls)++;
+		} else {
+			// GLBuffer.finalize()
+			WebGL_pushDeletion(churn->queue, DELETION_TYPE_BUFFER, buffer, NULL);
+		}
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if (churn->mode == DELETE_DEFERRED) {
+		// HaxeApp_onDrawFrame() at the start of the next frame
+		DeletionChurn_deletePending(churn);
+	}
+}
+
+static void DeletionChurn_teardown(void* state) {
+	DeletionChurn* churn = (DeletionChurn*) state;
+	if (churn->namesAvailable > 0) glDeleteBuffers(churn->namesAvailable, churn->namePool);
+	// queues are never freed, see GLDeletionQueue.h
+	free(churn);
+}
+
+/**
+ * BM_Transcode
+ * Level 0 of the KTX2 file given with --ktx2, `option` is a basist::transcoder_texture_format as in CompressedTexture.TranscodeTarget
+ */
+
+#ifdef WEBGL_BENCHMARK_BASIS
+
+typedef struct {
+	unsigned char* file;
+	BasisKtx2* ktx2;
+	int format;
+	unsigned char* output;
+	int outputByteLength;
+	int pixelCount;
+	double* pixels;
+} Transcode;
+
+static void* Transcode_setup(int n, int format) {
+	Transcode* transcode = (Transcode*) calloc(1, sizeof(Transcode));
+	transcode->format = format;
+	FILE* file = fopen(ktx2Path, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "Failed to open %s\n", ktx2Path);
+		exit(1);
+	}
+	fseek(file, 0, SEEK_END);
+	long byteLength = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	transcode->file = (unsigned char*) malloc(byteLength);
+	if (fread(transcode->file, 1, byteLength, file) != (size_t) byteLength) byteLength = 0;
+	fclose(file);
+
+	transcode->ktx2 = BasisKtx2_open(transcode->file, (int) byteLength);
+	if (transcode->ktx2 == NULL) {
+		fprintf(stderr, "%s is not a Basis Universal KTX2 file\n", ktx2Path);
+		exit(1);
+	}
+	int width, height;
+	transcode->outputByteLength = BasisKtx2_levelByteLength(transcode->ktx2, 0, format, &width, &height);
+	transcode->output = (unsigned char*) malloc(transcode->outputByteLength);
+	transcode->pixelCount = width * height;
+	transcode->pixels = addCounter("pixels_per_second", COUNTER_RATE);
+	return transcode;
+}
+
+static void Transcode_frame(void* state) {
+	Transcode* transcode = (Transcode*) state;
+	BasisKtx2_transcodeLevel(transcode->ktx2, 0, 0, transcode->format, transcode->output, transcode->outputByteLength);
+	(*transcode->pixels) += transcode->pixelCount;
+}
+
+static void Transcode_teardown(void* state) {
+	Transcode* transcode = (Transcode*) state;
+	BasisKtx2_close(transcode->ktx2);
+	free(transcode->output);
+	free(transcode->file);
+	free(transcode);
+}
+
+#endif
+
+static int compareDoubles(const void* a, const void* b) {
+	double difference = *(const double*) a - *(const double*) b;
+	return difference < 0 ? -1 : (difference > 0 ? 1 : 0);
+}
+
+/**
+ * Prints the distribution of `frameCount` frame times, `frameMs` is sorted in place
+ */
+static void printFrameHistogram(double* frameMs, unsigned long long frameCount, bool json) {
+	unsigned long long counts[HISTOGRAM_BUCKETS] = { 0 };
+	for (unsigned long long i = 0; i < frameCount; i++) {
+		int bucket = 0;
+		while (bucket < HISTOGRAM_BUCKETS - 1 && frameMs[i] >= histogramBucketMs[bucket]) bucket++;
+		counts[bucket]++;
+	}
+	qsort(frameMs, frameCount, sizeof(double), compareDoubles);
+	double p99 = frameMs[(frameCount * 99) / 100 < frameCount ? (frameCount * 99) / 100 : frameCount - 1];
+	double max = frameMs[frameCount - 1];
+
+	if (json) {
+		printf(", \"frame_histogram\": {\"bucket_ms\": [");
+		for (int i = 0; i < HISTOGRAM_BUCKETS - 1; i++) printf("%s%.1f", i == 0 ? "" : ", ", histogramBucketMs[i]);
+		printf("], \"counts\": [");
+		for (int i = 0; i < HISTOGRAM_BUCKETS; i++) printf("%s%llu", i == 0 ? "" : ", ", counts[i]);
+		printf("]}, \"p99_frame_ms\": %.2f, \"max_frame_ms\": %.2f", p99, max);
+	} else {
+		printf("  frame ms:");
+		for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+			if (i < HISTOGRAM_BUCKETS - 1) {
+				printf(" <%g:%llu", histogramBucketMs[i], counts[i]);
+			} else {
+				printf(" >=%g:%llu", histogramBucketMs[i - 1], counts[i]);
+			}
+		}
+		printf(" p99=%.2f max=%.2f\n", p99, max);
+	}
+}
+
+static void runBenchmark(const Benchmark* benchmark, double minTime, bool json, bool last) {
+	counterCount = 0;
+	void* state = benchmark->setup(benchmark->n, benchmark->option);
+
+	// warm up shader compilation and driver allocations, cycles are warmed up whole so timing starts at the first frame of a cycle
+	int warmUpFrames = benchmark->frameCycle > 0 ? benchmark->frameCycle : 1;
+	for (int i = 0; i < warmUpFrames; i++) {
+		benchmark->frame(state);
+		glFinish();
+	}
+	for (int i = 0; i < counterCount; i++) counters[i].value = 0;
+
+	double* frameMs = NULL;
+	unsigned long long frameMsCapacity = 0;
+
+	unsigned long long iterations = 0;
+	double wallStart = nowSeconds();
+	double cpuStart = cpuSeconds();
+	double frameStart = wallStart;
+	double wallElapsed;
+	do {
+		benchmark->frame(state);
+		glFinish();
+		if (benchmark->frameCycle > 0) {
+			double frameEnd = nowSeconds();
+			if (iterations == frameMsCapacity) {
+				frameMsCapacity = frameMsCapacity == 0 ? 1024 : frameMsCapacity * 2;
+				frameMs = (double*) realloc(frameMs, frameMsCapacity * sizeof(double));
+			}
+			frameMs[iterations] = (frameEnd - frameStart) * 1e3;
+			frameStart = frameEnd;
+		}
+		iterations++;
+		wallElapsed = nowSeconds() - wallStart;
+	} while (wallElapsed < minTime || (benchmark->frameCycle > 0 && iterations % benchmark->frameCycle != 0));
+	double cpuElapsed = cpuSeconds() - cpuStart;
+
+	benchmark->teardown(state);
+
+	double wallNs = wallElapsed * 1e9 / (double) iterations;
+	double cpuNs = cpuElapsed * 1e9 / (double) iterations;
+
+	char name[96];
+	snprintf(name, sizeof(name), "%s/%d/%s", benchmark->name, benchmark->n, benchmark->variant);
+	if (json) {
+		printf("    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.0f, \"cpu_time\": %.0f, \"time_unit\": \"ns\"", name, iterations, wallNs, cpuNs);
+		for (int i = 0; i < counterCount; i++) {
+			printf(", \"%s\": %.1f", counters[i].name, Counter_report(&counters[i], iterations, cpuElapsed));
+		}
+		if (frameMs != NULL) printFrameHistogram(frameMs, iterations, json);
+		printf("}%s\n", last ? "" : ",");
+	} else {
+		printf("%-44s %12.0f ns %12.0f ns %10llu", name, wallNs, cpuNs, iterations);
+		for (int i = 0; i < counterCount; i++) {
+			double value = Counter_report(&counters[i], iterations, cpuElapsed);
+			if (counters[i].kind == COUNTER_RATE) {
+				printf(" %s=%.4gM", counters[i].name, value * 1e-6);
+			} else {
+				printf(" %s=%.0f", counters[i].name, value);
+			}
+		}
+		printf("\n");
+		if (frameMs != NULL) printFrameHistogram(frameMs, iterations, json);
+	}
+	free(frameMs);
+	fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+	bool json = false;
+	double minTime = 0.5;
+	const char* filter = NULL;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) json = true;
+		if (strncmp(argv[i], "--min-time=", 11) == 0) minTime = atof(argv[i] + 11);
+		if (strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+		if (strncmp(argv[i], "--ktx2=", 7) == 0) ktx2Path = argv[i] + 7;
+	}
+
+	const Benchmark benchmarks[] = {
+		{ "BM_SpriteScene", 2000, "direct", 0, SpriteScene_setup, SpriteScene_frame, SpriteScene_teardown },
+		{ "BM_SpriteScene", 2000, "state_cache", 1, SpriteScene_setup, SpriteScene_frame, SpriteScene_teardown },
+		{ "BM_DrawCalls", 1000, "attributes", DRAW_ATTRIBUTES, DrawCalls_setup, DrawCalls_frame, DrawCalls_teardown },
+		{ "BM_DrawCalls", 1000, "vertex_arrays", DRAW_VERTEX_ARRAYS, DrawCalls_setup, DrawCalls_frame, DrawCalls_teardown },
+		{ "BM_DrawCalls", 1000, "instanced", DRAW_INSTANCED, DrawCalls_setup, DrawCalls_frame, DrawCalls_teardown },
+		{ "BM_UniformBlock", 10000, "uniforms", UNIFORM_CALLS, UniformBlock_setup, UniformBlock_frame, UniformBlock_teardown },
+		{ "BM_UniformBlock", 10000, "uniform_ring", UNIFORM_RING, UniformBlock_setup, UniformBlock_frame, UniformBlock_teardown },
+		{ "BM_StreamingRing", 500, "buffer_data", STREAM_BUFFER_DATA, StreamingRing_setup, StreamingRing_frame, StreamingRing_teardown },
+		{ "BM_StreamingRing", 500, "ring", STREAM_RING, StreamingRing_setup, StreamingRing_frame, StreamingRing_teardown },
+		{ "BM_StreamingRing", 500, "ring_batched", STREAM_RING_BATCHED, StreamingRing_setup, StreamingRing_frame, StreamingRing_teardown },
+		{ "BM_MakeCurrent", 2, "unreported", VIEW_UNREPORTED, MakeCurrent_setup, MakeCurrent_frame, MakeCurrent_teardown },
+		{ "BM_MakeCurrent", 2, "host_reported", VIEW_HOST_REPORTED, MakeCurrent_setup, MakeCurrent_frame, MakeCurrent_teardown },
+		{ "BM_TextureUpload", 8, "all_at_once", UPLOAD_ALL, TextureUpload_setup, TextureUpload_frame, TextureUpload_teardown, UPLOAD_CYCLE },
+		{ "BM_TextureUpload", 8, "upload_queue", UPLOAD_QUEUED, TextureUpload_setup, TextureUpload_frame, TextureUpload_teardown, UPLOAD_CYCLE },
+		{ "BM_DeletionChurn", 100000, "immediate", DELETE_IMMEDIATE, DeletionChurn_setup, DeletionChurn_frame, DeletionChurn_teardown },
+		{ "BM_DeletionChurn", 100000, "deferred", DELETE_DEFERRED, DeletionChurn_setup, DeletionChurn_frame, DeletionChurn_teardown },
+		#ifdef WEBGL_BENCHMARK_BASIS
+		{ "BM_Transcode", 1, "rgba32", 13, Transcode_setup, Transcode_frame, Transcode_teardown },
+		{ "BM_Transcode", 1, "etc1_rgb", 0, Transcode_setup, Transcode_frame, Transcode_teardown },
+		{ "BM_Transcode", 1, "bc1_rgb", 2, Transcode_setup, Transcode_frame, Transcode_teardown },
+		{ "BM_Transcode", 1, "bc7_rgba", 6, Transcode_setup, Transcode_frame, Transcode_teardown },
+		{ "BM_Transcode", 1, "astc_4x4_rgba", 10, Transcode_setup, Transcode_frame, Transcode_teardown },
+		#endif
+	};
+
+	// select benchmarks first so the last JSON entry has no trailing comma
+	const Benchmark* selected[bench_countof(benchmarks)];
+	size_t selectedCount = 0;
+	for (size_t i = 0; i < bench_countof(benchmarks); i++) {
+		if (filter != NULL && strstr(benchmarks[i].name, filter) == NULL) continue;
+		if (strcmp(benchmarks[i].name, "BM_Transcode") == 0 && ktx2Path == NULL) {
+			if (i == 0 || strcmp(benchmarks[i - 1].name, "BM_Transcode") != 0) fprintf(stderr, "BM_Transcode skipped, pass --ktx2=<file> to run it\n");
+			continue;
+		}
+		selected[selectedCount++] = &benchmarks[i];
+	}
+
+	BenchContext context;
+	BenchContext_init(&context, WIDTH, HEIGHT);
+	mainContext = &context;
+
+	if (json) {
+		printf("{\n  \"context\": {\"renderer\": \"%s\", \"version\": \"%s\", \"width\": %d, \"height\": %d},\n  \"benchmarks\": [\n", glGetString(GL_RENDERER), glGetString(GL_VERSION), WIDTH, HEIGHT);
+	} else {
+		printf("%s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+		printf("%-44s %15s %15s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+		printf("----------------------------------------------------------------------------------------------------\n");
+	}
+
+	for (size_t i = 0; i < selectedCount; i++) {
+		runBenchmark(selected[i], minTime, json, i == selectedCount - 1);
+	}
+
+	if (json) {
+		printf("  ]\n}\n");
+	}
+
+	BenchContext_uninit(&context);
+	return 0;
+}
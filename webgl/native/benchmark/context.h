@@ -0,0 +1,170 @@
+/**
+ * Offscreen OpenGL ES 3.0 contexts shared by the benchmarks
+ *
+ * Contexts are created with EGL on a small pbuffer (surfaceless Mesa when there's no display), so the benchmarks run headless.
+ * GL calls go through the same native layer GLContext.hx uses: ES2 entry points directly, ES3 entry points through ES3Context.h
+ * and extension entry points through GLExtensionFunctions.h
+ */
+
+#ifndef WEBGL_NATIVE_BENCHMARK_CONTEXT_H
+#define WEBGL_NATIVE_BENCHMARK_CONTEXT_H
+
+#include <time.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "../ES3Context.h"
+#include "../GLExtensionFunctions.h"
+
+#define bench_countof(x) (sizeof(x) / sizeof(x[0]))
+
+typedef struct {
+	EGLDisplay display;
+	EGLSurface surface;
+	EGLContext context;
+	const WebGL_ES3Functions* es3Functions;
+	int width;
+	int height;
+} BenchContext;
+
+static EGLDisplay BenchContext_getDisplay() {
+	static EGLDisplay display = EGL_NO_DISPLAY;
+	if (display != EGL_NO_DISPLAY) return display;
+
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+	#ifdef EGL_PLATFORM_SURFACELESS_MESA
+	if (getPlatformDisplay != NULL) {
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	#endif
+	if (display == EGL_NO_DISPLAY) {
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	EGLint major, minor;
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+		fprintf(stderr, "Failed to initialize EGL (0x%x)\n", eglGetError());
+		exit(1);
+	}
+	return display;
+}
+
+/**
+ * Creates an ES 3.0 context with its own pbuffer and makes it current
+ */
+static void BenchContext_init(BenchContext* context, int width, int height) {
+	context->display = BenchContext_getDisplay();
+	context->width = width;
+	context->height = height;
+
+	eglBindAPI(EGL_OPENGL_ES_API);
+	const EGLint configAttributes[] = {
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+		EGL_NONE
+	};
+	EGLConfig config;
+	EGLint configCount = 0;
+	if (!eglChooseConfig(context->display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+		fprintf(stderr, "No EGL config with an RGBA8 pbuffer\n");
+		exit(1);
+	}
+
+	const EGLint contextAttributes[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+	context->context = eglCreateContext(context->display, config, EGL_NO_CONTEXT, contextAttributes);
+	const EGLint surfaceAttributes[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+	context->surface = eglCreatePbufferSurface(context->display, config, surfaceAttributes);
+	if (context->context == EGL_NO_CONTEXT || context->surface == EGL_NO_SURFACE) {
+		fprintf(stderr, "Failed to create an OpenGL ES 3.0 context (0x%x)\n", eglGetError());
+		exit(1);
+	}
+
+	eglMakeCurrent(context->display, context->surface, context->surface, context->context);
+	context->es3Functions = WebGL_loadES3Functions();
+	if (context->es3Functions == NULL) {
+		fprintf(stderr, "The context doesn't support OpenGL ES 3.0: %s\n", glGetString(GL_VERSION));
+		exit(1);
+	}
+	WebGL_setES3Functions(context->es3Functions);
+	glViewport(0, 0, width, height);
+}
+
+static void BenchContext_uninit(BenchContext* context) {
+	eglMakeCurrent(context->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	eglDestroySurface(context->display, context->surface);
+	eglDestroyContext(context->display, context->context);
+}
+
+/**
+ * Makes the context current on the calling thread and switches the thread's ES3 entry points to it, like GLContext.setContext()
+ */
+static void BenchContext_makeCurrent(BenchContext* context) {
+	eglMakeCurrent(context->display, context->surface, context->surface, context->context);
+	WebGL_setES3Functions(context->es3Functions);
+}
+
+static void* BenchContext_getProc(const char* name) {
+	void* proc = WebGL_getProcAddress(name);
+	if (proc == NULL) proc = (void*) eglGetProcAddress(name);
+	if (proc == NULL) {
+		fprintf(stderr, "Missing GL entry point %s\n", name);
+		exit(1);
+	}
+	return proc;
+}
+
+/**
+ * Attributes `position`, `color` and `offset` are bound to locations 0, 1 and 2
+ */
+static GLuint BenchContext_compileProgram(const char* vertexSource, const char* fragmentSource) {
+	const char* sources[2] = { vertexSource, fragmentSource };
+	const GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+	GLuint program = glCreateProgram();
+	for (int i = 0; i < 2; i++) {
+		GLuint shader = glCreateShader(types[i]);
+		glShaderSource(shader, 1, &sources[i], NULL);
+		glCompileShader(shader);
+		GLint compiled = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+		if (!compiled) {
+			char log[1024];
+			glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+			fprintf(stderr, "Shader compile failed: %s\n", log);
+			exit(1);
+		}
+		glAttachShader(program, shader);
+		glDeleteShader(shader);
+	}
+	glBindAttribLocation(program, 0, "position");
+	glBindAttribLocation(program, 1, "color");
+	glBindAttribLocation(program, 2, "offset");
+	glLinkProgram(program);
+	GLint linked = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	if (!linked) {
+		char log[1024];
+		glGetProgramInfoLog(program, sizeof(log), NULL, log);
+		fprintf(stderr, "Program link failed: %s\n", log);
+		exit(1);
+	}
+	return program;
+}
+
+static double nowSeconds() {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static double cpuSeconds() {
+	struct timespec t;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+	return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+#endif